@@ -0,0 +1,36 @@
+#include "array_iterable.h"
+#include "examples.h"
+#include "func_iter.h"
+#include "iterutils/iterable_utils.h"
+
+static int incr(int x) { return x + 1; }
+
+/*
+Build an iterable of the first `n` elements of `arr`, incremented, and return it
+
+The state of each iterable is stored in `arena`, so the returned iterable stays valid after this function returns -
+as long as the arena does
+*/
+static Iterable(int) first_n_incremented(IterArena* arena, int const* arr, size_t sz, size_t n)
+{
+    Iterable(int) arrit  = arena_arr_into_iter(arena, arr, sz, int);
+    Iterable(int) takeit = arena_take_from(arena, arrit, n, int);
+    return arena_map_over(arena, takeit, incr, int, int);
+}
+
+void test_arena(void)
+{
+    int arr[] = {10, 20, 30, 40, 50};
+    /* Enough space for the state of a few iterables */
+    IterArena arena = new_arena(256);
+
+    Iterable(int) it = first_n_incremented(&arena, arr, sizeof(arr) / sizeof(*arr), 3);
+    /* Print the iterable */
+    foreach (int, x, it) {
+        printf("%d ", x);
+    }
+    puts("");
+
+    /* Release the state of all the iterables at once */
+    free_arena(&arena);
+}
@@ -3,23 +3,115 @@
 #include "func_iter.h"
 
 #include <stdlib.h>
+#include <string.h>
 
-/* `next` function impl for int arrays */
-static Maybe(int) intarrnxt(ArrIter(int) * self)
+/* `next_batch` function impl for int arrays - the remaining elements are already contiguous, copy them in one go */
+static size_t intarrbatch(ArrIter(int) * self, int* out, size_t cap)
 {
-    int const* const arr = self->arr;
-    return self->i < self->size ? Just(arr[self->i++], int) : Nothing(int);
+    size_t const left = self->size - self->i;
+    size_t const n    = cap < left ? cap : left;
+    memcpy(out, self->arr + self->i, n * sizeof(*out));
+    self->i += n;
+    return n;
 }
 
-/* `next` function impl for char* arrays */
-static Maybe(string) strarrnxt(ArrIter(string) * self)
+/* `next_batch` function impl for char* arrays */
+static size_t strarrbatch(ArrIter(string) * self, string* out, size_t cap)
 {
-    string const* const arr = self->arr;
-    return self->i < self->size ? Just(arr[self->i++], string) : Nothing(string);
+    size_t const left = self->size - self->i;
+    size_t const n    = cap < left ? cap : left;
+    memcpy(out, self->arr + self->i, n * sizeof(*out));
+    self->i += n;
+    return n;
+}
+
+/* `size_hint` function impl for int arrays - the number of elements left is always known exactly */
+static SizeHint intarrhint(ArrIter(int) * self) { return size_hint_exact(self->size - self->i); }
+
+/* `size_hint` function impl for char* arrays */
+static SizeHint strarrhint(ArrIter(string) * self) { return size_hint_exact(self->size - self->i); }
+
+/* `as_span` function impl for int arrays - hand out the remaining elements in place, without copying */
+static bool intarrspan(ArrIter(int) * self, size_t max, Span(int) * out)
+{
+    size_t const left = self->size - self->i;
+    out->ptr          = self->arr + self->i;
+    out->len          = max < left ? max : left;
+    self->i += out->len;
+    return true;
+}
+
+/* `as_span` function impl for char* arrays */
+static bool strarrspan(ArrIter(string) * self, size_t max, Span(string) * out)
+{
+    size_t const left = self->size - self->i;
+    out->ptr          = self->arr + self->i;
+    out->len          = max < left ? max : left;
+    self->i += out->len;
+    return true;
+}
+
+/* `advance_by` function impl for int arrays - skipping elements is just moving the index past them */
+static size_t intarradvance(ArrIter(int) * self, size_t n)
+{
+    size_t const left = self->size - self->i;
+    size_t const skip = n < left ? n : left;
+    self->i += skip;
+    return skip;
+}
+
+/* `advance_by` function impl for char* arrays */
+static size_t strarradvance(ArrIter(string) * self, size_t n)
+{
+    size_t const left = self->size - self->i;
+    size_t const skip = n < left ? n : left;
+    self->i += skip;
+    return skip;
+}
+
+/* `split` function impl for int arrays - the front half is just another `ArrIter` over the same array */
+static ArrIter(int) * intarrsplit(ArrIter(int) * self, Allocator alloc)
+{
+    size_t const left = self->size - self->i;
+    if (left < 2) {
+        return NULL;
+    }
+    size_t const mid          = self->i + left / 2;
+    ArrIter(int)* const front = alloc_new(alloc, ArrIter(int), .i = self->i, .size = mid, .arr = self->arr);
+    self->i                   = mid;
+    return front;
+}
+
+/* `split` function impl for char* arrays */
+static ArrIter(string) * strarrsplit(ArrIter(string) * self, Allocator alloc)
+{
+    size_t const left = self->size - self->i;
+    if (left < 2) {
+        return NULL;
+    }
+    size_t const mid             = self->i + left / 2;
+    ArrIter(string)* const front = alloc_new(alloc, ArrIter(string), .i = self->i, .size = mid, .arr = self->arr);
+    self->i                      = mid;
+    return front;
 }
 
 // clang-format off
+impl_next_batch(ArrIter(int)*, int, intarrbatch)
+impl_next_batch(ArrIter(string)*, string, strarrbatch)
+impl_size_hint(ArrIter(int)*, intarrhint)
+impl_size_hint(ArrIter(string)*, strarrhint)
+impl_as_span(ArrIter(int)*, int, intarrspan)
+impl_as_span(ArrIter(string)*, string, strarrspan)
+impl_advance_by(ArrIter(int)*, intarradvance)
+impl_advance_by(ArrIter(string)*, strarradvance)
+impl_split(ArrIter(int)*, intarrsplit)
+impl_split(ArrIter(string)*, strarrsplit)
+
 /* Implement `Iterator` for ArrIter(int)*, which in turn is for int arrays */
-impl_iterator(ArrIter(int)*, int, prep_arriter_of(int), intarrnxt)
+impl_iterator_with(ArrIter(int)*, int, prep_arriter_of(int), intarrnxt,
+    iter_slot(next_batch, intarrbatch), iter_slot(size_hint, intarrhint), iter_slot(as_span, intarrspan),
+    iter_slot(advance_by, intarradvance), iter_slot(split, intarrsplit))
 /* Implement `Iterator` for ArrIter(string)*, which in turn is for char* arrays */
-impl_iterator(ArrIter(string)*, string, prep_arriter_of(string), strarrnxt)
+impl_iterator_with(ArrIter(string)*, string, prep_arriter_of(string), strarrnxt,
+    iter_slot(next_batch, strarrbatch), iter_slot(size_hint, strarrhint), iter_slot(as_span, strarrspan),
+    iter_slot(advance_by, strarradvance), iter_slot(split, strarrsplit))
@@ -2,6 +2,7 @@
 #define IT_ARR_ITRBLE_H
 
 #include "func_iter.h"
+#include "iterutils/arena.h"
 
 #include <stdlib.h>
 
@@ -24,11 +25,39 @@ turn it into an `Iterable`
 */
 #define arr_into_iter(srcarr, sz, T) prep_arriter_of(T)(&(ArrIter(T)){.i = 0, .size = sz, .arr = srcarr})
 
+/* Same as `arr_into_iter`, but the `ArrIter` is stored in given `IterArena*` - so the iterable can outlive the scope */
+#define arena_arr_into_iter(arena, srcarr, sz, T)                                                                      \
+    prep_arriter_of(T)(arena_new(arena, ArrIter(T), .i = 0, .size = sz, .arr = srcarr))
+
 /* Define `ArrIter` struct for int arrays */
 DefineArrIterOf(int);
 /* Define `ArrIter` struct for char* arrays */
 DefineArrIterOf(string);
 
+/*
+`next` function impl for int arrays
+
+Defined here, rather than in the source file, so that `foreach_static` can call it directly
+*/
+static inline Maybe(int) intarrnxt(ArrIter(int) * self)
+{
+    int const* const arr = self->arr;
+    return self->i < self->size ? Just(arr[self->i++], int) : Nothing(int);
+}
+
+/* `next` function impl for char* arrays */
+static inline Maybe(string) strarrnxt(ArrIter(string) * self)
+{
+    string const* const arr = self->arr;
+    return self->i < self->size ? Just(arr[self->i++], string) : Nothing(string);
+}
+
+// clang-format off
+/* Define the statically dispatched `next` functions, `static_next(ArrIter(int))` and `static_next(ArrIter(string))` */
+impl_static_next(ArrIter(int), int, intarrnxt)
+impl_static_next(ArrIter(string), string, strarrnxt)
+// clang-format on
+
 /* Convert a pointer to an `ArrIter(int)` to an `Iterable(int)` */
 Iterable(int) prep_arriter_of(int)(ArrIter(int) * x);
 /* Convert a pointer to an `ArrIter(string)` to an `Iterable(string)` */
@@ -0,0 +1,73 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L /* For clock_gettime */
+#endif
+
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Each measurement processes at least this many elements in total */
+#define BENCH_MIN_TOTAL (1u << 24)
+
+size_t const bench_sizes[] = {1u << 10, 1u << 14, 1u << 18, 1u << 22, 1u << 24};
+size_t const bench_nsizes  = sizeof(bench_sizes) / sizeof(*bench_sizes);
+size_t bench_max_elements  = 1u << 24;
+
+#ifdef _WIN32
+#include <windows.h>
+
+double bench_now_ns(void)
+{
+    LARGE_INTEGER freq, now;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (double)now.QuadPart * 1e9 / (double)freq.QuadPart;
+}
+#else
+#include <time.h>
+
+double bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+#endif
+
+size_t bench_repeats(size_t elements) { return elements >= BENCH_MIN_TOTAL ? 1 : BENCH_MIN_TOTAL / elements; }
+
+int* bench_intarr(size_t n)
+{
+    int* const arr = malloc(n * sizeof(*arr));
+    if (arr == NULL) {
+        fprintf(stderr, "OOM in bench_intarr");
+        exit(1);
+    }
+    for (size_t i = 0; i < n; i++) {
+        arr[i] = (int)(i & 0xFF);
+    }
+    return arr;
+}
+
+void bench_report(char const* group, char const* name, size_t depth, size_t elements, double ns)
+{
+    double const ns_per_elmnt = ns / (double)elements;
+    printf("%s,%s,%zu,%zu,%.4f,%.0f\n", group, name, depth, elements, ns_per_elmnt, 1e9 / ns_per_elmnt);
+    fflush(stdout);
+}
+
+/* Results are written here so the work being measured can't be optimized away */
+static volatile int sink;
+
+void bench_run(char const* group, char const* name, size_t depth, BenchFn fn, void const* ctx, size_t n)
+{
+    size_t const repeats = bench_repeats(n);
+    /* Warm up caches (and page in freshly allocated memory) before measuring */
+    sink               = fn(ctx, n);
+    double const start = bench_now_ns();
+    for (size_t r = 0; r < repeats; r++) {
+        sink = fn(ctx, n);
+    }
+    bench_report(group, name, depth, n, (bench_now_ns() - start) / (double)repeats);
+}
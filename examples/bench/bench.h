@@ -0,0 +1,130 @@
+#ifndef IT_BENCH_H
+#define IT_BENCH_H
+
+#include <stddef.h>
+
+/* Element counts every benchmark is run with - from fitting in L1 to well beyond the LLC */
+extern size_t const bench_sizes[];
+/* Number of entries in `bench_sizes` */
+extern size_t const bench_nsizes;
+/* Sizes above this are skipped, can be lowered from the command line for a quick run */
+extern size_t bench_max_elements;
+
+/* A function to measure - consumes `n` elements from whatever `ctx` describes and returns some result of it */
+typedef int (*BenchFn)(void const* ctx, size_t n);
+
+/* Monotonic timestamp, in nanoseconds */
+double bench_now_ns(void);
+
+/* Number of times to repeat a measurement over `elements` elements, so each one runs for a reasonable amount of time */
+size_t bench_repeats(size_t elements);
+
+/* Allocate an int array of `n` elements filled with small values, exits on OOM */
+int* bench_intarr(size_t n);
+
+/*
+Print a result row (CSV) for `elements` elements processed in `ns` nanoseconds
+
+`depth` is the length of the adapter chain that was measured, or 0 if not applicable
+*/
+void bench_report(char const* group, char const* name, size_t depth, size_t elements, double ns);
+
+/* Call `fn` repeatedly with given `ctx` and `n`, and report the average time per call through `bench_report` */
+void bench_run(char const* group, char const* name, size_t depth, BenchFn fn, void const* ctx, size_t n);
+
+/*
+Time the `ArrIter`, `ListIter`, `IntChunkListIter`, `Range(int)` and fibonacci sources through `foreach`,
+`foreach_static`, `foreach_batch` and raw - and ranges against summing an array of the same indices
+*/
+void bench_sources(void);
+
+/* Time chains of 1 to 8 `take_from` and `map_over` adapters over an array, against the equivalent raw loop */
+void bench_adapters(void);
+
+/* Compare a chain of `take_from`/`map_over` adapters against the equivalent fused pipeline and a raw loop */
+void bench_pipeline(void);
+
+/* Time the sum, min, max, count and dot product kernels of every instruction set the CPU supports, and the sinks */
+void bench_reduce(void);
+
+/* Time building (and tearing down) an `IntList` from an array, with `malloc`ed nodes and with an `IntNodePool` */
+void bench_lists(void);
+
+/* Time `par_sum_intit` over an array, and a map over an array, with 1 to 8 threads */
+void bench_parallel(void);
+
+/*
+Compare consuming `int`, `char*` and 64 byte elements through `next` (a `Maybe` returned by value) and `next_into`,
+and a niche `Maybe(string)` against a tagged one
+*/
+void bench_maybe(void);
+
+/*
+Time iterating through the lines of a file - mapped with `map_file`, read with `fgets`, read whole up front and read
+through an `FdBuffer` of several sizes
+*/
+void bench_files(void);
+
+/*
+Time summing a map over an array read ahead on another thread, with rings of several capacities, against consuming it
+on a single thread - with next to no work per element on both sides, and with some
+*/
+void bench_readahead(void);
+
+/*
+Time summing a map over an array with `par_map_over` on 1 to 8 threads, against `map_over` - with a light and a heavy
+function
+*/
+void bench_par_map(void);
+
+/*
+Time filtering an array of random values with `filter_over`, one element at a time and in batches, against a raw loop
+and the compaction kernels of every instruction set the CPU supports - with predicates that hold for 1% to 99% of them
+*/
+void bench_filter(void);
+
+/*
+Time consuming a map over an array twice - by mapping over the array twice, through two `tee` cursors in lockstep and
+one after the other, and through a `cache` and its replay - with a light and a heavy function
+*/
+void bench_tee(void);
+
+/*
+Time a map over an array with and without both stages wrapped in `instrument` - one element at a time and in batches.
+The instrumented runs only record anything when built with `ITER_INSTRUMENT` defined - and then a slow map followed by
+a cheap one is summed in batches, and how the cheap stage's time is split between upstream and itself goes to stderr
+*/
+void bench_instrument(void);
+
+/*
+Time mapping an int array into strings - `malloc`ed and formatted by `snprintf`, against strings allocated from an
+arena (released after every batch) with `snprintf` and with `fmt_int`
+*/
+void bench_strmap(void);
+
+/*
+Time skipping the elements of an array (by calling `next`, and with `skip_from`), of a map and a filter over it, and
+of the fibonacci sequence (by calling `next`, and by matrix doubling)
+*/
+void bench_skip(void);
+
+/*
+Time materializing a map over an int array, and scanning the result - into a reversed list (one `malloc` per node, and
+from a pool), into an array doubled by calling `next`, and with `collect_vec` - along with collecting the array itself
+(one `memcpy`) and a filter over it (whose size isn't known up front)
+*/
+void bench_collect(void);
+
+/*
+Time merging 2, 8 and 64 sorted runs of an int array - in a loser tree, through chained 2-way merges, and by scanning
+the head of every run for each element
+*/
+void bench_merge(void);
+
+/*
+Time deduplicating an int array with no and with 8 repeats per value on average - in a hash table, by sorting, and
+(for small arrays) by looking each element up in a list - along with counting and grouping ints, and counting words
+*/
+void bench_group(void);
+
+#endif /* !IT_BENCH_H */
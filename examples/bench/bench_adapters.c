@@ -0,0 +1,135 @@
+#include "../array_iterable.h"
+#include "../func_iter.h"
+#include "../iterutils/iterable_utils.h"
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define BENCH_MAX_DEPTH 8
+
+/* What the adapter benchmarks consume - an array, and how many adapters to stack on top of it */
+typedef struct
+{
+    int const* arr;
+    size_t depth;
+} ChainCtx;
+
+static int incr(int x) { return x + 1; }
+
+/* Consume the iterable one element at a time */
+static int consume_foreach(Iterable(int) it)
+{
+    int sum = 0;
+    foreach (int, x, it) {
+        sum += x;
+    }
+    return sum;
+}
+
+/* Consume the iterable in batches */
+static int consume_batch(Iterable(int) it)
+{
+    int sum = 0;
+    foreach_batch (int, buf, len, it) {
+        for (size_t i = 0; i < len; i++) {
+            sum += buf[i];
+        }
+    }
+    return sum;
+}
+
+/*
+Stack `depth` more `take_from` adapters on top of `it` and consume the result
+
+The adapters live in this function's frame, which outlives the consumption happening further down the recursion
+*/
+static int take_chain(Iterable(int) it, size_t n, size_t depth, int (*consume)(Iterable(int) it))
+{
+    if (depth == 0) {
+        return consume(it);
+    }
+    Iterable(int) takeit = take_from(it, n, int);
+    return take_chain(takeit, n, depth - 1, consume);
+}
+
+/* Stack `depth` more `map_over` adapters (mapping `incr`) on top of `it` and consume the result */
+static int map_chain(Iterable(int) it, size_t depth, int (*consume)(Iterable(int) it))
+{
+    if (depth == 0) {
+        return consume(it);
+    }
+    Iterable(int) mapit = map_over(it, incr, int, int);
+    return map_chain(mapit, depth - 1, consume);
+}
+
+static int take_foreach(void const* ctx, size_t n)
+{
+    ChainCtx const* const c = ctx;
+    return take_chain(arr_into_iter(c->arr, n, int), n, c->depth, consume_foreach);
+}
+
+static int take_batch(void const* ctx, size_t n)
+{
+    ChainCtx const* const c = ctx;
+    return take_chain(arr_into_iter(c->arr, n, int), n, c->depth, consume_batch);
+}
+
+/* The raw equivalent of any number of `take_from(it, n, int)` over an array of `n` elements */
+static int take_raw(void const* ctx, size_t n)
+{
+    ChainCtx const* const c = ctx;
+    int sum                 = 0;
+    for (size_t i = 0; i < n; i++) {
+        sum += c->arr[i];
+    }
+    return sum;
+}
+
+static int map_foreach(void const* ctx, size_t n)
+{
+    ChainCtx const* const c = ctx;
+    return map_chain(arr_into_iter(c->arr, n, int), c->depth, consume_foreach);
+}
+
+static int map_batch(void const* ctx, size_t n)
+{
+    ChainCtx const* const c = ctx;
+    return map_chain(arr_into_iter(c->arr, n, int), c->depth, consume_batch);
+}
+
+/* The raw equivalent of `depth` nested `map_over(it, incr, int, int)` */
+static int map_raw(void const* ctx, size_t n)
+{
+    ChainCtx const* const c = ctx;
+    int sum                 = 0;
+    for (size_t i = 0; i < n; i++) {
+        int x = c->arr[i];
+        for (size_t d = 0; d < c->depth; d++) {
+            x = incr(x);
+        }
+        sum += x;
+    }
+    return sum;
+}
+
+void bench_adapters(void)
+{
+    size_t const maxn = bench_sizes[bench_nsizes - 1];
+    int* const arr    = bench_intarr(maxn);
+
+    for (size_t s = 0; s < bench_nsizes && bench_sizes[s] <= bench_max_elements; s++) {
+        size_t const n = bench_sizes[s];
+        for (size_t depth = 1; depth <= BENCH_MAX_DEPTH; depth++) {
+            ChainCtx const ctx = {.arr = arr, .depth = depth};
+            bench_run("take", "raw", depth, take_raw, &ctx, n);
+            bench_run("take", "foreach", depth, take_foreach, &ctx, n);
+            bench_run("take", "foreach_batch", depth, take_batch, &ctx, n);
+            bench_run("map", "raw", depth, map_raw, &ctx, n);
+            bench_run("map", "foreach", depth, map_foreach, &ctx, n);
+            bench_run("map", "foreach_batch", depth, map_batch, &ctx, n);
+        }
+    }
+
+    free(arr);
+}
@@ -0,0 +1,110 @@
+#include "../array_iterable.h"
+#include "../func_iter.h"
+#include "../iterutils/iterable_utils.h"
+#include "../list_iterable.h"
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Linked lists cost 16+ bytes per element, keep them smaller than the arrays */
+#define BENCH_MAX_LIST_ELEMENTS (1u << 22)
+
+static int incr(int x) { return x + 1; }
+
+static bool is_even(int x) { return x % 2 == 0; }
+
+/* Materialize a map over the array into a reversed list, one `malloc` per node, and scan it */
+static int collect_list_malloc(void const* ctx, size_t n)
+{
+    Iterable(int) it = map_over(arr_into_iter(ctx, n, int), incr, int, int);
+    IntList list     = Nil;
+    foreach (int, x, it) {
+        list = prepend_intnode(x, list);
+    }
+    int const sum = sum_intit(list_into_iter(list, ConstIntList));
+    free_intlist(list);
+    return sum;
+}
+
+/* Same as `collect_list_malloc`, but the nodes come from a pool */
+static int collect_list_pool(void const* ctx, size_t n)
+{
+    Iterable(int) it = map_over(arr_into_iter(ctx, n, int), incr, int, int);
+    IntNodePool pool = {0};
+    IntList list     = Nil;
+    foreach (int, x, it) {
+        list = pool_prepend_intnode(&pool, x, list);
+    }
+    int const sum = sum_intit(list_into_iter(list, ConstIntList));
+    free_intnodepool(&pool);
+    return sum;
+}
+
+/* Materialize the map into an array by calling `next`, doubling the array whenever it's full, and scan it */
+static int collect_vec_push(void const* ctx, size_t n)
+{
+    Iterable(int) it = map_over(arr_into_iter(ctx, n, int), incr, int, int);
+    Vec(int) vec     = {0};
+    foreach (int, x, it) {
+        if (vec.len == vec.cap) {
+            vec.cap  = vec.cap == 0 ? 16 : vec.cap * 2;
+            vec.data = realloc(vec.data, vec.cap * sizeof(int));
+            if (vec.data == NULL) {
+                fprintf(stderr, "OOM in collect_vec_push");
+                exit(1);
+            }
+        }
+        vec.data[vec.len++] = x;
+    }
+    int const sum = sum_intit(arr_into_iter(vec.data, vec.len, int));
+    free_vec(vec);
+    return sum;
+}
+
+/* Materialize the map with `collect_vec` - sized once from its size hint, and filled in batches */
+static int collect_vec_map(void const* ctx, size_t n)
+{
+    Vec(int) const vec = collect_vec(map_over(arr_into_iter(ctx, n, int), incr, int, int), int);
+    int const sum      = sum_intit(arr_into_iter(vec.data, vec.len, int));
+    free_vec(vec);
+    return sum;
+}
+
+/* Materialize the array itself with `collect_vec` - one `memcpy` of its span */
+static int collect_vec_span(void const* ctx, size_t n)
+{
+    Vec(int) const vec = collect_vec(arr_into_iter(ctx, n, int), int);
+    int const sum      = sum_intit(arr_into_iter(vec.data, vec.len, int));
+    free_vec(vec);
+    return sum;
+}
+
+/* Materialize a filter over the array with `collect_vec` - which knows no lower bound, so the array is grown */
+static int collect_vec_filter(void const* ctx, size_t n)
+{
+    Vec(int) const vec = collect_vec(filter_over(arr_into_iter(ctx, n, int), is_even, int), int);
+    int const sum      = sum_intit(arr_into_iter(vec.data, vec.len, int));
+    free_vec(vec);
+    return sum;
+}
+
+void bench_collect(void)
+{
+    size_t const maxn = bench_sizes[bench_nsizes - 1];
+    int* const arr    = bench_intarr(maxn);
+
+    for (size_t s = 0; s < bench_nsizes && bench_sizes[s] <= bench_max_elements; s++) {
+        size_t const n = bench_sizes[s];
+        if (n <= BENCH_MAX_LIST_ELEMENTS) {
+            bench_run("collect", "list_malloc", 2, collect_list_malloc, arr, n);
+            bench_run("collect", "list_pool", 2, collect_list_pool, arr, n);
+        }
+        bench_run("collect", "vec_push", 2, collect_vec_push, arr, n);
+        bench_run("collect", "vec_map", 2, collect_vec_map, arr, n);
+        bench_run("collect", "vec_span", 1, collect_vec_span, arr, n);
+        bench_run("collect", "vec_filter", 2, collect_vec_filter, arr, n);
+    }
+
+    free(arr);
+}
@@ -0,0 +1,155 @@
+#define _POSIX_C_SOURCE 200809L /* For `mkstemp` */
+
+#include "../fd_iterable.h"
+#include "../func_iter.h"
+#include "../iterutils/iterable_utils.h"
+#include "../mmap_iterable.h"
+#include "bench.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Files cost ~12 bytes per line, keep them smaller than the arrays */
+#define BENCH_MAX_FILE_LINES (1u << 22)
+
+/* The file every measurement reads - written once per element count */
+typedef struct
+{
+    char path[32];
+    size_t size;
+} BenchFile;
+
+/* The file to read, and the size of the `FdBuffer` buffers to read it through */
+typedef struct
+{
+    BenchFile const* file;
+    size_t bufsize;
+} FdBenchCtx;
+
+/* Write a temporary file of `n` short lines into `file` - exits on failure */
+static void bench_write_file(BenchFile* file, size_t n)
+{
+    strcpy(file->path, "/tmp/iterators_bench_XXXXXX");
+    int const fd  = mkstemp(file->path);
+    FILE* const f = fd == -1 ? NULL : fdopen(fd, "w");
+    if (f == NULL) {
+        perror("bench_write_file");
+        exit(1);
+    }
+    for (size_t i = 0; i < n; i++) {
+        fprintf(f, "line %zu\n", i);
+    }
+    file->size = (size_t)ftell(f);
+    fclose(f);
+}
+
+/* Sum the lengths of the lines in a mapping of the file - nothing is copied */
+static int lines_mmap(void const* ctx, size_t n)
+{
+    BenchFile const* const file = ctx;
+    MappedFile mapped;
+    if (!map_file(file->path, &mapped)) {
+        perror("lines_mmap");
+        exit(1);
+    }
+    LineIter iter = {.curr = mapped.data, .end = mapped.data + mapped.size};
+    size_t total  = 0;
+    foreach_static(LineIter, StrView, line, &iter) {
+        total += line.len;
+    }
+    unmap_file(&mapped);
+    (void)n;
+    return (int)total;
+}
+
+/* Sum the lengths of the lines read one at a time with `fgets` */
+static int lines_fgets(void const* ctx, size_t n)
+{
+    BenchFile const* const file = ctx;
+    FILE* const f               = fopen(file->path, "r");
+    if (f == NULL) {
+        perror("lines_fgets");
+        exit(1);
+    }
+    char buf[4096];
+    size_t total = 0;
+    while (fgets(buf, sizeof(buf), f) != NULL) {
+        total += strlen(buf) - 1;
+    }
+    fclose(f);
+    (void)n;
+    return (int)total;
+}
+
+/* Read the whole file into a buffer first, then sum the lengths of its lines */
+static int lines_read_all(void const* ctx, size_t n)
+{
+    BenchFile const* const file = ctx;
+    FILE* const f               = fopen(file->path, "r");
+    char* const buf             = malloc(file->size + 1);
+    if (f == NULL || buf == NULL) {
+        perror("lines_read_all");
+        exit(1);
+    }
+    size_t const size = fread(buf, 1, file->size, f);
+    fclose(f);
+    LineIter iter = {.curr = buf, .end = buf + size};
+    size_t total  = 0;
+    foreach_static(LineIter, StrView, line, &iter) {
+        total += line.len;
+    }
+    free(buf);
+    (void)n;
+    return (int)total;
+}
+
+/* Sum the lengths of the lines read through an `FdBuffer` - nothing is copied, except across refills */
+static int lines_fd(void const* ctx, size_t n)
+{
+    FdBenchCtx const* const fdctx = ctx;
+    int const fd                  = open(fdctx->file->path, O_RDONLY);
+    if (fd == -1) {
+        perror("lines_fd");
+        exit(1);
+    }
+    FdBuffer buf              = new_fdbuffer(fd, fdctx->bufsize);
+    Iterable(StrView) linesit = fd_lines_into_iter(&buf);
+    size_t total              = 0;
+    foreach (StrView, line, linesit) {
+        total += line.len;
+    }
+    free_fdbuffer(&buf);
+    close(fd);
+    (void)n;
+    return (int)total;
+}
+
+void bench_files(void)
+{
+    /* Buffer sizes to read through `FdBuffer`s with, the default one included */
+    static struct
+    {
+        char const* name;
+        size_t bufsize;
+    } const fdbufs[] = {{"fd_4k", 1u << 12}, {"fd_64k", 1u << 16}, {"fd_default", FD_BUFFER_SIZE}, {"fd_1m", 1u << 20}};
+
+    for (size_t s = 0; s < bench_nsizes && bench_sizes[s] <= bench_max_elements; s++) {
+        size_t const n = bench_sizes[s];
+        if (n > BENCH_MAX_FILE_LINES) {
+            break;
+        }
+        BenchFile file;
+        bench_write_file(&file, n);
+        bench_run("file_lines", "mmap", 0, lines_mmap, &file, n);
+        bench_run("file_lines", "fgets", 0, lines_fgets, &file, n);
+        bench_run("file_lines", "read_all", 0, lines_read_all, &file, n);
+        for (size_t b = 0; b < sizeof(fdbufs) / sizeof(*fdbufs); b++) {
+            FdBenchCtx const fdctx = {.file = &file, .bufsize = fdbufs[b].bufsize};
+            bench_run("file_lines", fdbufs[b].name, 0, lines_fd, &fdctx, n);
+        }
+        remove(file.path);
+    }
+}
@@ -0,0 +1,126 @@
+#include "../array_iterable.h"
+#include "../func_iter.h"
+#include "../iterutils/iterable_utils.h"
+#include "../iterutils/simd.h"
+#include "bench.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Percentage of the elements the predicate holds for, in every run */
+static int const filter_selectivities[] = {1, 10, 25, 50, 75, 90, 99};
+
+/* The elements are below this with the selectivity of the current run */
+static int filter_threshold;
+
+/* The kernels to measure, and the array to run them over */
+typedef struct
+{
+    SimdKernels const* kernels;
+    int const* arr;
+} FilterCtx;
+
+static bool below_threshold(int x) { return x < filter_threshold; }
+
+/* Values from 0 to 99, in random order - so there's no pattern for the branch predictor to pick up on */
+static int* filter_randarr(size_t n)
+{
+    int* const arr = malloc(n * sizeof(*arr));
+    if (arr == NULL) {
+        fprintf(stderr, "OOM in filter_randarr");
+        exit(1);
+    }
+    uint32_t state = 2463534242u;
+    for (size_t i = 0; i < n; i++) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        arr[i] = (int)(state % 100);
+    }
+    return arr;
+}
+
+/* A raw loop that branches on every element */
+static int filter_loop(void const* ctx, size_t n)
+{
+    FilterCtx const* const fc = ctx;
+    int sum                   = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (below_threshold(fc->arr[i])) {
+            sum += fc->arr[i];
+        }
+    }
+    return sum;
+}
+
+/* The filter's `next`, one element at a time */
+static int filter_next(void const* ctx, size_t n)
+{
+    FilterCtx const* const fc = ctx;
+    Iterable(int) arrit       = arr_into_iter(fc->arr, n, int);
+    Iterable(int) it          = filter_over(arrit, below_threshold, int);
+    int sum                   = 0;
+    foreach (int, x, it) {
+        sum += x;
+    }
+    return sum;
+}
+
+/* The filter's batches, through the sink - compacted with the best kernel the CPU supports */
+static int filter_batch(void const* ctx, size_t n)
+{
+    FilterCtx const* const fc = ctx;
+    Iterable(int) arrit       = arr_into_iter(fc->arr, n, int);
+    return sum_intit(filter_over(arrit, below_threshold, int));
+}
+
+/* Evaluate the predicate into a mask and compact the array block by block with given kernels, no iterables involved */
+static int filter_compact(void const* ctx, size_t n)
+{
+    FilterCtx const* const fc = ctx;
+    uint32_t const* const arr = (uint32_t const*)fc->arr;
+    uint32_t buf[ITER_BATCH_SIZE];
+    uint8_t keep[ITER_BATCH_SIZE];
+    uint32_t sum = 0;
+    for (size_t i = 0; i < n; i += ITER_BATCH_SIZE) {
+        size_t const len = n - i < ITER_BATCH_SIZE ? n - i : ITER_BATCH_SIZE;
+        for (size_t j = 0; j < len; j++) {
+            keep[j] = below_threshold((int)arr[i + j]);
+        }
+        sum += fc->kernels->sum(buf, fc->kernels->compact(arr + i, keep, len, buf));
+    }
+    return (int)sum;
+}
+
+void bench_filter(void)
+{
+    size_t const maxn = bench_sizes[bench_nsizes - 1];
+    int* const arr    = filter_randarr(maxn);
+
+    SimdLevel const levels[] = {SIMD_SCALAR, SIMD_SSE2, SIMD_AVX2, SIMD_AVX512};
+    for (size_t s = 0; s < bench_nsizes && bench_sizes[s] <= bench_max_elements; s++) {
+        size_t const n = bench_sizes[s];
+        for (size_t p = 0; p < sizeof(filter_selectivities) / sizeof(*filter_selectivities); p++) {
+            filter_threshold = filter_selectivities[p];
+            char group[32];
+            snprintf(group, sizeof(group), "filter_sel%02d", filter_selectivities[p]);
+            FilterCtx const ctx = {.kernels = simd_kernels(), .arr = arr};
+            bench_run(group, "loop", 0, filter_loop, &ctx, n);
+            bench_run(group, "next", 1, filter_next, &ctx, n);
+            bench_run(group, "batch", 1, filter_batch, &ctx, n);
+            for (size_t l = 0; l < sizeof(levels) / sizeof(*levels); l++) {
+                SimdKernels const* const kernels = simd_kernels_for(levels[l]);
+                if (kernels == NULL) {
+                    continue;
+                }
+                FilterCtx const kctx = {.kernels = kernels, .arr = arr};
+                char name[32];
+                snprintf(name, sizeof(name), "compact_%s", kernels->name);
+                bench_run(group, name, 0, filter_compact, &kctx, n);
+            }
+        }
+    }
+
+    free(arr);
+}
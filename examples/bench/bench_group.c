@@ -0,0 +1,148 @@
+#include "../array_iterable.h"
+#include "../func_iter.h"
+#include "../iterutils/iterable_utils.h"
+#include "../list_iterable.h"
+#include "bench.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Room for each word made for the string keys - "w" and the digits of a `size_t` */
+#define BENCH_WORD_LEN 24
+
+/* Deduplicating into a list scans the list for every element, so it's only timed up to this many elements */
+#define BENCH_MAX_LIST_ELEMENTS (1u << 10)
+
+static int identity(int x) { return x; }
+
+static int bucket64(int x) { return x & 63; }
+
+static string word(string s) { return s; }
+
+/* Deduplicate in a hash table, and sum the distinct elements */
+static int distinct_flat(void const* ctx, size_t n)
+{
+    Iterable(int) const it = distinct(arr_into_iter(ctx, n, int), int);
+    int const sum          = sum_intit(it);
+    free_distinct(it, int);
+    return sum;
+}
+
+/* Deduplicate by sorting a copy of the elements, and sum the distinct elements - which are no longer in order */
+static int distinct_sort(void const* ctx, size_t n)
+{
+    Vec(int) vec = collect_vec(arr_into_iter(ctx, n, int), int);
+    qsort(vec.data, vec.len, sizeof(*vec.data), cmp_int);
+    unsigned sum = 0;
+    for (size_t i = 0; i < vec.len; i++) {
+        if (i == 0 || vec.data[i] != vec.data[i - 1]) {
+            sum += (unsigned)vec.data[i];
+        }
+    }
+    free_vec(vec);
+    return (int)sum;
+}
+
+/* Deduplicate by looking every element up in a list of the distinct ones so far, and sum the distinct elements */
+static int distinct_list(void const* ctx, size_t n)
+{
+    int const* const arr = ctx;
+    IntList seen         = NULL;
+    unsigned sum         = 0;
+    for (size_t i = 0; i < n; i++) {
+        ConstIntList node = seen;
+        while (node != NULL && node->val != arr[i]) {
+            node = node->next;
+        }
+        if (node == NULL) {
+            seen = prepend_intnode(arr[i], seen);
+            sum += (unsigned)arr[i];
+        }
+    }
+    free_intlist(seen);
+    return (int)sum;
+}
+
+/* Count the elements by themselves */
+static int count_ints(void const* ctx, size_t n)
+{
+    Counts(int) counts = count_by(arr_into_iter(ctx, n, int), identity, int, int);
+    int const len      = (int)counts.len;
+    free_counts(counts);
+    return len;
+}
+
+/* Count the elements by their low 6 bits - 64 keys at most */
+static int count_buckets(void const* ctx, size_t n)
+{
+    Counts(int) counts = count_by(arr_into_iter(ctx, n, int), bucket64, int, int);
+    int const len      = (int)counts.len;
+    free_counts(counts);
+    return len;
+}
+
+/* Count the words by their contents */
+static int count_words(void const* ctx, size_t n)
+{
+    Counts(string) counts = count_by(arr_into_iter(ctx, n, string), word, string, string);
+    int const len         = (int)counts.len;
+    free_counts(counts);
+    return len;
+}
+
+/* Group the elements by their low 6 bits */
+static int group_buckets(void const* ctx, size_t n)
+{
+    Groups(int, int) groups = group_by(arr_into_iter(ctx, n, int), bucket64, int, int);
+    int const len           = (int)groups.len;
+    free_groups(groups);
+    return len;
+}
+
+void bench_group(void)
+{
+    static size_t const dups[]       = {1, 8};
+    static char const* const flats[] = {"flat_unique", "flat_dup8"};
+    static char const* const sorts[] = {"sort_unique", "sort_dup8"};
+    static char const* const lists[] = {"list_unique", "list_dup8"};
+    size_t const maxn                = bench_sizes[bench_nsizes - 1];
+    int* const arr                   = bench_intarr(maxn);
+    string* const words              = malloc(maxn * sizeof(string));
+    char* const vocab                = malloc((maxn / 8) * BENCH_WORD_LEN);
+    if (words == NULL || vocab == NULL) {
+        fprintf(stderr, "OOM in bench_group");
+        exit(1);
+    }
+
+    for (size_t s = 0; s < bench_nsizes && bench_sizes[s] <= bench_max_elements; s++) {
+        size_t const n = bench_sizes[s];
+        for (size_t i = 0; i < sizeof(dups) / sizeof(*dups); i++) {
+            /* Scattered values, each one repeated `dups[i]` times on average */
+            for (size_t j = 0; j < n; j++) {
+                arr[j] = (int)((((uint32_t)j * 2654435761u) >> 8) % (n / dups[i]));
+            }
+            bench_run("group", flats[i], dups[i], distinct_flat, arr, n);
+            bench_run("group", sorts[i], dups[i], distinct_sort, arr, n);
+            if (n <= BENCH_MAX_LIST_ELEMENTS) {
+                bench_run("group", lists[i], dups[i], distinct_list, arr, n);
+            }
+            bench_run("group", "count_ints", dups[i], count_ints, arr, n);
+        }
+        bench_run("group", "count_buckets", 1, count_buckets, arr, n);
+        bench_run("group", "group_buckets", 1, group_buckets, arr, n);
+
+        /* Words of `n / 8` different contents, each one repeated 8 times on average */
+        for (size_t w = 0; w < n / 8; w++) {
+            snprintf(vocab + w * BENCH_WORD_LEN, BENCH_WORD_LEN, "w%zu", w);
+        }
+        for (size_t j = 0; j < n; j++) {
+            words[j] = vocab + (size_t)arr[j] * BENCH_WORD_LEN;
+        }
+        bench_run("group", "count_words", 8, count_words, words, n);
+    }
+
+    free(vocab);
+    free(words);
+    free(arr);
+}
@@ -0,0 +1,101 @@
+#include "../array_iterable.h"
+#include "../func_iter.h"
+#include "../iterutils/iterable_utils.h"
+#include "bench.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static int incr(int x) { return x + 1; }
+
+/* Sum a map over an array, one element at a time */
+static int chain_plain(void const* ctx, size_t n)
+{
+    Iterable(int) it = map_over(arr_into_iter(ctx, n, int), incr, int, int);
+    int sum          = 0;
+    foreach (int, x, it) {
+        sum += x;
+    }
+    return sum;
+}
+
+/* The same chain, with both stages instrumented - the same as `chain_plain` without `ITER_INSTRUMENT` */
+static int chain_instrumented(void const* ctx, size_t n)
+{
+    Iterable(int) arrit = instrument(arr_into_iter(ctx, n, int), "bench_array", int);
+    Iterable(int) it    = instrument(map_over(arrit, incr, int, int), "bench_map", int);
+    int sum             = 0;
+    foreach (int, x, it) {
+        sum += x;
+    }
+    return sum;
+}
+
+/* The same chain, summed in batches - with both stages instrumented */
+static int chain_instrumented_batch(void const* ctx, size_t n)
+{
+    Iterable(int) arrit = instrument(arr_into_iter(ctx, n, int), "bench_array", int);
+    Iterable(int) it    = instrument(map_over(arrit, incr, int, int), "bench_map", int);
+    return sum_intit(it);
+}
+
+#ifdef ITER_INSTRUMENT
+/* Increment a number - a few loops in place of real work, so the stage it's mapped in takes most of the time */
+static int slow_incr(int x)
+{
+    int volatile res = x;
+    for (int i = 0; i < 64; i++) {
+        res = res + 1 - 1;
+    }
+    return res + 1;
+}
+
+/* Ticks spent in the calls recorded in `stats` - summed up from its histogram */
+static uint64_t stage_ticks(IterStats const* stats)
+{
+    uint64_t ticks = 0;
+    for (size_t i = 0; i < INSTRUMENT_BUCKETS; i++) {
+        ticks += stats->hist_ticks[i];
+    }
+    return ticks;
+}
+
+/*
+Sum a slow map followed by a cheap one in batches, and check how the cheap stage's time is split - the time of the slow
+stage, all of it, should be recorded as the cheap stage's upstream time
+*/
+static void check_batch_split(int const* arr, size_t n)
+{
+    iter_stats_reset();
+    Iterable(int) slowit = instrument(map_over(arr_into_iter(arr, n, int), slow_incr, int, int), "bench_slow", int);
+    Iterable(int) it     = instrument(map_over(slowit, incr, int, int), "bench_fast", int);
+    int const sum        = sum_intit(it);
+    (void)sum;
+    IterStats const* const slow = iter_stats_register("bench_slow");
+    IterStats const* const fast = iter_stats_register("bench_fast");
+    uint64_t const total        = stage_ticks(fast);
+    uint64_t const upstream     = fast->upstream_ticks;
+    fprintf(stderr, "instrument: batched chain - cheap stage %.1f%% upstream, %s\n",
+            total == 0 ? 0.0 : 100.0 * (double)upstream / (double)total,
+            upstream == stage_ticks(slow) ? "the slow stage's time" : "NOT the slow stage's time");
+}
+#endif
+
+void bench_instrument(void)
+{
+    size_t const maxn = bench_sizes[bench_nsizes - 1];
+    int* const arr    = bench_intarr(maxn);
+
+    for (size_t s = 0; s < bench_nsizes && bench_sizes[s] <= bench_max_elements; s++) {
+        size_t const n = bench_sizes[s];
+        bench_run("instrument", "plain", 1, chain_plain, arr, n);
+        bench_run("instrument", "instrumented", 1, chain_instrumented, arr, n);
+        bench_run("instrument", "instrumented_batch", 1, chain_instrumented_batch, arr, n);
+    }
+#ifdef ITER_INSTRUMENT
+    check_batch_split(arr, bench_sizes[1]);
+#endif
+
+    free(arr);
+}
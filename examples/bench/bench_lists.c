@@ -0,0 +1,55 @@
+#include "../array_iterable.h"
+#include "../func_iter.h"
+#include "../iterutils/iterable_utils.h"
+#include "../list_iterable.h"
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Linked lists cost 16+ bytes per element, keep them smaller than the arrays */
+#define BENCH_MAX_LIST_ELEMENTS (1u << 22)
+
+/* Build a list out of an array iterable, one `malloc` per node, and free it one node at a time */
+static int list_build_malloc(void const* ctx, size_t n)
+{
+    Iterable(int) it = arr_into_iter(ctx, n, int);
+    IntList list     = Nil;
+    foreach (int, x, it) {
+        list = prepend_intnode(x, list);
+    }
+    int const head = list == Nil ? 0 : list->val;
+    free_intlist(list);
+    return head;
+}
+
+/* Build the same list out of a pool, and release it all at once by destroying the pool */
+static int list_build_pool(void const* ctx, size_t n)
+{
+    Iterable(int) it = arr_into_iter(ctx, n, int);
+    IntNodePool pool = {0};
+    IntList list     = Nil;
+    foreach (int, x, it) {
+        list = pool_prepend_intnode(&pool, x, list);
+    }
+    int const head = list == Nil ? 0 : list->val;
+    free_intnodepool(&pool);
+    return head;
+}
+
+void bench_lists(void)
+{
+    size_t const maxn = bench_sizes[bench_nsizes - 1];
+    int* const arr    = bench_intarr(maxn);
+
+    for (size_t s = 0; s < bench_nsizes && bench_sizes[s] <= bench_max_elements; s++) {
+        size_t const n = bench_sizes[s];
+        if (n > BENCH_MAX_LIST_ELEMENTS) {
+            break;
+        }
+        bench_run("list_build", "malloc", 0, list_build_malloc, arr, n);
+        bench_run("list_build", "pool", 0, list_build_pool, arr, n);
+    }
+
+    free(arr);
+}
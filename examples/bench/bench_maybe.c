@@ -0,0 +1,157 @@
+#include "../func_iter.h"
+#include "bench.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Large element arrays cost 64 bytes per element, keep them smaller than the int arrays */
+#define BENCH_MAX_BIG_ELEMENTS (1u << 22)
+
+/* A `char*` with a regular, tagged, `Maybe` - to compare against the niche `Maybe(string)` */
+typedef char* tagstr;
+
+/* An element too large to be returned in registers */
+typedef struct
+{
+    uint64_t words[8];
+} Big;
+
+// clang-format off
+DefineMaybe(tagstr)
+DefineMaybe(Big)
+
+DefineIteratorOf(tagstr);
+DefineIteratorOf(Big);
+// clang-format on
+
+/* Iterator over a `T` array, implemented once with `next` and once with `next_into` */
+#define BenchArr(T) CONCAT(BenchArr_, T)
+
+/* Value every element contributes to the result, so the loops can't be optimized away */
+#define bench_key_int(x)    ((uintptr_t)(x))
+#define bench_key_string(x) ((uintptr_t)(x))
+#define bench_key_tagstr(x) ((uintptr_t)(x))
+#define bench_key_Big(x)    ((uintptr_t)((x).words[0] ^ (x).words[7]))
+
+/*
+Define the `BenchArr(T)` struct, its `Iterator` impls and the functions to measure-
+
+- `T##_by_next` - Consume an iterable with `next`, i.e a `Maybe(T)` returned by value
+- `T##_by_default_into` - Consume the same iterable with `next_into`, which unwraps the `Maybe(T)` returned by `next`
+- `T##_by_into` - Consume an iterable implemented with `next_into`, no `Maybe(T)` is involved at all
+
+Iterables are passed through `T##_bench_opaque`, which reads the typeclass pointer back through a `volatile` - so the
+compiler can't see which `next` is called and inline it (as it can't when the iterable comes from another file)
+*/
+#define define_bench_maybe_funcs(T)                                                                                    \
+    typedef struct                                                                                                     \
+    {                                                                                                                  \
+        size_t i;                                                                                                      \
+        size_t size;                                                                                                   \
+        T const* arr;                                                                                                  \
+    } BenchArr(T);                                                                                                     \
+    static Maybe(T) T##_benchnxt(BenchArr(T) * self)                                                                   \
+    {                                                                                                                  \
+        return self->i < self->size ? Just(self->arr[self->i++], T) : Nothing(T);                                      \
+    }                                                                                                                  \
+    static bool T##_benchinto(BenchArr(T) * self, T * out)                                                             \
+    {                                                                                                                  \
+        if (self->i == self->size) {                                                                                   \
+            return false;                                                                                              \
+        }                                                                                                              \
+        *out = self->arr[self->i++];                                                                                   \
+        return true;                                                                                                   \
+    }                                                                                                                  \
+    impl_iterator(BenchArr(T)*, T, prep_##T##_benchnxt, T##_benchnxt)                                                  \
+    impl_iterator_into(BenchArr(T)*, T, prep_##T##_benchinto, T##_benchinto)                                           \
+    static Iterable(T) T##_bench_opaque(Iterable(T) it)                                                                \
+    {                                                                                                                  \
+        Iterator(T) const* volatile const tc = it.tc;                                                                  \
+        return (Iterable(T)){.self = it.self, .tc = tc};                                                               \
+    }                                                                                                                  \
+    static int T##_by_next(void const* ctx, size_t n)                                                                  \
+    {                                                                                                                  \
+        BenchArr(T) iter     = {.size = n, .arr = ctx};                                                              \
+        Iterable(T) const it = T##_bench_opaque(prep_##T##_benchnxt(&iter));                                           \
+        uintptr_t acc        = 0;                                                                                      \
+        for (Maybe(T) res = it.tc->next(it.self); is_just_of(res, T); res = it.tc->next(it.self)) {                    \
+            acc += bench_key_##T(from_just_(res));                                                                     \
+        }                                                                                                              \
+        return (int)acc;                                                                                               \
+    }                                                                                                                  \
+    static int T##_by_default_into(void const* ctx, size_t n)                                                          \
+    {                                                                                                                  \
+        BenchArr(T) iter     = {.size = n, .arr = ctx};                                                              \
+        Iterable(T) const it = T##_bench_opaque(prep_##T##_benchnxt(&iter));                                           \
+        uintptr_t acc        = 0;                                                                                      \
+        T x;                                                                                                           \
+        while (iter_next_into(it, &x, T)) {                                                                            \
+            acc += bench_key_##T(x);                                                                                   \
+        }                                                                                                              \
+        return (int)acc;                                                                                               \
+    }                                                                                                                  \
+    static int T##_by_into(void const* ctx, size_t n)                                                                  \
+    {                                                                                                                  \
+        BenchArr(T) iter     = {.size = n, .arr = ctx};                                                              \
+        Iterable(T) const it = T##_bench_opaque(prep_##T##_benchinto(&iter));                                          \
+        uintptr_t acc        = 0;                                                                                      \
+        T x;                                                                                                           \
+        while (iter_next_into(it, &x, T)) {                                                                            \
+            acc += bench_key_##T(x);                                                                                   \
+        }                                                                                                              \
+        return (int)acc;                                                                                               \
+    }
+
+// clang-format off
+define_bench_maybe_funcs(int)
+define_bench_maybe_funcs(string)
+define_bench_maybe_funcs(tagstr)
+define_bench_maybe_funcs(Big)
+// clang-format on
+
+void bench_maybe(void)
+{
+    static char text[256];
+    size_t const maxn   = bench_sizes[bench_nsizes - 1];
+    int* const arr      = bench_intarr(maxn);
+    string* const strs  = malloc(maxn * sizeof(*strs));
+    size_t const maxbig = maxn < BENCH_MAX_BIG_ELEMENTS ? maxn : BENCH_MAX_BIG_ELEMENTS;
+    Big* const bigs     = malloc(maxbig * sizeof(*bigs));
+    if (strs == NULL || bigs == NULL) {
+        fprintf(stderr, "OOM in bench_maybe");
+        exit(1);
+    }
+    for (size_t i = 0; i < maxn; i++) {
+        strs[i] = text + (i & 0xFF);
+    }
+    for (size_t i = 0; i < maxbig; i++) {
+        for (size_t w = 0; w < 8; w++) {
+            bigs[i].words[w] = i * 8 + w;
+        }
+    }
+
+    for (size_t s = 0; s < bench_nsizes && bench_sizes[s] <= bench_max_elements; s++) {
+        size_t const n = bench_sizes[s];
+        bench_run("maybe_int", "next", 0, int_by_next, arr, n);
+        bench_run("maybe_int", "next_into_default", 0, int_by_default_into, arr, n);
+        bench_run("maybe_int", "next_into", 0, int_by_into, arr, n);
+        /* The same pointers, through a tagged `Maybe` (two registers) and the niche one (one register) */
+        bench_run("maybe_string", "tagged_next", 0, tagstr_by_next, strs, n);
+        bench_run("maybe_string", "tagged_next_into_default", 0, tagstr_by_default_into, strs, n);
+        bench_run("maybe_string", "tagged_next_into", 0, tagstr_by_into, strs, n);
+        bench_run("maybe_string", "niche_next", 0, string_by_next, strs, n);
+        bench_run("maybe_string", "niche_next_into_default", 0, string_by_default_into, strs, n);
+        bench_run("maybe_string", "niche_next_into", 0, string_by_into, strs, n);
+        if (n <= maxbig) {
+            bench_run("maybe_big", "next", 0, Big_by_next, bigs, n);
+            bench_run("maybe_big", "next_into_default", 0, Big_by_default_into, bigs, n);
+            bench_run("maybe_big", "next_into", 0, Big_by_into, bigs, n);
+        }
+    }
+
+    free(bigs);
+    free(strs);
+    free(arr);
+}
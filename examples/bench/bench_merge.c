@@ -0,0 +1,117 @@
+#include "../array_iterable.h"
+#include "../func_iter.h"
+#include "../iterutils/iterable_utils.h"
+#include "bench.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/* The most sources merged at once */
+#define BENCH_MAX_RUNS 64
+
+/* `k` sorted runs, one after the other in `arr` - run `s` is `arr[s * n / k]` up to `arr[(s + 1) * n / k]` */
+typedef struct
+{
+    int const* arr;
+    size_t k;
+} MergeRuns;
+
+/* Comparison that goes through a function pointer, like the merges' */
+static MergeCmp volatile scan_cmp = cmp_int;
+
+/* Merge the runs in a loser tree, and sum the merged elements */
+static int merge_tree(void const* ctx, size_t n)
+{
+    MergeRuns const* const runs = ctx;
+    Iterable(int) its[BENCH_MAX_RUNS];
+    IterArena arena = new_arena(BENCH_MAX_RUNS * sizeof(ArrIter(int)) + 64);
+    for (size_t s = 0; s < runs->k; s++) {
+        size_t const from = s * n / runs->k;
+        its[s]            = arena_arr_into_iter(&arena, runs->arr + from, (s + 1) * n / runs->k - from, int);
+    }
+    Iterable(int) const it = merge_sorted(its, runs->k, cmp_int, int);
+    int const sum          = sum_intit(it);
+    free_merge(it, int);
+    free_arena(&arena);
+    return sum;
+}
+
+/* Merge the runs by chaining 2-way merges - every element goes through up to `k - 1` of them */
+static int merge_pairwise(void const* ctx, size_t n)
+{
+    MergeRuns const* const runs = ctx;
+    Iterable(int) merges[BENCH_MAX_RUNS];
+    IterArena arena   = new_arena(BENCH_MAX_RUNS * sizeof(ArrIter(int)) + 64);
+    Iterable(int) acc = arena_arr_into_iter(&arena, runs->arr, n / runs->k, int);
+    for (size_t s = 1; s < runs->k; s++) {
+        size_t const from     = s * n / runs->k;
+        size_t const len      = (s + 1) * n / runs->k - from;
+        Iterable(int) pair[2] = {acc, arena_arr_into_iter(&arena, runs->arr + from, len, int)};
+        acc                   = merge_sorted(pair, 2, cmp_int, int);
+        merges[s]             = acc;
+    }
+    int const sum = sum_intit(acc);
+    for (size_t s = 1; s < runs->k; s++) {
+        free_merge(merges[s], int);
+    }
+    free_arena(&arena);
+    return sum;
+}
+
+/* Merge the runs by scanning the head of every run for the smallest one, for every element */
+static int merge_scan(void const* ctx, size_t n)
+{
+    MergeRuns const* const runs = ctx;
+    size_t pos[BENCH_MAX_RUNS];
+    size_t end[BENCH_MAX_RUNS];
+    for (size_t s = 0; s < runs->k; s++) {
+        pos[s] = s * n / runs->k;
+        end[s] = (s + 1) * n / runs->k;
+    }
+    MergeCmp const cmp = scan_cmp;
+    int sum            = 0;
+    while (true) {
+        size_t best = runs->k;
+        for (size_t s = 0; s < runs->k; s++) {
+            if (pos[s] != end[s] && (best == runs->k || cmp(runs->arr + pos[s], runs->arr + pos[best]) < 0)) {
+                best = s;
+            }
+        }
+        if (best == runs->k) {
+            break;
+        }
+        sum = (int)((unsigned)sum + (unsigned)runs->arr[pos[best]++]);
+    }
+    return sum;
+}
+
+void bench_merge(void)
+{
+    static size_t const ks[]         = {2, 8, BENCH_MAX_RUNS};
+    static char const* const trees[] = {"tree_2", "tree_8", "tree_64"};
+    static char const* const pairs[] = {"pairwise_2", "pairwise_8", "pairwise_64"};
+    static char const* const scans[] = {"scan_2", "scan_8", "scan_64"};
+    size_t const maxn                = bench_sizes[bench_nsizes - 1];
+    int* const arr                   = bench_intarr(maxn);
+
+    for (size_t s = 0; s < bench_nsizes && bench_sizes[s] <= bench_max_elements; s++) {
+        size_t const n = bench_sizes[s];
+        for (size_t i = 0; i < sizeof(ks) / sizeof(*ks); i++) {
+            size_t const k = ks[i];
+            /* Scattered values, sorted run by run */
+            for (size_t j = 0; j < n; j++) {
+                arr[j] = (int)(((uint32_t)j * 2654435761u) >> 8);
+            }
+            for (size_t r = 0; r < k; r++) {
+                qsort(arr + r * n / k, (r + 1) * n / k - r * n / k, sizeof(*arr), cmp_int);
+            }
+            MergeRuns const runs = {.arr = arr, .k = k};
+            bench_run("merge", trees[i], k, merge_tree, &runs, n);
+            bench_run("merge", pairs[i], k, merge_pairwise, &runs, n);
+            bench_run("merge", scans[i], k, merge_scan, &runs, n);
+        }
+    }
+
+    free(arr);
+}
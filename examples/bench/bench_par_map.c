@@ -0,0 +1,67 @@
+#include "../array_iterable.h"
+#include "../func_iter.h"
+#include "../iterutils/iterable_utils.h"
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Thread counts every parallel map is run with - 0 standing for the sequential `map_over` */
+static size_t const par_map_threads[] = {0, 1, 2, 4, 8};
+
+typedef struct
+{
+    int const* arr;
+    size_t nthreads;
+    int (*fn)(int x);
+} ParMapCtx;
+
+static int incr(int x) { return x + 1; }
+
+/* A few dozen dependent multiplies - stands in for parsing, or formatting, an element */
+static int churn(int x)
+{
+    unsigned h = (unsigned)x;
+    for (int i = 0; i < 32; i++) {
+        h = h * 2654435761u + 1;
+    }
+    return (int)(h >> 24);
+}
+
+/* Sum a map over the array - on `nthreads` threads, or with `map_over` if that's 0 */
+static int par_map_sum(void const* ctx, size_t n)
+{
+    ParMapCtx const* const pm = ctx;
+    Iterable(int) arrit       = arr_into_iter(pm->arr, n, int);
+    if (pm->nthreads == 0) {
+        return sum_intit(map_over(arrit, pm->fn, int, int));
+    }
+    Iterable(int) it = par_map_over(arrit, pm->fn, int, int, pm->nthreads);
+    int const total  = sum_intit(it);
+    free_par_map(it, int, int);
+    return total;
+}
+
+void bench_par_map(void)
+{
+    size_t const maxn = bench_sizes[bench_nsizes - 1];
+    int* const arr    = bench_intarr(maxn);
+
+    for (size_t s = 0; s < bench_nsizes && bench_sizes[s] <= bench_max_elements; s++) {
+        size_t const n = bench_sizes[s];
+        for (size_t t = 0; t < sizeof(par_map_threads) / sizeof(*par_map_threads); t++) {
+            char name[32];
+            if (par_map_threads[t] == 0) {
+                snprintf(name, sizeof(name), "map_over");
+            } else {
+                snprintf(name, sizeof(name), "par_map_t%zu", par_map_threads[t]);
+            }
+            ParMapCtx const light = {.arr = arr, .nthreads = par_map_threads[t], .fn = incr};
+            bench_run("par_map_light", name, 1, par_map_sum, &light, n);
+            ParMapCtx const heavy = {.arr = arr, .nthreads = par_map_threads[t], .fn = churn};
+            bench_run("par_map_heavy", name, 1, par_map_sum, &heavy, n);
+        }
+    }
+
+    free(arr);
+}
@@ -0,0 +1,51 @@
+#include "../array_iterable.h"
+#include "../func_iter.h"
+#include "../iterutils/iterable_utils.h"
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Thread counts every parallel benchmark is run with - 1 being the sequential fallback */
+static size_t const par_threads[] = {1, 2, 4, 8};
+
+typedef struct
+{
+    int const* arr;
+    size_t nthreads;
+} ParCtx;
+
+static int incr(int x) { return x + 1; }
+
+static int par_sum_array(void const* ctx, size_t n)
+{
+    ParCtx const* const par = ctx;
+    return par_sum_intit(arr_into_iter(par->arr, n, int), par->nthreads);
+}
+
+static int par_sum_map(void const* ctx, size_t n)
+{
+    ParCtx const* const par = ctx;
+    Iterable(int) arrit     = arr_into_iter(par->arr, n, int);
+    return par_sum_intit(map_over(arrit, incr, int, int), par->nthreads);
+}
+
+void bench_parallel(void)
+{
+    size_t const maxn = bench_sizes[bench_nsizes - 1];
+    int* const arr    = bench_intarr(maxn);
+
+    for (size_t s = 0; s < bench_nsizes && bench_sizes[s] <= bench_max_elements; s++) {
+        size_t const n = bench_sizes[s];
+        for (size_t t = 0; t < sizeof(par_threads) / sizeof(*par_threads); t++) {
+            ParCtx const ctx = {.arr = arr, .nthreads = par_threads[t]};
+            char name[32];
+            snprintf(name, sizeof(name), "sum_array_t%zu", par_threads[t]);
+            bench_run("parallel", name, 0, par_sum_array, &ctx, n);
+            snprintf(name, sizeof(name), "sum_map_t%zu", par_threads[t]);
+            bench_run("parallel", name, 1, par_sum_map, &ctx, n);
+        }
+    }
+
+    free(arr);
+}
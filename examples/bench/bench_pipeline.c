@@ -0,0 +1,83 @@
+#include "../array_iterable.h"
+#include "../func_iter.h"
+#include "../iterutils/iterable_utils.h"
+#include "bench.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Number of stages in the measured chains */
+#define PIPELINE_DEPTH 4
+
+static int incr(int x) { return x + 1; }
+
+static int dbl(int x) { return x * 2; }
+
+static int decr(int x) { return x - 1; }
+
+// clang-format off
+DefinePipeline(BenchPipe, int, int,
+    pipe_take(SIZE_MAX, int), pipe_map(incr, int, int), pipe_map(dbl, int, int), pipe_map(decr, int, int))
+// clang-format on
+
+static int pipeline_raw(void const* ctx, size_t n)
+{
+    int const* const arr = ctx;
+    int sum              = 0;
+    for (size_t i = 0; i < n; i++) {
+        sum += decr(dbl(incr(arr[i])));
+    }
+    return sum;
+}
+
+static int pipeline_chained(void const* ctx, size_t n)
+{
+    Iterable(int) arrit  = arr_into_iter(ctx, n, int);
+    Iterable(int) takeit = take_from(arrit, SIZE_MAX, int);
+    Iterable(int) incrit = map_over(takeit, incr, int, int);
+    Iterable(int) dblit  = map_over(incrit, dbl, int, int);
+    Iterable(int) decrit = map_over(dblit, decr, int, int);
+    int sum              = 0;
+    foreach (int, x, decrit) {
+        sum += x;
+    }
+    return sum;
+}
+
+static int pipeline_fused(void const* ctx, size_t n)
+{
+    Iterable(int) arrit = arr_into_iter(ctx, n, int);
+    Iterable(int) pipe  = pipeline_from(arrit, BenchPipe);
+    int sum             = 0;
+    foreach (int, x, pipe) {
+        sum += x;
+    }
+    return sum;
+}
+
+static int pipeline_fused_static(void const* ctx, size_t n)
+{
+    BenchPipe pipe = {.taken = {0}, .src = arr_into_iter(ctx, n, int)};
+    int sum        = 0;
+    foreach_static (BenchPipe, int, x, &pipe) {
+        sum += x;
+    }
+    return sum;
+}
+
+void bench_pipeline(void)
+{
+    size_t const maxn = bench_sizes[bench_nsizes - 1];
+    int* const arr    = bench_intarr(maxn);
+
+    for (size_t s = 0; s < bench_nsizes && bench_sizes[s] <= bench_max_elements; s++) {
+        size_t const n = bench_sizes[s];
+        bench_run("pipeline", "raw", PIPELINE_DEPTH, pipeline_raw, arr, n);
+        bench_run("pipeline", "chained_adapters", PIPELINE_DEPTH, pipeline_chained, arr, n);
+        bench_run("pipeline", "fused", PIPELINE_DEPTH, pipeline_fused, arr, n);
+        bench_run("pipeline", "fused_static", PIPELINE_DEPTH, pipeline_fused_static, arr, n);
+    }
+
+    free(arr);
+}
@@ -0,0 +1,70 @@
+#include "../array_iterable.h"
+#include "../func_iter.h"
+#include "../iterutils/iterable_utils.h"
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Ring capacities every readahead benchmark is run with - 0 standing for no readahead at all */
+static size_t const readahead_caps[] = {0, 256, 4096, 65536};
+
+typedef struct
+{
+    int const* arr;
+    size_t capacity;
+    /* Whether the source and the consumer each do some work per element, rather than next to nothing */
+    bool heavy;
+} ReadaheadCtx;
+
+static int incr(int x) { return x + 1; }
+
+/* A few dozen dependent multiplies - stands in for parsing, or decompressing, an element */
+static int churn(int x)
+{
+    unsigned h = (unsigned)x;
+    for (int i = 0; i < 32; i++) {
+        h = h * 2654435761u + 1;
+    }
+    return (int)(h >> 24);
+}
+
+/* Consume a map over the array - read ahead on another thread, unless the capacity is 0 */
+static int readahead_sum(void const* ctx, size_t n)
+{
+    ReadaheadCtx const* const ra = ctx;
+    Iterable(int) srcit          = map_over(arr_into_iter(ra->arr, n, int), ra->heavy ? churn : incr, int, int);
+    Iterable(int) it             = ra->capacity == 0 ? srcit : readahead(srcit, ra->capacity, int);
+    int total                    = 0;
+    foreach (int, x, it) {
+        total += ra->heavy ? churn(x) : x;
+    }
+    if (ra->capacity != 0) {
+        free_readahead(it, int);
+    }
+    return total;
+}
+
+void bench_readahead(void)
+{
+    size_t const maxn = bench_sizes[bench_nsizes - 1];
+    int* const arr    = bench_intarr(maxn);
+
+    for (size_t s = 0; s < bench_nsizes && bench_sizes[s] <= bench_max_elements; s++) {
+        size_t const n = bench_sizes[s];
+        for (size_t c = 0; c < sizeof(readahead_caps) / sizeof(*readahead_caps); c++) {
+            char name[32];
+            if (readahead_caps[c] == 0) {
+                snprintf(name, sizeof(name), "sequential");
+            } else {
+                snprintf(name, sizeof(name), "cap_%zu", readahead_caps[c]);
+            }
+            ReadaheadCtx const light = {.arr = arr, .capacity = readahead_caps[c], .heavy = false};
+            bench_run("readahead_light", name, 1, readahead_sum, &light, n);
+            ReadaheadCtx const heavy = {.arr = arr, .capacity = readahead_caps[c], .heavy = true};
+            bench_run("readahead_heavy", name, 1, readahead_sum, &heavy, n);
+        }
+    }
+
+    free(arr);
+}
@@ -0,0 +1,91 @@
+#include "../array_iterable.h"
+#include "../func_iter.h"
+#include "../iterutils/iterable_utils.h"
+#include "../iterutils/simd.h"
+#include "bench.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/* The kernels to measure, and the array to run them over */
+typedef struct
+{
+    SimdKernels const* kernels;
+    uint32_t const* arr;
+} ReduceCtx;
+
+static int reduce_sum(void const* ctx, size_t n)
+{
+    ReduceCtx const* const red = ctx;
+    return (int)red->kernels->sum(red->arr, n);
+}
+
+static int reduce_min(void const* ctx, size_t n)
+{
+    ReduceCtx const* const red = ctx;
+    return (int)red->kernels->min(red->arr, n, 0);
+}
+
+static int reduce_max(void const* ctx, size_t n)
+{
+    ReduceCtx const* const red = ctx;
+    return (int)red->kernels->max(red->arr, n, SIMD_UNSIGNED_BIAS);
+}
+
+static int reduce_count(void const* ctx, size_t n)
+{
+    ReduceCtx const* const red = ctx;
+    return (int)red->kernels->count(red->arr, n, SIMD_CMP_LT, 128, 0);
+}
+
+static int reduce_dot(void const* ctx, size_t n)
+{
+    ReduceCtx const* const red = ctx;
+    return (int)red->kernels->dot(red->arr, red->arr, n);
+}
+
+static int ident(int x) { return x; }
+
+/* The sink over an array - the whole span goes to the kernel */
+static int sink_sum_span(void const* ctx, size_t n) { return sum_intit(arr_into_iter(ctx, n, int)); }
+
+/* The sink over a map - which has no span, so it's staged through a buffer */
+static int sink_sum_staged(void const* ctx, size_t n)
+{
+    Iterable(int) arrit = arr_into_iter(ctx, n, int);
+    return sum_intit(map_over(arrit, ident, int, int));
+}
+
+void bench_reduce(void)
+{
+    size_t const maxn = bench_sizes[bench_nsizes - 1];
+    int* const arr    = bench_intarr(maxn);
+
+    SimdLevel const levels[] = {SIMD_SCALAR, SIMD_SSE2, SIMD_AVX2};
+    for (size_t s = 0; s < bench_nsizes && bench_sizes[s] <= bench_max_elements; s++) {
+        size_t const n = bench_sizes[s];
+        for (size_t l = 0; l < sizeof(levels) / sizeof(*levels); l++) {
+            SimdKernels const* const kernels = simd_kernels_for(levels[l]);
+            if (kernels == NULL) {
+                continue;
+            }
+            ReduceCtx const ctx = {.kernels = kernels, .arr = (uint32_t const*)arr};
+            char name[32];
+            snprintf(name, sizeof(name), "sum_%s", kernels->name);
+            bench_run("reduce", name, 0, reduce_sum, &ctx, n);
+            snprintf(name, sizeof(name), "min_%s", kernels->name);
+            bench_run("reduce", name, 0, reduce_min, &ctx, n);
+            snprintf(name, sizeof(name), "max_%s", kernels->name);
+            bench_run("reduce", name, 0, reduce_max, &ctx, n);
+            snprintf(name, sizeof(name), "count_%s", kernels->name);
+            bench_run("reduce", name, 0, reduce_count, &ctx, n);
+            snprintf(name, sizeof(name), "dot_%s", kernels->name);
+            bench_run("reduce", name, 0, reduce_dot, &ctx, n);
+        }
+        bench_run("reduce", "sum_intit_span", 0, sink_sum_span, arr, n);
+        bench_run("reduce", "sum_intit_staged", 1, sink_sum_staged, arr, n);
+    }
+
+    free(arr);
+}
@@ -0,0 +1,80 @@
+#include "../array_iterable.h"
+#include "../fibonacci_iterable.h"
+#include "../func_iter.h"
+#include "../iterutils/iterable_utils.h"
+#include "bench.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+static int incr(int x) { return x + 1; }
+
+static bool is_even(int x) { return x % 2 == 0; }
+
+/* Skip all but the last element of the array by calling `next`, and return the last one */
+static int skip_array_next(void const* ctx, size_t n)
+{
+    Iterable(int) it = arr_into_iter(ctx, n, int);
+    for (size_t i = 1; i < n; i++) {
+        (void)it.tc->next(it.self);
+    }
+    return from_just_(it.tc->next(it.self));
+}
+
+/* Skip all but the last element of the array with its `advance_by` */
+static int skip_array_advance(void const* ctx, size_t n)
+{
+    Iterable(int) it = skip_from(arr_into_iter(ctx, n, int), n - 1, int);
+    return from_just_(it.tc->next(it.self));
+}
+
+/* Skip all but the last element of a map over the array - forwarded to the array, without mapping */
+static int skip_map_advance(void const* ctx, size_t n)
+{
+    Iterable(int) it = skip_from(map_over(arr_into_iter(ctx, n, int), incr, int, int), n - 1, int);
+    return from_just_(it.tc->next(it.self));
+}
+
+/* Skip half of the elements that pass a filter over the array - which falls back to calling `next` */
+static int skip_filter_fallback(void const* ctx, size_t n)
+{
+    Iterable(int) it = skip_from(filter_over(arr_into_iter(ctx, n, int), is_even, int), n / 4, int);
+    return from_just_(it.tc->next(it.self));
+}
+
+/* Skip `n` fibonacci numbers by calling `next` */
+static int skip_fib_next(void const* ctx, size_t n)
+{
+    (void)ctx;
+    Iterable(uint32_t) it = get_fibitr();
+    for (size_t i = 0; i < n; i++) {
+        (void)it.tc->next(it.self);
+    }
+    return (int)from_just_(it.tc->next(it.self));
+}
+
+/* Skip `n` fibonacci numbers by matrix doubling */
+static int skip_fib_advance(void const* ctx, size_t n)
+{
+    (void)ctx;
+    Iterable(uint32_t) it = skip_from(get_fibitr(), n, uint32_t);
+    return (int)from_just_(it.tc->next(it.self));
+}
+
+void bench_skip(void)
+{
+    size_t const maxn = bench_sizes[bench_nsizes - 1];
+    int* const arr    = bench_intarr(maxn);
+
+    for (size_t s = 0; s < bench_nsizes && bench_sizes[s] <= bench_max_elements; s++) {
+        size_t const n = bench_sizes[s];
+        bench_run("skip", "array_next", 1, skip_array_next, arr, n);
+        bench_run("skip", "array_advance", 1, skip_array_advance, arr, n);
+        bench_run("skip", "map_advance", 2, skip_map_advance, arr, n);
+        bench_run("skip", "filter_fallback", 2, skip_filter_fallback, arr, n);
+        bench_run("skip", "fib_next", 1, skip_fib_next, NULL, n);
+        bench_run("skip", "fib_advance", 1, skip_fib_advance, NULL, n);
+    }
+
+    free(arr);
+}
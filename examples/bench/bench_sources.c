@@ -0,0 +1,331 @@
+#include "../array_iterable.h"
+#include "../chunklist_iterable.h"
+#include "../fibonacci_iterable.h"
+#include "../func_iter.h"
+#include "../iterutils/iterable_utils.h"
+#include "../list_iterable.h"
+#include "../range_iterable.h"
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Linked lists cost 16+ bytes (and a malloc) per element, keep them smaller than the arrays */
+#define BENCH_MAX_LIST_ELEMENTS (1u << 22)
+
+/* Array sources */
+
+static int arr_raw(void const* ctx, size_t n)
+{
+    int const* const arr = ctx;
+    int sum              = 0;
+    for (size_t i = 0; i < n; i++) {
+        sum += arr[i];
+    }
+    return sum;
+}
+
+static int arr_foreach(void const* ctx, size_t n)
+{
+    Iterable(int) it = arr_into_iter(ctx, n, int);
+    int sum          = 0;
+    foreach (int, x, it) {
+        sum += x;
+    }
+    return sum;
+}
+
+static int arr_static(void const* ctx, size_t n)
+{
+    ArrIter(int) iter = {.i = 0, .size = n, .arr = ctx};
+    int sum           = 0;
+    foreach_static (ArrIter(int), int, x, &iter) {
+        sum += x;
+    }
+    return sum;
+}
+
+static int arr_batch(void const* ctx, size_t n)
+{
+    Iterable(int) it = arr_into_iter(ctx, n, int);
+    int sum          = 0;
+    foreach_batch (int, buf, len, it) {
+        for (size_t i = 0; i < len; i++) {
+            sum += buf[i];
+        }
+    }
+    return sum;
+}
+
+/* `sum_intit` takes the `as_span` fast path for arrays */
+static int arr_sum_intit(void const* ctx, size_t n) { return sum_intit(arr_into_iter(ctx, n, int)); }
+
+/* List sources */
+
+static int list_raw(void const* ctx, size_t n)
+{
+    (void)n;
+    int sum = 0;
+    for (IntNode const* node = ctx; node != Nil; node = node->next) {
+        sum += node->val;
+    }
+    return sum;
+}
+
+static int list_foreach(void const* ctx, size_t n)
+{
+    (void)n;
+    Iterable(int) it = list_into_iter(ctx, ConstIntList);
+    int sum          = 0;
+    foreach (int, x, it) {
+        sum += x;
+    }
+    return sum;
+}
+
+static int list_static(void const* ctx, size_t n)
+{
+    (void)n;
+    ListIter(ConstIntList) iter = {.curr = ctx};
+    int sum                     = 0;
+    foreach_static (ListIter(ConstIntList), int, x, &iter) {
+        sum += x;
+    }
+    return sum;
+}
+
+static int list_batch(void const* ctx, size_t n)
+{
+    (void)n;
+    Iterable(int) it = list_into_iter(ctx, ConstIntList);
+    int sum          = 0;
+    foreach_batch (int, buf, len, it) {
+        for (size_t i = 0; i < len; i++) {
+            sum += buf[i];
+        }
+    }
+    return sum;
+}
+
+/* Unrolled list sources */
+
+static int chunklist_raw(void const* ctx, size_t n)
+{
+    (void)n;
+    IntChunkList const* const list = ctx;
+    int sum                        = 0;
+    for (IntChunk const* chunk = list->head; chunk != NULL; chunk = chunk->next) {
+        for (uint32_t i = chunk->start; i < chunk->start + chunk->len; i++) {
+            sum += chunk->vals[i];
+        }
+    }
+    return sum;
+}
+
+static int chunklist_foreach(void const* ctx, size_t n)
+{
+    (void)n;
+    Iterable(int) it = chunklist_into_iter(*(IntChunkList const*)ctx);
+    int sum          = 0;
+    foreach (int, x, it) {
+        sum += x;
+    }
+    return sum;
+}
+
+static int chunklist_static(void const* ctx, size_t n)
+{
+    (void)n;
+    IntChunkList const* const list = ctx;
+    IntChunkListIter iter          = {.next = list->head, .curr = NULL, .end = NULL, .left = list->len};
+    int sum                        = 0;
+    foreach_static (IntChunkListIter, int, x, &iter) {
+        sum += x;
+    }
+    return sum;
+}
+
+static int chunklist_batch(void const* ctx, size_t n)
+{
+    (void)n;
+    Iterable(int) it = chunklist_into_iter(*(IntChunkList const*)ctx);
+    int sum          = 0;
+    foreach_batch (int, buf, len, it) {
+        for (size_t i = 0; i < len; i++) {
+            sum += buf[i];
+        }
+    }
+    return sum;
+}
+
+/* Fibonacci source - infinite, so only `n` elements are pulled out of it */
+
+static int fib_raw(void const* ctx, size_t n)
+{
+    (void)ctx;
+    uint32_t curr = 0, next = 1, sum = 0;
+    for (size_t i = 0; i < n; i++) {
+        uint32_t const new_nxt = curr + next;
+        curr                   = next;
+        next                   = new_nxt;
+        sum += new_nxt;
+    }
+    return (int)sum;
+}
+
+static int fib_foreach(void const* ctx, size_t n)
+{
+    (void)ctx;
+    Iterable(uint32_t) it = get_fibitr();
+    uint32_t sum          = 0;
+    for (size_t i = 0; i < n; i++) {
+        sum += from_just_(it.tc->next(it.self));
+    }
+    return (int)sum;
+}
+
+static int fib_static(void const* ctx, size_t n)
+{
+    (void)ctx;
+    Fibonacci fib = {.curr = 0, .next = 1};
+    uint32_t sum  = 0;
+    for (size_t i = 0; i < n; i++) {
+        sum += from_just_(static_next(Fibonacci)(&fib));
+    }
+    return (int)sum;
+}
+
+static int fib_batch(void const* ctx, size_t n)
+{
+    (void)ctx;
+    Iterable(uint32_t) it = get_fibitr();
+    uint32_t buf[ITER_BATCH_SIZE];
+    uint32_t sum = 0;
+    while (n != 0) {
+        size_t const len = iter_next_batch(it, buf, n < ITER_BATCH_SIZE ? n : ITER_BATCH_SIZE, uint32_t);
+        for (size_t i = 0; i < len; i++) {
+            sum += buf[i];
+        }
+        n -= len;
+    }
+    return (int)sum;
+}
+
+/* Range sources - the values 0 to n, summed with wrap around */
+
+static int range_raw(void const* ctx, size_t n)
+{
+    (void)ctx;
+    unsigned sum = 0;
+    for (size_t i = 0; i < n; i++) {
+        sum += (unsigned)i;
+    }
+    return (int)sum;
+}
+
+/* What ranges replace - an array of the indices, built just to be iterated through */
+static int range_index_array(void const* ctx, size_t n)
+{
+    (void)ctx;
+    int* const idx = bench_intarr(n);
+    for (size_t i = 0; i < n; i++) {
+        idx[i] = (int)i;
+    }
+    int const sum = sum_intit(arr_into_iter(idx, n, int));
+    free(idx);
+    return sum;
+}
+
+static int range_foreach(void const* ctx, size_t n)
+{
+    (void)ctx;
+    Iterable(int) it = range_into_iter(0, (int)n, 1, int);
+    unsigned sum     = 0;
+    foreach (int, x, it) {
+        sum += (unsigned)x;
+    }
+    return (int)sum;
+}
+
+static int range_static(void const* ctx, size_t n)
+{
+    (void)ctx;
+    Range(int) range = {.curr = 0, .step = 1, .len = n};
+    unsigned sum     = 0;
+    foreach_static (Range(int), int, x, &range) {
+        sum += (unsigned)x;
+    }
+    return (int)sum;
+}
+
+static int range_batch(void const* ctx, size_t n)
+{
+    (void)ctx;
+    Iterable(int) it = range_into_iter(0, (int)n, 1, int);
+    unsigned sum     = 0;
+    foreach_batch (int, buf, len, it) {
+        for (size_t i = 0; i < len; i++) {
+            sum += (unsigned)buf[i];
+        }
+    }
+    return (int)sum;
+}
+
+/* `sum_intit` sums ranges in closed form, through `as_progression` */
+static int range_sum_intit(void const* ctx, size_t n)
+{
+    (void)ctx;
+    return sum_intit(range_into_iter(0, (int)n, 1, int));
+}
+
+void bench_sources(void)
+{
+    size_t const maxn = bench_sizes[bench_nsizes - 1];
+    int* const arr    = bench_intarr(maxn);
+
+    for (size_t s = 0; s < bench_nsizes && bench_sizes[s] <= bench_max_elements; s++) {
+        size_t const n = bench_sizes[s];
+        bench_run("array", "raw", 0, arr_raw, arr, n);
+        bench_run("array", "foreach", 0, arr_foreach, arr, n);
+        bench_run("array", "foreach_static", 0, arr_static, arr, n);
+        bench_run("array", "foreach_batch", 0, arr_batch, arr, n);
+        bench_run("array", "sum_intit", 0, arr_sum_intit, arr, n);
+
+        if (n <= BENCH_MAX_LIST_ELEMENTS) {
+            IntList list = Nil;
+            for (size_t i = 0; i < n; i++) {
+                list = prepend_intnode(arr[i], list);
+            }
+            bench_run("list", "raw", 0, list_raw, list, n);
+            bench_run("list", "foreach", 0, list_foreach, list, n);
+            bench_run("list", "foreach_static", 0, list_static, list, n);
+            bench_run("list", "foreach_batch", 0, list_batch, list, n);
+            list = free_intlist(list);
+
+            /* Same elements (in the same order) as the list above */
+            IntChunkList chunklist = {0};
+            for (size_t i = 0; i < n; i++) {
+                prepend_intchunklist(&chunklist, arr[i]);
+            }
+            bench_run("chunklist", "raw", 0, chunklist_raw, &chunklist, n);
+            bench_run("chunklist", "foreach", 0, chunklist_foreach, &chunklist, n);
+            bench_run("chunklist", "foreach_static", 0, chunklist_static, &chunklist, n);
+            bench_run("chunklist", "foreach_batch", 0, chunklist_batch, &chunklist, n);
+            free_intchunklist(&chunklist);
+        }
+
+        bench_run("range", "raw", 0, range_raw, NULL, n);
+        bench_run("range", "index_array", 0, range_index_array, NULL, n);
+        bench_run("range", "foreach", 0, range_foreach, NULL, n);
+        bench_run("range", "foreach_static", 0, range_static, NULL, n);
+        bench_run("range", "foreach_batch", 0, range_batch, NULL, n);
+        bench_run("range", "sum_intit", 0, range_sum_intit, NULL, n);
+
+        bench_run("fibonacci", "raw", 0, fib_raw, NULL, n);
+        bench_run("fibonacci", "foreach", 0, fib_foreach, NULL, n);
+        bench_run("fibonacci", "foreach_static", 0, fib_static, NULL, n);
+        bench_run("fibonacci", "foreach_batch", 0, fib_batch, NULL, n);
+    }
+
+    free(arr);
+}
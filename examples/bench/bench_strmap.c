@@ -0,0 +1,111 @@
+#include "../array_iterable.h"
+#include "../func_iter.h"
+#include "../iterutils/iterable_utils.h"
+#include "bench.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define STRMAP_VALSTR_SIZE 16 /* Enough for any int, sign and NUL terminator included */
+
+/* Values of every magnitude, positive and negative, in random order */
+static int* strmap_randarr(size_t n)
+{
+    int* const arr = malloc(n * sizeof(*arr));
+    if (arr == NULL) {
+        fprintf(stderr, "OOM in strmap_randarr");
+        exit(1);
+    }
+    uint32_t state = 2463534242u;
+    for (size_t i = 0; i < n; i++) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        arr[i] = (int)(state >> (state % 32));
+    }
+    return arr;
+}
+
+/* Convert an integer into a `malloc`ed string with `snprintf` */
+static string malloc_inttostr(int x)
+{
+    char* const xstr = malloc(STRMAP_VALSTR_SIZE);
+    if (xstr == NULL) {
+        fprintf(stderr, "OOM in malloc_inttostr");
+        exit(1);
+    }
+    snprintf(xstr, STRMAP_VALSTR_SIZE, "%d", x);
+    return xstr;
+}
+
+/* Convert an integer into a string allocated from the arena with `snprintf` */
+static StrView arena_snprintf_int(int x, IterArena* arena)
+{
+    char buf[STRMAP_VALSTR_SIZE];
+    int const len   = snprintf(buf, sizeof(buf), "%d", x);
+    char* const str = arena_alloc_bytes(arena, (size_t)len + 1);
+    memcpy(str, buf, (size_t)len + 1);
+    return (StrView){.ptr = str, .len = (size_t)len};
+}
+
+/* Map the array into `malloc`ed strings, freeing each one once its length has been summed */
+static int strmap_malloc(void const* ctx, size_t n)
+{
+    Iterable(string) it = map_over(arr_into_iter(ctx, n, int), malloc_inttostr, int, string);
+    size_t total        = 0;
+    foreach (string, s, it) {
+        total += strlen(s);
+        free(s);
+    }
+    return (int)total;
+}
+
+/* Map the array into strings formatted by `fmtfn` in an arena, released after every batch */
+static int strmap_arena(void const* ctx, size_t n, StrView (*fmtfn)(int x, IterArena* arena))
+{
+    IterArena arena      = new_arena(ITER_BATCH_SIZE * STRMAP_VALSTR_SIZE);
+    Iterable(StrView) it = map_into_arena(arr_into_iter(ctx, n, int), fmtfn, &arena, int);
+    size_t total         = 0;
+    foreach_batch (StrView, buf, len, it) {
+        for (size_t i = 0; i < len; i++) {
+            total += buf[i].len;
+        }
+        arena_reset(&arena);
+    }
+    free_arena(&arena);
+    return (int)total;
+}
+
+static int strmap_arena_snprintf(void const* ctx, size_t n) { return strmap_arena(ctx, n, arena_snprintf_int); }
+
+static int strmap_arena_fmt(void const* ctx, size_t n) { return strmap_arena(ctx, n, arena_fmt_int); }
+
+/* Format straight into a reused buffer, with no iterator - the floor for the formatting itself */
+static int strmap_raw_fmt(void const* ctx, size_t n)
+{
+    int const* const arr = ctx;
+    char buf[FMT_INT_MAX];
+    size_t total = 0;
+    for (size_t i = 0; i < n; i++) {
+        total += fmt_int(buf, arr[i]);
+    }
+    return (int)total;
+}
+
+void bench_strmap(void)
+{
+    size_t const maxn = bench_sizes[bench_nsizes - 1];
+    int* const arr    = strmap_randarr(maxn);
+
+    for (size_t s = 0; s < bench_nsizes && bench_sizes[s] <= bench_max_elements; s++) {
+        size_t const n = bench_sizes[s];
+        bench_run("strmap", "malloc_snprintf", 1, strmap_malloc, arr, n);
+        bench_run("strmap", "arena_snprintf", 1, strmap_arena_snprintf, arr, n);
+        bench_run("strmap", "arena_fmt", 1, strmap_arena_fmt, arr, n);
+        bench_run("strmap", "raw_fmt", 0, strmap_raw_fmt, arr, n);
+    }
+
+    free(arr);
+}
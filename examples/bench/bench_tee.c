@@ -0,0 +1,100 @@
+#include "../array_iterable.h"
+#include "../func_iter.h"
+#include "../iterutils/iterable_utils.h"
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct
+{
+    int const* arr;
+    int (*fn)(int x);
+} TeeCtx;
+
+static int incr(int x) { return x + 1; }
+
+/* A few dozen dependent multiplies - stands in for parsing, or formatting, an element */
+static int churn(int x)
+{
+    unsigned h = (unsigned)x;
+    for (int i = 0; i < 32; i++) {
+        h = h * 2654435761u + 1;
+    }
+    return (int)(h >> 24);
+}
+
+/* Sum the map, and take its max, by mapping over the array twice */
+static int tee_recompute(void const* ctx, size_t n)
+{
+    TeeCtx const* const tc = ctx;
+    Iterable(int) sumit    = map_over(arr_into_iter(tc->arr, n, int), tc->fn, int, int);
+    Iterable(int) maxit    = map_over(arr_into_iter(tc->arr, n, int), tc->fn, int, int);
+    return sum_intit(sumit) + from_just_(max_intit(maxit));
+}
+
+/* Sum the map, and take its max, through two cursors that take turns pulling a batch each */
+static int tee_lockstep(void const* ctx, size_t n)
+{
+    TeeCtx const* const tc = ctx;
+    Iterable(int) cursors[2];
+    tee(map_over(arr_into_iter(tc->arr, n, int), tc->fn, int, int), 2, cursors, int);
+    int sum = 0;
+    int max = 0;
+    int buf[ITER_BATCH_SIZE];
+    for (size_t len = iter_next_batch(cursors[0], buf, ITER_BATCH_SIZE, int); len != 0;
+         len        = iter_next_batch(cursors[0], buf, ITER_BATCH_SIZE, int)) {
+        for (size_t i = 0; i < len; i++) {
+            sum += buf[i];
+        }
+        size_t const maxlen = iter_next_batch(cursors[1], buf, len, int);
+        for (size_t i = 0; i < maxlen; i++) {
+            max = buf[i] > max ? buf[i] : max;
+        }
+    }
+    free_tee(cursors[0], int);
+    return sum + max;
+}
+
+/* Sum the map through one cursor, and then take its max through the other - which buffers the whole map */
+static int tee_sequential(void const* ctx, size_t n)
+{
+    TeeCtx const* const tc = ctx;
+    Iterable(int) cursors[2];
+    tee(map_over(arr_into_iter(tc->arr, n, int), tc->fn, int, int), 2, cursors, int);
+    int const res = sum_intit(cursors[0]) + from_just_(max_intit(cursors[1]));
+    free_tee(cursors[0], int);
+    return res;
+}
+
+/* Sum the map through a cache, and then take its max through a replay */
+static int tee_cache(void const* ctx, size_t n)
+{
+    TeeCtx const* const tc = ctx;
+    Iterable(int) it       = cache(map_over(arr_into_iter(tc->arr, n, int), tc->fn, int, int), int);
+    int const res          = sum_intit(it) + from_just_(max_intit(cache_replay(it, int)));
+    free_cache(it, int);
+    return res;
+}
+
+void bench_tee(void)
+{
+    size_t const maxn = bench_sizes[bench_nsizes - 1];
+    int* const arr    = bench_intarr(maxn);
+
+    for (size_t s = 0; s < bench_nsizes && bench_sizes[s] <= bench_max_elements; s++) {
+        size_t const n       = bench_sizes[s];
+        TeeCtx const light   = {.arr = arr, .fn = incr};
+        TeeCtx const heavy   = {.arr = arr, .fn = churn};
+        TeeCtx const* ctxs[] = {&light, &heavy};
+        char const* groups[] = {"tee_light", "tee_heavy"};
+        for (size_t c = 0; c < 2; c++) {
+            bench_run(groups[c], "recompute", 1, tee_recompute, ctxs[c], n);
+            bench_run(groups[c], "tee_lockstep", 1, tee_lockstep, ctxs[c], n);
+            bench_run(groups[c], "tee_sequential", 1, tee_sequential, ctxs[c], n);
+            bench_run(groups[c], "cache_replay", 1, tee_cache, ctxs[c], n);
+        }
+    }
+
+    free(arr);
+}
@@ -0,0 +1,36 @@
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+Usage: iterators_bench [max_elements]
+
+Prints one CSV row per measurement to stdout. Sizes above `max_elements` are skipped
+*/
+int main(int argc, char** argv)
+{
+    if (argc > 1) {
+        bench_max_elements = strtoul(argv[1], NULL, 10);
+    }
+    puts("group,benchmark,depth,elements,ns_per_element,elements_per_sec");
+    bench_sources();
+    bench_adapters();
+    bench_pipeline();
+    bench_reduce();
+    bench_lists();
+    bench_parallel();
+    bench_maybe();
+    bench_files();
+    bench_readahead();
+    bench_par_map();
+    bench_filter();
+    bench_tee();
+    bench_instrument();
+    bench_strmap();
+    bench_skip();
+    bench_collect();
+    bench_merge();
+    bench_group();
+    return 0;
+}
@@ -0,0 +1,30 @@
+#include "array_iterable.h"
+#include "chunklist_iterable.h"
+#include "examples.h"
+#include "func_iter.h"
+#include "iterutils/iterable_utils.h"
+
+#include <stdio.h>
+
+void test_chunklist(void)
+{
+    /* Enough elements to fill more than one chunk */
+    int arr[100];
+    for (int i = 0; i < 100; i++) {
+        arr[i] = i + 1;
+    }
+    Iterable(int) arrit = arr_into_iter(arr, sizeof(arr) / sizeof(*arr), int);
+
+    /* Build an unrolled list out of the iterable, then add an element at both ends */
+    IntChunkList list = intchunklist_from_intit(arrit);
+    prepend_intchunklist(&list, 0);
+    append_intchunklist(&list, 101);
+
+    /* Turn the list into an iterable */
+    Iterable(int) listit = chunklist_into_iter(list);
+    int const sumlist    = sum_intit(listit);
+    printf("Sum of %zu chunk list values: %d\n", list.len, sumlist);
+
+    /* Free the list */
+    free_intchunklist(&list);
+}
@@ -0,0 +1,133 @@
+#include "chunklist_iterable.h"
+
+#include "func_iter.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Create an empty IntChunk, whose elements will start at `start` */
+static IntChunk* create_intchunk(uint32_t start)
+{
+    IntChunk* chunk = malloc(sizeof(*chunk));
+    if (chunk == NULL) {
+        fprintf(stderr, "OOM in create_intchunk");
+        exit(1);
+    }
+    chunk->next  = NULL;
+    chunk->start = start;
+    chunk->len   = 0;
+    return chunk;
+}
+
+/* Chain a new chunk, filled from the front, onto the tail of the list */
+static IntChunk* push_tail_chunk(IntChunkList* list)
+{
+    IntChunk* const chunk = create_intchunk(0);
+    if (list->tail == NULL) {
+        list->head = chunk;
+    } else {
+        list->tail->next = chunk;
+    }
+    list->tail = chunk;
+    return chunk;
+}
+
+void prepend_intchunklist(IntChunkList* list, int val)
+{
+    IntChunk* chunk = list->head;
+    if (chunk == NULL || chunk->start == 0) {
+        /* The head chunk is full at the front - put a new one, filled from the back, in front of it */
+        chunk       = create_intchunk(INT_CHUNK_LEN);
+        chunk->next = list->head;
+        list->head  = chunk;
+        if (list->tail == NULL) {
+            list->tail = chunk;
+        }
+    }
+    chunk->vals[--chunk->start] = val;
+    chunk->len++;
+    list->len++;
+}
+
+void append_intchunklist(IntChunkList* list, int val)
+{
+    IntChunk* chunk = list->tail;
+    if (chunk == NULL || chunk->start + chunk->len == INT_CHUNK_LEN) {
+        chunk = push_tail_chunk(list);
+    }
+    chunk->vals[chunk->start + chunk->len++] = val;
+    list->len++;
+}
+
+IntChunkList intchunklist_from_intit(Iterable(int) it)
+{
+    IntChunkList list = {0};
+    IntChunk* prev    = NULL; /* The chunk before the tail */
+    while (1) {
+        IntChunk* chunk = list.tail;
+        if (chunk == NULL || chunk->start + chunk->len == INT_CHUNK_LEN) {
+            prev  = chunk;
+            chunk = push_tail_chunk(&list);
+        }
+        /* Pull elements straight into the free space at the back of the tail chunk */
+        uint32_t const end = chunk->start + chunk->len;
+        size_t const n     = iter_next_batch(it, chunk->vals + end, INT_CHUNK_LEN - end, int);
+        if (n == 0) {
+            break;
+        }
+        chunk->len += (uint32_t)n;
+        list.len += n;
+    }
+    /* Drop the tail chunk if it was chained on for nothing */
+    if (list.tail->len == 0) {
+        free(list.tail);
+        list.tail = prev;
+        if (prev == NULL) {
+            list.head = NULL;
+        } else {
+            prev->next = NULL;
+        }
+    }
+    return list;
+}
+
+void free_intchunklist(IntChunkList* list)
+{
+    IntChunk* chunk = list->head;
+    while (chunk != NULL) {
+        IntChunk* const next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    *list = (IntChunkList){0};
+}
+
+/* `next_batch` implementation for `IntChunkListIter` - copy out whole runs of a chunk at a time */
+static size_t intchunklistbatch(IntChunkListIter* self, int* out, size_t cap)
+{
+    size_t n = 0;
+    while (n < cap) {
+        if (self->curr == self->end && !intchunklist_advance(self)) {
+            break;
+        }
+        size_t const avail = (size_t)(self->end - self->curr);
+        size_t const len   = cap - n < avail ? cap - n : avail;
+        memcpy(out + n, self->curr, len * sizeof(*out));
+        self->curr += len;
+        n += len;
+    }
+    self->left -= n;
+    return n;
+}
+
+/* `size_hint` implementation for `IntChunkListIter` - the list knows its length */
+static SizeHint intchunklisthint(IntChunkListIter* self) { return size_hint_exact(self->left); }
+
+// clang-format off
+impl_next_batch(IntChunkListIter*, int, intchunklistbatch)
+impl_size_hint(IntChunkListIter*, intchunklisthint)
+
+/* Implement `Iterator` for `IntChunkListIter*` */
+impl_iterator_with(IntChunkListIter*, int, prep_intchunklist_itr, intchunklistnxt,
+    iter_slot(next_batch, intchunklistbatch), iter_slot(size_hint, intchunklisthint))
@@ -0,0 +1,115 @@
+#ifndef IT_CHUNKLIST_ITRBLE_H
+#define IT_CHUNKLIST_ITRBLE_H
+
+#include "func_iter.h"
+#include "iterutils/arena.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/* Number of ints stored in each chunk - 60 makes a chunk 256 bytes (4 cache lines) on 64 bit targets */
+#ifndef INT_CHUNK_LEN
+#define INT_CHUNK_LEN 60
+#endif
+
+/* Hint the CPU to start loading the cache line at `p`, no-op on compilers without `__builtin_prefetch` */
+#ifdef __GNUC__
+#define chunk_prefetch(p) __builtin_prefetch(p)
+#else
+#define chunk_prefetch(p) ((void)(p))
+#endif
+
+/*
+An unrolled linked list node - holds up to `INT_CHUNK_LEN` ints, in `vals[start]` to `vals[start + len - 1]`
+
+Prepending fills the head chunk from the back, appending fills the tail chunk from the front - so neither has to move
+the existing elements around
+*/
+typedef struct int_chunk
+{
+    struct int_chunk* next;
+    uint32_t start;
+    uint32_t len;
+    int vals[INT_CHUNK_LEN];
+} IntChunk;
+
+/* An unrolled linked list of ints - an empty list is `{0}` */
+typedef struct
+{
+    IntChunk* head;
+    IntChunk* tail;
+    size_t len;
+} IntChunkList;
+
+/* Iterator over an `IntChunkList`, `curr` and `end` delimit the elements left in the current chunk */
+typedef struct
+{
+    IntChunk const* next;
+    int const* curr;
+    int const* end;
+    size_t left;
+} IntChunkListIter;
+
+/* Build an `Iterable(int)` from given `IntChunkList` */
+#define chunklist_into_iter(list)                                                                                      \
+    prep_intchunklist_itr(&(IntChunkListIter){.next = (list).head, .curr = NULL, .end = NULL, .left = (list).len})
+
+/* Same as `chunklist_into_iter`, but the `IntChunkListIter` is stored in given `IterArena*` */
+#define arena_chunklist_into_iter(arena, list)                                                                         \
+    prep_intchunklist_itr(                                                                                             \
+        arena_new(arena, IntChunkListIter, .next = (list).head, .curr = NULL, .end = NULL, .left = (list).len))
+
+/* Prepend an int to given IntChunkList */
+void prepend_intchunklist(IntChunkList* list, int val);
+/* Append an int to given IntChunkList */
+void append_intchunklist(IntChunkList* list, int val);
+/* Build an IntChunkList, in the same order, from any iterable yielding int */
+IntChunkList intchunklist_from_intit(Iterable(int) it);
+/* Free the given IntChunkList, leaving it empty */
+void free_intchunklist(IntChunkList* list);
+
+/*
+Move the iterator on to the next chunk, returns false if there's none left
+
+The chunk after it is prefetched, so it's (hopefully) in cache by the time the current one is done
+*/
+static inline bool intchunklist_advance(IntChunkListIter* self)
+{
+    IntChunk const* const chunk = self->next;
+    if (chunk == NULL) {
+        return false;
+    }
+    self->curr = chunk->vals + chunk->start;
+    self->end  = self->curr + chunk->len;
+    self->next = chunk->next;
+    if (self->next != NULL) {
+        chunk_prefetch(self->next);
+    }
+    return true;
+}
+
+/*
+`next` implementation for `IntChunkListIter`
+
+Defined here, rather than in the source file, so that `foreach_static` can call it directly
+*/
+static inline Maybe(int) intchunklistnxt(IntChunkListIter* self)
+{
+    while (self->curr == self->end) {
+        if (!intchunklist_advance(self)) {
+            return Nothing(int);
+        }
+    }
+    self->left--;
+    return Just(*self->curr++, int);
+}
+
+// clang-format off
+/* Define the statically dispatched `next` function, `static_next(IntChunkListIter)` */
+impl_static_next(IntChunkListIter, int, intchunklistnxt)
+// clang-format on
+
+/* Convert a pointer to an `IntChunkListIter` to an `Iterable(int)` */
+Iterable(int) prep_intchunklist_itr(IntChunkListIter* x);
+
+#endif /* !IT_CHUNKLIST_ITRBLE_H */
@@ -0,0 +1,37 @@
+#include "array_iterable.h"
+#include "examples.h"
+#include "func_iter.h"
+#include "iterutils/iterable_utils.h"
+#include "range_iterable.h"
+
+#include <stdio.h>
+
+static int square(int x) { return x * x; }
+
+static bool is_odd(int x) { return x % 2 != 0; }
+
+void test_collect(void)
+{
+    /* A map over a range knows exactly how many elements it has, so it's collected into one allocation of that size */
+    Vec(int) const squares = collect_vec(map_over(range_into_iter(1, 11, 1, int), square, int, int), int);
+    /* The checkpoint turns back into an array iterable, to be scanned as many times as need be */
+    int const sum = sum_intit(arr_into_iter(squares.data, squares.len, int));
+    int const max = from_just_(max_intit(arr_into_iter(squares.data, squares.len, int)));
+    printf("%zu elements, capacity %zu - sum %d, max %d\n", squares.len, squares.cap, sum, max);
+    free_vec(squares);
+
+    /* Collecting into a buffer stops once it's full, leaving the rest of the elements in the iterable */
+    int buf[4];
+    Iterable(int) oddsit = filter_over(range_into_iter(0, 20, 1, int), is_odd, int);
+    size_t const n       = collect_into(oddsit, buf, sizeof(buf) / sizeof(*buf), int);
+    for (size_t i = 0; i < n; i++) {
+        printf("%d ", buf[i]);
+    }
+    printf("- %d\n", sum_intit(oddsit));
+
+    /* Array backed iterables are copied over in one go */
+    string words[]       = {"collected", "in", "one", "copy"};
+    Vec(string) const vw = collect_vec(arr_into_iter(words, sizeof(words) / sizeof(*words), string), string);
+    print_strit(arr_into_iter(vw.data, vw.len, string));
+    free_vec(vw);
+}
@@ -0,0 +1,46 @@
+#include "array_iterable.h"
+#include "examples.h"
+#include "func_iter.h"
+#include "iterutils/iterable_utils.h"
+#include "range_iterable.h"
+
+#include <stdio.h>
+
+static string word(string s) { return s; }
+
+static int mod3(int x) { return x % 3; }
+
+void test_group(void)
+{
+    /* Each element once, in the order they first came in - in a single pass */
+    int const nums[]    = {3, 1, 3, 2, 1, 5, 2};
+    Iterable(int) uniqs = distinct(arr_into_iter(nums, sizeof(nums) / sizeof(*nums), int), int);
+    foreach (int, x, uniqs) {
+        printf("%d ", x);
+    }
+    puts("");
+    free_distinct(uniqs, int);
+
+    /* Words are counted by their contents, the counts come out in the order the words were first seen */
+    string words[]         = {"the", "cat", "and", "the", "hat", "and", "the"};
+    Iterable(string) wordit = arr_into_iter(words, sizeof(words) / sizeof(*words), string);
+    Counts(string) counts   = count_by(wordit, word, string, string);
+    for (size_t i = 0; i < counts.len; i++) {
+        printf("%s %zu, ", counts.keys[i], counts.counts[i]);
+    }
+    printf("bat %zu\n", count_of(counts, "bat", string));
+    free_counts(counts);
+
+    /* The elements of each group are next to each other, in the order they came in */
+    Groups(int, int) groups = group_by(range_into_iter(1, 11, 1, int), mod3, int, int);
+    for (size_t g = 0; g < groups.len; g++) {
+        size_t const len      = groups.starts[g + 1] - groups.starts[g];
+        Iterable(int) groupit = arr_into_iter(groups.elems + groups.starts[g], len, int);
+        printf("%d -", groups.keys[g]);
+        foreach (int, x, groupit) {
+            printf(" %d", x);
+        }
+        fputs(g + 1 < groups.len ? ", " : "\n", stdout);
+    }
+    free_groups(groups);
+}
@@ -12,10 +12,48 @@ void test_list(void);
 void test_fibonacci(void);
 /* Turn an array into an iterator and use it to build a list */
 void test_list_from_arr(void);
+/* Turn an array into an iterator and use it to build a list, whose nodes come from a pool */
+void test_pooled_list_from_arr(void);
+/* Use the vectorized reduction sinks on an array and a list */
+void test_reduce(void);
 /* Test mapping functions over iterator instance */
 void test_mapping(void);
+/* Test a fused take -> filter -> map pipeline over iterator instance */
+void test_pipeline(void);
+/* Return an iterable, whose state is stored in an arena, from a function and use it */
+void test_arena(void);
+/* Sum arrays, ranges and maps over them on multiple threads, and compare against the sequential sum */
+void test_par_sum(void);
+/* Build an unrolled list from an array, add elements at both ends and sum it */
+void test_chunklist(void);
+/* Map temporary files into memory, and iterate through their lines and fixed-width records */
+void test_mmap_file(void);
+/* Iterate through the lines and fixed-width records read from pipes, through small buffers */
+void test_fd_lines(void);
+/* Sum a map over a range read ahead on a background thread, and stop another one early */
+void test_readahead(void);
+/* Map functions over a range and the fibonacci sequence on multiple threads, and compare against the sequential map */
+void test_par_map(void);
+/* Sum, slice and count int ranges in closed form, and step through an unsigned one */
+void test_range(void);
+/* Filter an array, a range and the fibonacci sequence, one element at a time and in batches */
+void test_filter(void);
+/* Consume an expensive map through several cursors and a cache, evaluating it only once */
+void test_tee(void);
+/* Time the stages of a take and map chain, and dump their statistics to stderr */
+void test_instrument(void);
+/* Skip into an array, the fibonacci sequence, a map and a filter - in O(1), O(log n) and by calling next */
+void test_skip(void);
+/* Collect a map into an array and scan it twice, a filter into a buffer, and strings into an array */
+void test_collect(void);
+/* Merge sorted int shards keeping every element and each distinct one once, and sorted lines of text */
+void test_merge(void);
+/* Deduplicate ints, count words and group ints by their remainder, in a hash table */
+void test_group(void);
 
 /* Generic function to create a reversed IntList from any iterable yielding int */
 IntList revlist_from_intit(Iterable(int) it);
+/* Same as `revlist_from_intit`, but the list's nodes are allocated from given pool */
+IntList pool_revlist_from_intit(IntNodePool* pool, Iterable(int) it);
 
 #endif /* !IT_EXAMPLES_H */
@@ -0,0 +1,133 @@
+#define _POSIX_C_SOURCE 200809L /* For `ssize_t` */
+
+#include "fd_iterable.h"
+
+#include "func_iter.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+FdBuffer new_fdbuffer(int fd, size_t bufsize)
+{
+    char* const buf0 = malloc(bufsize);
+    char* const buf1 = malloc(bufsize);
+    if (buf0 == NULL || buf1 == NULL) {
+        fprintf(stderr, "OOM in new_fdbuffer");
+        exit(1);
+    }
+    return (FdBuffer){.fd = fd, .bufs = {buf0, buf1}, .caps = {bufsize, bufsize}, .curr = buf0, .end = buf0};
+}
+
+void free_fdbuffer(FdBuffer* buf)
+{
+    free(buf->bufs[0]);
+    free(buf->bufs[1]);
+    *buf = (FdBuffer){.fd = buf->fd};
+}
+
+/* Replace the buffer at index `i` with one of `size` chars, keeping its contents if `keep` is set - exits on OOM */
+static void fdbuffer_resize(FdBuffer* buf, unsigned i, size_t size, bool keep)
+{
+    char* mem;
+    if (keep) {
+        mem = realloc(buf->bufs[i], size);
+    } else {
+        free(buf->bufs[i]);
+        mem = malloc(size);
+    }
+    if (mem == NULL) {
+        fprintf(stderr, "OOM in fdbuffer_refill");
+        exit(1);
+    }
+    buf->bufs[i] = mem;
+    buf->caps[i] = size;
+}
+
+bool fdbuffer_refill(FdBuffer* buf)
+{
+    if (buf->eof) {
+        return false;
+    }
+    size_t const left = (size_t)(buf->end - buf->curr);
+    if (buf->curr != buf->bufs[buf->active]) {
+        /*
+        Chars were handed out of the active buffer - carry the rest over to the other one, so the last record handed out
+        stays intact. The other buffer only holds records from before that
+        */
+        unsigned const other = buf->active ^ 1u;
+        if (buf->caps[other] < buf->caps[buf->active]) {
+            fdbuffer_resize(buf, other, buf->caps[buf->active], false);
+        }
+        memcpy(buf->bufs[other], buf->curr, left);
+        buf->active = other;
+    } else if (left == buf->caps[buf->active]) {
+        /* A single record fills the whole buffer, nothing before it is in there - grow it in place */
+        fdbuffer_resize(buf, buf->active, buf->caps[buf->active] * 2, true);
+    }
+    buf->curr = buf->bufs[buf->active];
+    buf->end  = buf->curr + left;
+
+    ssize_t n;
+    do {
+        n = read(buf->fd, buf->end, buf->caps[buf->active] - left);
+        buf->syscalls++;
+    } while (n == -1 && errno == EINTR);
+    if (n <= 0) {
+        buf->eof   = true;
+        buf->error = n == 0 ? 0 : errno;
+        return false;
+    }
+    buf->bytes_read += (size_t)n;
+    buf->end += n;
+    return true;
+}
+
+/* `next` implementation for `FdLineIter` */
+static Maybe(StrView) fdlineiternxt(FdLineIter* self)
+{
+    FdBuffer* const buf = self->src;
+    /* Chars already searched for a '\n', so a refill doesn't search them again */
+    size_t searched = 0;
+    while (1) {
+        char* const start = buf->curr;
+        char* const nl    = memchr(start + searched, '\n', (size_t)(buf->end - start) - searched);
+        if (nl != NULL) {
+            buf->curr = nl + 1;
+            return Just(((StrView){.ptr = start, .len = (size_t)(nl - start)}), StrView);
+        }
+        searched = (size_t)(buf->end - start);
+        if (!fdbuffer_refill(buf)) {
+            /* The last line doesn't need to end with a '\n' */
+            if (buf->curr == buf->end) {
+                return Nothing(StrView);
+            }
+            StrView const line = {.ptr = buf->curr, .len = (size_t)(buf->end - buf->curr)};
+            buf->curr          = buf->end;
+            return Just(line, StrView);
+        }
+    }
+}
+
+/* `next` implementation for `FdRecordIter` */
+static Maybe(StrView) fdrecorditernxt(FdRecordIter* self)
+{
+    FdBuffer* const buf = self->src;
+    while ((size_t)(buf->end - buf->curr) < self->width) {
+        if (!fdbuffer_refill(buf)) {
+            return Nothing(StrView);
+        }
+    }
+    char* const start = buf->curr;
+    buf->curr += self->width;
+    return Just(((StrView){.ptr = start, .len = self->width}), StrView);
+}
+
+// clang-format off
+/* Implement `Iterator` for `FdLineIter*` */
+impl_iterator(FdLineIter*, StrView, prep_fdlineiter_itr, fdlineiternxt)
+
+/* Implement `Iterator` for `FdRecordIter*` */
+impl_iterator(FdRecordIter*, StrView, prep_fdrecorditer_itr, fdrecorditernxt)
@@ -0,0 +1,98 @@
+#ifndef IT_FD_ITRBLE_H
+#define IT_FD_ITRBLE_H
+
+#include "func_iter.h"
+#include "iterutils/arena.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Default size of each of the two buffers of an `FdBuffer`, in bytes */
+#ifndef FD_BUFFER_SIZE
+#define FD_BUFFER_SIZE (1u << 18)
+#endif
+
+/*
+Buffered reader over a file descriptor - anything `read` works on, including pipes, sockets and stdin
+
+Chars are read into one of two buffers, in as large a `read` as fits. When a record runs off the end of the buffer,
+its start is copied to the front of the other buffer and the rest read in after it - so records spanning a refill are
+handed out whole, and the record before it (in the old buffer) is left intact. A buffer doubles in size if a single
+record doesn't fit in it
+
+`bytes_read` and `syscalls` count the chars read, and the `read` calls made, so far. `error` holds the `errno` of a
+failed `read` (which ends the iteration like end of file does), 0 otherwise
+*/
+typedef struct
+{
+    int fd;
+    char* bufs[2];
+    size_t caps[2];  /* Sizes of the two buffers */
+    unsigned active; /* Index of the buffer `curr` and `end` point into */
+    char* curr;      /* Start of the chars that haven't been handed out yet */
+    char* end;       /* End of the chars read into the active buffer */
+    bool eof;
+    int error;
+    size_t bytes_read;
+    size_t syscalls;
+} FdBuffer;
+
+/* Iterator over the lines read from an `FdBuffer`, each line is yielded without its `'\n'` */
+typedef struct
+{
+    FdBuffer* const src;
+} FdLineIter;
+
+/* Iterator over the records of `width` chars read from an `FdBuffer`, a partial record at the end is not yielded */
+typedef struct
+{
+    FdBuffer* const src;
+    size_t const width;
+} FdRecordIter;
+
+/*
+Create an `FdBuffer` reading from `fd`, with two buffers of `bufsize` chars (pass `FD_BUFFER_SIZE` for the default)
+
+Exits on OOM. `fd` is not closed by `free_fdbuffer`
+*/
+FdBuffer new_fdbuffer(int fd, size_t bufsize);
+
+/* Free the buffers of given `FdBuffer`, the views handed out by iterables over it are invalid from then on */
+void free_fdbuffer(FdBuffer* buf);
+
+/*
+Move the chars not handed out yet to the front of a buffer and `read` more after them
+
+Returns `false` once there's nothing left to read (or on error), with the chars not handed out yet left in place
+*/
+bool fdbuffer_refill(FdBuffer* buf);
+
+/*
+Build an `Iterable(StrView)` of the lines read from given `FdBuffer*`
+
+Each line is a `StrView` into the buffers - it stays valid through one more call to `next`, so consecutive lines can
+be compared without copying them
+*/
+#define fd_lines_into_iter(fdbuf) prep_fdlineiter_itr(&(FdLineIter){.src = (fdbuf)})
+
+/* Same as `fd_lines_into_iter`, but the `FdLineIter` is stored in given `IterArena*` - so it can outlive the scope */
+#define arena_fd_lines_into_iter(arena, fdbuf) prep_fdlineiter_itr(arena_new(arena, FdLineIter, .src = (fdbuf)))
+
+/*
+Build an `Iterable(StrView)` of the records of `recsize` chars read from given `FdBuffer*`
+
+Each record is a `StrView` into the buffers, it stays valid through one more call to `next`. `recsize` must not be 0
+*/
+#define fd_records_into_iter(fdbuf, recsize)                                                                           \
+    prep_fdrecorditer_itr(&(FdRecordIter){.src = (fdbuf), .width = (recsize)})
+
+/* Same as `fd_records_into_iter`, but the `FdRecordIter` is stored in given `IterArena*` */
+#define arena_fd_records_into_iter(arena, fdbuf, recsize)                                                              \
+    prep_fdrecorditer_itr(arena_new(arena, FdRecordIter, .src = (fdbuf), .width = (recsize)))
+
+/* Convert a pointer to an `FdLineIter` to an `Iterable(StrView)` */
+Iterable(StrView) prep_fdlineiter_itr(FdLineIter* x);
+/* Convert a pointer to an `FdRecordIter` to an `Iterable(StrView)` */
+Iterable(StrView) prep_fdrecorditer_itr(FdRecordIter* x);
+
+#endif /* !IT_FD_ITRBLE_H */
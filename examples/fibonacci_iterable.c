@@ -2,17 +2,46 @@
 
 #include "func_iter.h"
 
+#include <limits.h>
 #include <stdlib.h>
 
-/* `next` implementation for the `Fibonacci` struct */
-static Maybe(uint32_t) fibnxt(Fibonacci* self)
+/* `size_hint` implementation for the `Fibonacci` struct - the sequence never ends */
+static SizeHint fibhint(Fibonacci* self)
 {
-    uint32_t new_nxt = self->curr + self->next;
-    self->curr       = self->next;
-    self->next       = new_nxt;
-    return Just(new_nxt, uint32_t);
+    (void)self;
+    return size_hint_infinite();
+}
+
+/*
+`advance_by` implementation for the `Fibonacci` struct - in O(log n) rather than `n` calls to `fibnxt`
+
+Skipping `n` elements moves the state from (F(k), F(k + 1)) to (F(k + n), F(k + n + 1)) - which is the state times the
+n-th power of the fibonacci matrix, whose entries are F(n - 1), F(n) and F(n + 1). Those are built up one bit of `n` at
+a time, from the most significant one, with the doubling identities F(2m) = F(m) * (2 * F(m + 1) - F(m)) and
+F(2m + 1) = F(m)^2 + F(m + 1)^2. Everything wraps around on overflow - just like `fibnxt` does
+*/
+static size_t fibadvance(Fibonacci* self, size_t n)
+{
+    /* F(m) and F(m + 1), `m` being the bits of `n` gone through so far */
+    uint32_t fm  = 0;
+    uint32_t fm1 = 1;
+    for (size_t bit = sizeof(n) * CHAR_BIT; bit-- > 0;) {
+        uint32_t const f2m  = fm * (2 * fm1 - fm);
+        uint32_t const f2m1 = fm * fm + fm1 * fm1;
+        fm                  = (n >> bit) & 1 ? f2m1 : f2m;
+        fm1                 = (n >> bit) & 1 ? f2m + f2m1 : f2m1;
+    }
+    uint32_t const curr = (fm1 - fm) * self->curr + fm * self->next;
+    self->next          = fm * self->curr + fm1 * self->next;
+    self->curr          = curr;
+    return n;
 }
 
 // clang-format off
+impl_default_next_batch(Fibonacci*, uint32_t, fibnxt)
+impl_size_hint(Fibonacci*, fibhint)
+impl_advance_by(Fibonacci*, fibadvance)
+
 /* Implement `Iterator` for `Fibonacci*` */
-impl_iterator(Fibonacci*, uint32_t, prep_fib_itr, fibnxt)
+impl_iterator_with(Fibonacci*, uint32_t, prep_fib_itr, fibnxt,
+    iter_default_batch(fibnxt), iter_slot(size_hint, fibhint), iter_slot(advance_by, fibadvance))
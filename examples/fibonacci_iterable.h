@@ -14,6 +14,24 @@ typedef struct fibonacci
 /* Create an infinite `Iterable` representing the fibonacci sequence */
 #define get_fibitr() prep_fib_itr(&(Fibonacci){.curr = 0, .next = 1})
 
+/*
+`next` implementation for the `Fibonacci` struct
+
+Defined here, rather than in the source file, so that `foreach_static` can call it directly
+*/
+static inline Maybe(uint32_t) fibnxt(Fibonacci* self)
+{
+    uint32_t new_nxt = self->curr + self->next;
+    self->curr       = self->next;
+    self->next       = new_nxt;
+    return Just(new_nxt, uint32_t);
+}
+
+// clang-format off
+/* Define the statically dispatched `next` function, `static_next(Fibonacci)` */
+impl_static_next(Fibonacci, uint32_t, fibnxt)
+// clang-format on
+
 /* Turn a pointer to a `Fibonacci` struct to an iterable */
 Iterable(uint32_t) prep_fib_itr(Fibonacci* self);
 
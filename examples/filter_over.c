@@ -0,0 +1,41 @@
+#include "array_iterable.h"
+#include "examples.h"
+#include "fibonacci_iterable.h"
+#include "func_iter.h"
+#include "iterutils/iterable_utils.h"
+#include "range_iterable.h"
+
+#include <stdio.h>
+
+static bool is_odd(int x) { return x % 2 != 0; }
+
+static bool is_multiple_of_7(int x) { return x % 7 == 0; }
+
+static bool is_even(uint32_t x) { return x % 2 == 0; }
+
+void test_filter(void)
+{
+    int const arr[]  = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    Iterable(int) it = filter_over(arr_into_iter(arr, sizeof(arr) / sizeof(*arr), int), is_odd, int);
+    foreach (int, x, it) {
+        printf("%d ", x);
+    }
+    puts("");
+
+    /* The sink pulls batches, which are compacted without a branch per element - the loop pulls one at a time */
+    Iterable(int) sumit  = filter_over(range_into_iter(0, 100000, 1, int), is_multiple_of_7, int);
+    Iterable(int) loopit = filter_over(range_into_iter(0, 100000, 1, int), is_multiple_of_7, int);
+    int loopsum          = 0;
+    foreach (int, x, loopit) {
+        loopsum += x;
+    }
+    printf("%d == %d\n", sum_intit(sumit), loopsum);
+
+    /* Filtering an infinite iterable is just as lazy - only as much of it is pulled as is taken */
+    Iterable(uint32_t) evenfibs = filter_over(get_fibitr(), is_even, uint32_t);
+    Iterable(uint32_t) firstit  = take_from(evenfibs, 6, uint32_t);
+    foreach (uint32_t, x, firstit) {
+        printf("%u ", x);
+    }
+    puts("");
+}
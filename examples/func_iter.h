@@ -4,6 +4,7 @@
 #include "iterator.h"
 #include "maybe.h"
 
+#include <stddef.h>
 #include <stdint.h>
 
 #define CONCAT_(A, B) A##B
@@ -11,15 +12,25 @@
 
 typedef char* string;
 
+/* A non-owning view into a run of `len` chars - unlike `string`, it is not NUL terminated */
+typedef struct
+{
+    char const* ptr;
+    size_t len;
+} StrView;
+
 // clang-format off
 /* Define the necessary `Maybe(T)` and `Iterator(T)` structs */
 DefineMaybe(int)
-DefineMaybe(string)
 DefineMaybe(uint32_t)
+/* `NULL` is never a valid string, so it can stand for `Nothing` - keeping `Maybe(string)` as small as a `char*` */
+DefineMaybeNiche(string, NULL)
+DefineMaybe(StrView)
 
 DefineIteratorOf(int);
 DefineIteratorOf(string);
 DefineIteratorOf(uint32_t);
+DefineIteratorOf(StrView);
 // clang-format on
 
 #endif /* !FUNC_ITER_H */
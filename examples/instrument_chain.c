@@ -0,0 +1,37 @@
+#include "array_iterable.h"
+#include "examples.h"
+#include "func_iter.h"
+#include "iterutils/iterable_utils.h"
+#include "range_iterable.h"
+
+#include <stdio.h>
+
+/* Square a number - a few loops in place of parsing, so it stands out in the statistics */
+static int slow_square(int x)
+{
+    int res = 0;
+    for (int i = 0; i < x; i++) {
+        res += x;
+    }
+    return res;
+}
+
+void test_instrument(void)
+{
+    /* Every stage is timed, the map's time includes the time spent in the take (and the range before it) */
+    Iterable(int) takeit = instrument(take_from(range_into_iter(1, 1000, 1, int), 10, int), "take", int);
+    Iterable(int) it     = instrument(map_over(takeit, slow_square, int, int), "map", int);
+    foreach (int, x, it) {
+        printf("%d ", x);
+    }
+    puts("");
+
+    /* Sinks pull batches through the stages instead - each batch is one call */
+    int const arr[]       = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    Iterable(int) arrit   = instrument(arr_into_iter(arr, sizeof(arr) / sizeof(*arr), int), "array", int);
+    Iterable(int) squares = instrument(map_over(arrit, slow_square, int, int), "map", int);
+    printf("%d\n", sum_intit(squares));
+
+    /* The statistics go to stderr, they're different on every run */
+    iter_stats_dump(stderr);
+}
@@ -0,0 +1,89 @@
+#include "arena.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* A type with the strictest alignment requirement of the usual suspects, everything is aligned to its size */
+typedef union
+{
+    long double ld;
+    long long ll;
+    void* ptr;
+    void (*fnptr)(void);
+} MaxAlign;
+
+#define ARENA_ALIGN sizeof(MaxAlign)
+
+/* Every block starts with its capacity and the block that was chained before it, padded to `ARENA_ALIGN` */
+typedef union
+{
+    struct
+    {
+        unsigned char* prev;
+        size_t cap;
+    } info;
+    MaxAlign align[2];
+} ArenaBlockHeader;
+
+/* Allocate a block with room for `cap` bytes after its header, chained onto `prev` */
+static unsigned char* new_block(unsigned char* prev, size_t cap)
+{
+    unsigned char* const mem = malloc(sizeof(ArenaBlockHeader) + cap);
+    if (mem == NULL) {
+        fprintf(stderr, "OOM in new_block");
+        exit(1);
+    }
+    ((ArenaBlockHeader*)mem)->info.prev = prev;
+    ((ArenaBlockHeader*)mem)->info.cap  = cap;
+    return mem;
+}
+
+static unsigned char* block_prev(unsigned char* block) { return ((ArenaBlockHeader*)block)->info.prev; }
+
+IterArena new_arena(size_t cap) { return (IterArena){.mem = new_block(NULL, cap), .cap = cap, .used = 0}; }
+
+/* Allocate `size` bytes from the arena, starting at offset `start` of the current block if they fit */
+static void* arena_alloc_at(IterArena* arena, size_t start, size_t size)
+{
+    if (start > arena->cap || size > arena->cap - start) {
+        /* Out of space - chain a new block, at least as big as the current one */
+        size_t const cap = size > arena->cap ? size : arena->cap;
+        arena->mem       = new_block(arena->mem, cap);
+        arena->cap       = cap;
+        start            = 0;
+    }
+    arena->used = start + size;
+    return arena->mem + sizeof(ArenaBlockHeader) + start;
+}
+
+void* arena_alloc(IterArena* arena, size_t size)
+{
+    return arena_alloc_at(arena, (arena->used + ARENA_ALIGN - 1) / ARENA_ALIGN * ARENA_ALIGN, size);
+}
+
+void* arena_alloc_bytes(IterArena* arena, size_t size) { return arena_alloc_at(arena, arena->used, size); }
+
+void* arena_dup(IterArena* arena, void const* src, size_t size) { return memcpy(arena_alloc(arena, size), src, size); }
+
+void arena_reset(IterArena* arena)
+{
+    /* Keep the first block, it's the only one with the capacity the arena was created with */
+    while (block_prev(arena->mem) != NULL) {
+        unsigned char* const prev = block_prev(arena->mem);
+        free(arena->mem);
+        arena->mem = prev;
+    }
+    arena->cap  = ((ArenaBlockHeader*)arena->mem)->info.cap;
+    arena->used = 0;
+}
+
+void free_arena(IterArena* arena)
+{
+    arena_reset(arena);
+    free(arena->mem);
+    *arena = (IterArena){0};
+}
+
+// clang-format off
+impl_alloc(IterArena*, arena_allocator, arena_alloc)
@@ -0,0 +1,53 @@
+#ifndef IT_ARENA_H
+#define IT_ARENA_H
+
+#include "../func_iter.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/*
+A bump allocator to store the state of iterables (`ArrIter`, `IterTake`, `IterMap` etc.) in.
+
+The macros that build iterables (`take_from`, `map_over`, `arr_into_iter` ...) store that state in compound literals,
+whose lifetime ends with the enclosing scope - so the built iterables can't be returned from a function. Their
+`arena_` counterparts (`arena_take_from`, `arena_map_over`, `arena_arr_into_iter` ...) store it in an `IterArena`
+instead - which lives as long as the caller wants it to.
+
+All the state of a chain of adapters ends up next to each other in one contiguous block, and the whole arena is
+released at once. When a block runs out of space, a new one (of the same size, or bigger if need be) is chained onto
+it - so releasing the arena is O(blocks), not O(allocations).
+
+The arena can also be passed around as an `Allocator`, e.g to `iter_split`.
+*/
+
+typedef struct
+{
+    unsigned char* mem;
+    size_t cap;
+    size_t used;
+} IterArena;
+
+/* Create an arena whose blocks hold `cap` bytes */
+IterArena new_arena(size_t cap);
+/* Allocate `size` bytes (suitably aligned for any type) from the arena, chaining a new block if it's out of space */
+void* arena_alloc(IterArena* arena, size_t size);
+/* Same as `arena_alloc`, but unaligned - so chars, e.g strings, can be packed back to back */
+void* arena_alloc_bytes(IterArena* arena, size_t size);
+/* Allocate `size` bytes from the arena and copy `size` bytes from `src` into it */
+void* arena_dup(IterArena* arena, void const* src, size_t size);
+/* Release everything allocated from the arena so far, keeping its first block around for reuse */
+void arena_reset(IterArena* arena);
+/* Free the arena, everything allocated from it is released */
+void free_arena(IterArena* arena);
+/* Turn the arena into an `Allocator` */
+Allocator arena_allocator(IterArena* arena);
+
+/* Copy a value of type `T`, built from the given initializer list, into the arena and return a pointer to it */
+#define arena_new(arena, T, ...) ((T*)arena_dup(arena, &(T){__VA_ARGS__}, sizeof(T)))
+
+/* Same as `arena_new`, but the value is stored in memory handed out by given `Allocator` */
+#define alloc_new(alloc, T, ...)                                                                                       \
+    ((T*)memcpy((alloc).tc->alloc((alloc).self, sizeof(T)), &(T){__VA_ARGS__}, sizeof(T)))
+
+#endif /* !IT_ARENA_H */
@@ -0,0 +1,96 @@
+#include "collect.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Grow the array at `data`, with room for `*cap` elements, to hold at least `need` of them - at least doubling it */
+static unsigned char* collect_grow(unsigned char* data, size_t* cap, size_t need, size_t elem_size)
+{
+    size_t const newcap = need > *cap * 2 ? need : *cap * 2;
+    if (newcap > SIZE_MAX / elem_size) {
+        fprintf(stderr, "OOM in collect_vec");
+        exit(1);
+    }
+    unsigned char* const grown = realloc(data, newcap * elem_size);
+    if (grown == NULL) {
+        fprintf(stderr, "OOM in collect_vec");
+        exit(1);
+    }
+    *cap = newcap;
+    return grown;
+}
+
+void* collect_buffer(void* src, CollectFill fill, CollectSpan span, CollectHint hint, size_t elem_size, size_t* len,
+                     size_t* cap)
+{
+    unsigned char* data = NULL;
+    size_t n            = 0;
+    size_t c            = 0;
+    while (true) {
+        void const* ptr;
+        size_t run;
+        if (span(src, SIZE_MAX, &ptr, &run)) {
+            /* Contiguous elements are copied over in one go, into an array grown (at most once) to fit them */
+            if (run == 0) {
+                break;
+            }
+            if (c - n < run) {
+                data = collect_grow(data, &c, n + run, elem_size);
+            }
+            memcpy(data + n * elem_size, ptr, run * elem_size);
+            n += run;
+            continue;
+        }
+        if (n == c) {
+            /*
+            Size the array after the size hint - an exact one means it's only allocated once, and that it needn't be
+            grown to find out the iterable is over. Without a lower bound it's grown by a batch at a time, at first
+            */
+            SizeHint const sh = hint(src);
+            if (is_just_of(sh.upper, size_t) && from_just_(sh.upper) == 0) {
+                break;
+            }
+            size_t const lower = sh.lower == SIZE_MAX || sh.lower > SIZE_MAX - n ? 0 : sh.lower;
+            data               = collect_grow(data, &c, n + (lower == 0 ? ITER_BATCH_SIZE : lower), elem_size);
+        }
+        size_t const got = fill(src, data + n * elem_size, c - n);
+        if (got == 0) {
+            break;
+        }
+        n += got;
+    }
+    if (n == 0) {
+        free(data);
+        data = NULL;
+        c    = 0;
+    }
+    *len = n;
+    *cap = c;
+    return data;
+}
+
+size_t collect_buffer_into(void* src, CollectFill fill, CollectSpan span, void* buf, size_t cap, size_t elem_size)
+{
+    unsigned char* const out = buf;
+    size_t n                 = 0;
+    while (n < cap) {
+        void const* ptr;
+        size_t run;
+        size_t got;
+        if (span(src, cap - n, &ptr, &run)) {
+            got = run;
+            if (run != 0) {
+                memcpy(out + n * elem_size, ptr, run * elem_size);
+            }
+        } else {
+            got = fill(src, out + n * elem_size, cap - n);
+        }
+        if (got == 0) {
+            break;
+        }
+        n += got;
+    }
+    return n;
+}
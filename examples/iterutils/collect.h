@@ -0,0 +1,117 @@
+#ifndef IT_COLLECT_H
+#define IT_COLLECT_H
+
+#include "../func_iter.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+/*
+Sinks that materialize an iterable into contiguous memory
+
+`collect_vec` gathers all of the elements of an iterable into a `Vec(T)` - a growable array on the heap. It's sized up
+front from the iterable's size hint, so an iterable that knows how many elements it has left (an array, a range, a
+map or a take over one ...) is collected with exactly one allocation. Array backed iterables are copied over in one
+`memcpy` of their span, and everything else in batches (see `iter_next_batch`) straight into the array.
+
+`collect_into` does the same into a fixed buffer of `cap` elements, and stops once it's full - the rest of the
+elements are left in the iterable.
+
+Either one turns back into an iterable with `arr_into_iter` - so an intermediate result of a pipeline can be
+checkpointed into an array, and then scanned (or split, or reduced over its span) as many times as need be.
+
+Example-
+
+Vec(int) const vec = collect_vec(map_over(srcit, parse, StrView, int), int);
+int const sum      = sum_intit(arr_into_iter(vec.data, vec.len, int));
+free_vec(vec);
+*/
+
+/* Pull up to `cap` elements out of the source iterable at `src` into `out`, returns how many were pulled */
+typedef size_t (*CollectFill)(void* src, void* out, size_t cap);
+
+/* Try to consume up to `max` elements of the source iterable at `src` as one contiguous run, see `iter_as_span` */
+typedef bool (*CollectSpan)(void* src, size_t max, void const** ptr, size_t* len);
+
+/* Size hint of the source iterable at `src` */
+typedef SizeHint (*CollectHint)(void* src);
+
+/*
+Collect every element of the source iterable at `src`, of `elem_size` bytes each, into an array on the heap - returns
+the array (`NULL` if there were no elements), and stores the number of elements in `len` and its capacity in `cap`
+
+Exits on OOM
+*/
+void* collect_buffer(void* src, CollectFill fill, CollectSpan span, CollectHint hint, size_t elem_size, size_t* len,
+                     size_t* cap);
+
+/* Collect up to `cap` elements of the source iterable at `src`, of `elem_size` bytes each, into `buf` */
+size_t collect_buffer_into(void* src, CollectFill fill, CollectSpan span, void* buf, size_t cap, size_t elem_size);
+
+#define Vec(T) Vec##T
+
+/* A contiguous array of `len` elements of type `T` on the heap, with room for `cap` of them */
+#define DefineVec(T)                                                                                                   \
+    typedef struct                                                                                                     \
+    {                                                                                                                  \
+        T* data;                                                                                                       \
+        size_t len;                                                                                                    \
+        size_t cap;                                                                                                    \
+    } Vec(T)
+
+/* Name of the function that collects an `Iterable(T)` into a `Vec(T)` */
+#define collect_vec_of(T) CONCAT(collect_vec_, T)
+
+/* Name of the function that collects an `Iterable(T)` into a buffer */
+#define collect_into_of(T) CONCAT(collect_into_, T)
+
+/* Collect all of the elements of given `it` iterable, of type `T`, into a `Vec(T)` - to be freed with `free_vec` */
+#define collect_vec(it, T) collect_vec_of(T)(it)
+
+/*
+Collect the elements of given `it` iterable, of type `T`, into the array of `cap` `T`s at `buf` - returns how many were
+collected, which is less than `cap` only if the iterable ran out
+*/
+#define collect_into(it, buf, cap, T) collect_into_of(T)(it, buf, cap)
+
+/* Free the array of given `Vec` */
+#define free_vec(vec) free((vec).data)
+
+/*
+Define `collect_vec_of(T)` and `collect_into_of(T)`-
+
+Vec(T) collect_vec_of(T)(Iterable(T) it);
+size_t collect_into_of(T)(Iterable(T) it, T* buf, size_t cap);
+
+This should be called in a source file
+*/
+#define define_collect_func(T)                                                                                         \
+    static size_t CONCAT(Vec(T), _fill)(void* src, void* out, size_t cap)                                              \
+    {                                                                                                                  \
+        return iter_next_batch(*(Iterable(T)*)src, out, cap, T);                                                       \
+    }                                                                                                                  \
+    static bool CONCAT(Vec(T), _span)(void* src, size_t max, void const** ptr, size_t* len)                            \
+    {                                                                                                                  \
+        Span(T) span;                                                                                                  \
+        if (!iter_as_span(*(Iterable(T)*)src, max, &span, T)) {                                                        \
+            return false;                                                                                              \
+        }                                                                                                              \
+        *ptr = span.ptr;                                                                                               \
+        *len = span.len;                                                                                               \
+        return true;                                                                                                   \
+    }                                                                                                                  \
+    static SizeHint CONCAT(Vec(T), _srchint)(void* src) { return iter_size_hint(*(Iterable(T)*)src, T); }              \
+    Vec(T) collect_vec_of(T)(Iterable(T) it)                                                                           \
+    {                                                                                                                  \
+        Vec(T) vec = {0};                                                                                              \
+        vec.data   = collect_buffer(&it, CONCAT(Vec(T), _fill), CONCAT(Vec(T), _span), CONCAT(Vec(T), _srchint),       \
+                                    sizeof(T), &vec.len, &vec.cap);                                                    \
+        return vec;                                                                                                    \
+    }                                                                                                                  \
+    size_t collect_into_of(T)(Iterable(T) it, T * buf, size_t cap)                                                     \
+    {                                                                                                                  \
+        return collect_buffer_into(&it, CONCAT(Vec(T), _fill), CONCAT(Vec(T), _span), buf, cap, sizeof(T));            \
+    }
+
+#endif /* !IT_COLLECT_H */
@@ -0,0 +1,117 @@
+#ifndef IT_FILTER_H
+#define IT_FILTER_H
+
+#include "../func_iter.h"
+#include "arena.h"
+
+#include <stdint.h>
+
+#define IterFilter(ElmntType) IterFilter##ElmntType
+
+#define DefineIterFilter(ElmntType)                                                                                    \
+    typedef struct                                                                                                     \
+    {                                                                                                                  \
+        bool (*const filterfn)(ElmntType x);                                                                           \
+        Iterable(ElmntType) const src;                                                                                 \
+    } IterFilter(ElmntType)
+
+/* Name of the function that wraps an IterFilter(ElmntType) for given ElmntType into an iterable */
+#define prep_iterfilter_of(ElmntType) CONCAT(CONCAT(prep_, IterFilter(ElmntType)), _itr)
+
+/* Name of the plain C compaction function defined by `define_filter_compact(ElmntType)` */
+#define filter_compact_of(ElmntType) CONCAT(filter_compact_, ElmntType)
+
+/* Build an iterable of the elements of `it` for which the predicate `pred`, of type `bool (*)(T)`, holds */
+#define filter_over(it, pred, T) prep_iterfilter_of(T)(&(IterFilter(T)){.filterfn = pred, .src = it})
+
+/* Like `filter_over`, but the `IterFilter` is stored in given `IterArena*` - so the iterable can outlive the scope */
+#define arena_filter_over(arena, it, pred, T)                                                                          \
+    prep_iterfilter_of(T)(arena_new(arena, IterFilter(T), .filterfn = pred, .src = it))
+
+/*
+Define the function `filter_compact_of(ElmntType)` - which copies the elements of the `n` at `in` whose `keep` byte is 1
+to `out` in order, and returns how many it copied
+
+Every element is written, but only the kept ones move the cursor - so there's no branch to mispredict. `out` must have
+room for all `n` elements. This is the compaction to hand `define_iterfilter_func` when there's no vectorized one for
+the element type
+*/
+#define define_filter_compact(ElmntType)                                                                               \
+    static size_t filter_compact_of(ElmntType)(ElmntType const* in, uint8_t const* keep, size_t n, ElmntType* out)     \
+    {                                                                                                                  \
+        size_t len = 0;                                                                                                \
+        for (size_t i = 0; i < n; i++) {                                                                               \
+            out[len] = in[i];                                                                                          \
+            len += keep[i];                                                                                            \
+        }                                                                                                              \
+        return len;                                                                                                    \
+    }
+
+/*
+Define the iterator implementation function for an IterFilter struct
+
+`next` pulls from the source one element at a time, until the predicate holds for one - a branch per element, which
+mispredicts a lot when the predicate holds for around half of them. Batches are filtered in blocks instead - a block of
+the source is pulled into a staging buffer, the predicate's results are stored in a mask of one byte per element, and
+`compact_f` (of type `size_t (*)(ElmntType const* in, uint8_t const* keep, size_t n, ElmntType* out)`, like the
+function `define_filter_compact` defines) copies the survivors to the output without branching on them.
+Blocks are pulled until the output is more than half full (or the source runs out), so a predicate that rarely holds
+doesn't make for a lot of tiny batches
+
+The size hint has no lower bound, and the source's upper bound
+The filter can be split whenever the source can - the front half filters the source's front half
+
+The function is named `prep_iterfilter_of(ElmntType)`
+*/
+#define define_iterfilter_func(ElmntType, compact_f)                                                                   \
+    static Maybe(ElmntType) CONCAT(IterFilter(ElmntType), _nxt)(IterFilter(ElmntType) * self)                          \
+    {                                                                                                                  \
+        Iterable(ElmntType) const srcit = self->src;                                                                   \
+        while (1) {                                                                                                    \
+            Maybe(ElmntType) res = srcit.tc->next(srcit.self);                                                         \
+            if (is_nothing_of(res, ElmntType) || self->filterfn(from_just_(res))) {                                    \
+                return res;                                                                                            \
+            }                                                                                                          \
+        }                                                                                                              \
+    }                                                                                                                  \
+    static size_t CONCAT(IterFilter(ElmntType), _batch)(IterFilter(ElmntType) * self, ElmntType * out, size_t cap)     \
+    {                                                                                                                  \
+        ElmntType buf[ITER_BATCH_SIZE];                                                                                \
+        uint8_t keep[ITER_BATCH_SIZE];                                                                                 \
+        size_t const want = cap < ITER_BATCH_SIZE ? cap : ITER_BATCH_SIZE;                                             \
+        size_t len        = 0;                                                                                         \
+        while (len < want && len <= want / 2) {                                                                        \
+            size_t const n = iter_next_batch(self->src, buf, want - len, ElmntType);                                   \
+            if (n == 0) {                                                                                              \
+                break;                                                                                                 \
+            }                                                                                                          \
+            for (size_t i = 0; i < n; i++) {                                                                           \
+                keep[i] = self->filterfn(buf[i]);                                                                      \
+            }                                                                                                          \
+            len += (compact_f)(buf, keep, n, out + len);                                                               \
+        }                                                                                                              \
+        return len;                                                                                                    \
+    }                                                                                                                  \
+    static SizeHint CONCAT(IterFilter(ElmntType), _hint)(IterFilter(ElmntType) * self)                                 \
+    {                                                                                                                  \
+        return (SizeHint){.lower = 0, .upper = iter_size_hint(self->src, ElmntType).upper};                            \
+    }                                                                                                                  \
+    static IterFilter(ElmntType) *                                                                                     \
+        CONCAT(IterFilter(ElmntType), _split)(IterFilter(ElmntType) * self, Allocator alloc)                           \
+    {                                                                                                                  \
+        Iterable(ElmntType) front;                                                                                     \
+        if (!iter_split(self->src, alloc, &front, ElmntType)) {                                                        \
+            return NULL;                                                                                               \
+        }                                                                                                              \
+        return alloc_new(alloc, IterFilter(ElmntType), .filterfn = self->filterfn, .src = front);                      \
+    }                                                                                                                  \
+    impl_next_batch(IterFilter(ElmntType)*, ElmntType, CONCAT(IterFilter(ElmntType), _batch))                          \
+    impl_size_hint(IterFilter(ElmntType)*, CONCAT(IterFilter(ElmntType), _hint))                                       \
+    impl_split(IterFilter(ElmntType)*, CONCAT(IterFilter(ElmntType), _split))                                          \
+    impl_iterator_with(IterFilter(ElmntType)*, ElmntType, prep_iterfilter_of(ElmntType),                               \
+                       CONCAT(IterFilter(ElmntType), _nxt),                                                            \
+                       iter_slot(next_batch, CONCAT(IterFilter(ElmntType), _batch)),                                   \
+                       iter_slot(size_hint, CONCAT(IterFilter(ElmntType), _hint)),                                     \
+                       iter_slot(split, CONCAT(IterFilter(ElmntType), _split)))
+
+#endif /* !IT_FILTER_H */
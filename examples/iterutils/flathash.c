@@ -0,0 +1,210 @@
+#include "flathash.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Smallest number of slots a table is made with */
+#define FLAT_HASH_MIN_SLOTS 16
+
+static void* flat_hash_realloc(void* mem, size_t count, size_t size)
+{
+    if (size != 0 && count > SIZE_MAX / size) {
+        fprintf(stderr, "OOM in flat_hash");
+        exit(1);
+    }
+    void* const grown = realloc(mem, count * size == 0 ? 1 : count * size);
+    if (grown == NULL) {
+        fprintf(stderr, "OOM in flat_hash");
+        exit(1);
+    }
+    return grown;
+}
+
+/* Spread the bits of `x` over all of the result's - the finalizer of MurmurHash3 */
+static inline uint64_t hash_mix(uint64_t x)
+{
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdu;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53u;
+    x ^= x >> 33;
+    return x;
+}
+
+/* Fold a word into the hash state - multiplied, rotated and multiplied again, so both its bits and its place count */
+static inline uint64_t hash_step(uint64_t h, uint64_t w)
+{
+    h ^= w * 0x87c37b91114253d5u;
+    h = (h << 31) | (h >> 33);
+    return h * 0x4cf5ad432745937fu;
+}
+
+size_t hash_bytes(void const* data, size_t len)
+{
+    unsigned char const* p = data;
+    uint64_t h             = 0x9e3779b97f4a7c15u ^ (uint64_t)len;
+    /* Eight bytes at a time, and what's left over zero extended into one last word */
+    for (; len >= 8; p += 8, len -= 8) {
+        uint64_t w;
+        memcpy(&w, p, 8);
+        h = hash_step(h, w);
+    }
+    if (len != 0) {
+        uint64_t w = 0;
+        memcpy(&w, p, len);
+        h = hash_step(h, w);
+    }
+    return (size_t)hash_mix(h);
+}
+
+size_t hash_int(void const* key) { return (size_t)hash_mix((uint32_t)(*(int const*)key)); }
+
+bool eq_int(void const* a, void const* b) { return *(int const*)a == *(int const*)b; }
+
+size_t hash_string(void const* key)
+{
+    char const* const s = *(char const* const*)key;
+    return hash_bytes(s, strlen(s));
+}
+
+bool eq_string(void const* a, void const* b) { return strcmp(*(char const* const*)a, *(char const* const*)b) == 0; }
+
+/* The high bits of a hash, that are kept in its slot - the low ones pick the slot */
+static inline uint32_t flat_hash_tag(size_t hash) { return (uint32_t)((uint64_t)hash >> 32); }
+
+FlatHash flat_hash_new(size_t key_size, size_t val_size, HashFn hash, HashEq eq, size_t cap)
+{
+    /* Enough slots that `cap` entries fill at most 3/4 of them */
+    size_t nslots = FLAT_HASH_MIN_SLOTS;
+    while (nslots / 4 * 3 < cap) {
+        if (nslots > SIZE_MAX / 2 / sizeof(FlatHashSlot)) {
+            fprintf(stderr, "OOM in flat_hash_new");
+            exit(1);
+        }
+        nslots *= 2;
+    }
+    cap = cap < FLAT_HASH_MIN_SLOTS ? FLAT_HASH_MIN_SLOTS : cap;
+    FlatHash fh = {.slots    = calloc(nslots, sizeof(FlatHashSlot)),
+                   .mask     = nslots - 1,
+                   .keys     = flat_hash_realloc(NULL, cap, key_size),
+                   .vals     = flat_hash_realloc(NULL, cap, val_size),
+                   .hashes   = flat_hash_realloc(NULL, cap, sizeof(size_t)),
+                   .len      = 0,
+                   .cap      = cap,
+                   .key_size = key_size,
+                   .val_size = val_size,
+                   .hash     = hash,
+                   .eq       = eq};
+    if (fh.slots == NULL) {
+        fprintf(stderr, "OOM in flat_hash_new");
+        exit(1);
+    }
+    return fh;
+}
+
+/* Double the number of slots, and put every entry back into its slot in the new ones */
+static void flat_hash_rehash(FlatHash* fh)
+{
+    size_t const nslots = 2 * (fh->mask + 1);
+    if (nslots > SIZE_MAX / sizeof(FlatHashSlot)) {
+        fprintf(stderr, "OOM in flat_hash");
+        exit(1);
+    }
+    FlatHashSlot* const slots = calloc(nslots, sizeof(FlatHashSlot));
+    if (slots == NULL) {
+        fprintf(stderr, "OOM in flat_hash");
+        exit(1);
+    }
+    size_t const mask = nslots - 1;
+    for (size_t e = 0; e < fh->len; e++) {
+        size_t i = fh->hashes[e] & mask;
+        while (slots[i].entry != 0) {
+            i = (i + 1) & mask;
+        }
+        slots[i] = (FlatHashSlot){.tag = flat_hash_tag(fh->hashes[e]), .entry = (uint32_t)(e + 1)};
+    }
+    free(fh->slots);
+    fh->slots = slots;
+    fh->mask  = mask;
+}
+
+/* Append an entry for the key at `key`, with given hash and a zeroed value, to the entries - returns its index */
+static size_t flat_hash_append(FlatHash* fh, void const* key, size_t hash)
+{
+    if (fh->len == fh->cap) {
+        fh->cap    = 2 * fh->cap;
+        fh->keys   = flat_hash_realloc(fh->keys, fh->cap, fh->key_size);
+        fh->vals   = flat_hash_realloc(fh->vals, fh->cap, fh->val_size);
+        fh->hashes = flat_hash_realloc(fh->hashes, fh->cap, sizeof(size_t));
+    }
+    size_t const e = fh->len++;
+    memcpy(fh->keys + e * fh->key_size, key, fh->key_size);
+    memset(fh->vals + e * fh->val_size, 0, fh->val_size);
+    fh->hashes[e] = hash;
+    return e;
+}
+
+/*
+Same as `flat_hash_insert`, hashing and comparing with `hash` and `eq` (the table's own) - which are called directly,
+so they're inlined when this is called with known functions
+*/
+static inline size_t flat_hash_insert_with(FlatHash* fh, void const* key, HashFn hash, HashEq eq)
+{
+    if ((fh->len + 1) * 4 > (fh->mask + 1) * 3) {
+        if (fh->len >= UINT32_MAX - 1) {
+            fprintf(stderr, "OOM in flat_hash_insert");
+            exit(1);
+        }
+        flat_hash_rehash(fh);
+    }
+    size_t const h     = hash(key);
+    uint32_t const tag = flat_hash_tag(h);
+    size_t const mask  = fh->mask;
+    for (size_t i = h & mask;; i = (i + 1) & mask) {
+        FlatHashSlot const slot = fh->slots[i];
+        if (slot.entry == 0) {
+            size_t const e = flat_hash_append(fh, key, h);
+            fh->slots[i]   = (FlatHashSlot){.tag = tag, .entry = (uint32_t)(e + 1)};
+            return e;
+        }
+        if (slot.tag == tag && eq(fh->keys + (slot.entry - 1) * fh->key_size, key)) {
+            return slot.entry - 1;
+        }
+    }
+}
+
+size_t flat_hash_insert(FlatHash* fh, void const* key)
+{
+    /* Ints hashed and compared by the default functions are hashed and compared inline */
+    if (fh->hash == hash_int && fh->eq == eq_int) {
+        return flat_hash_insert_with(fh, key, hash_int, eq_int);
+    }
+    return flat_hash_insert_with(fh, key, fh->hash, fh->eq);
+}
+
+size_t flat_hash_find(FlatHash const* fh, void const* key)
+{
+    size_t const h     = fh->hash(key);
+    uint32_t const tag = flat_hash_tag(h);
+    for (size_t i = h & fh->mask;; i = (i + 1) & fh->mask) {
+        FlatHashSlot const slot = fh->slots[i];
+        if (slot.entry == 0) {
+            return SIZE_MAX;
+        }
+        if (slot.tag == tag && fh->eq(fh->keys + (slot.entry - 1) * fh->key_size, key)) {
+            return slot.entry - 1;
+        }
+    }
+}
+
+void flat_hash_free(FlatHash* fh)
+{
+    free(fh->slots);
+    free(fh->keys);
+    free(fh->vals);
+    free(fh->hashes);
+    *fh = (FlatHash){0};
+}
@@ -0,0 +1,95 @@
+#ifndef IT_FLATHASH_H
+#define IT_FLATHASH_H
+
+#include "../func_iter.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+An insertion ordered hash table, with open addressing over a flat array of slots
+
+The keys (of a fixed size) are stored back to back in a dense array, in the order they were inserted - along with a
+value (of a fixed size, possibly 0) for each one in a parallel array, and its hash. The table itself is an array of
+slots of 8 bytes each - the index of an entry, and the high bits of its hash - probed linearly from the slot the low
+bits of the hash point to. So a lookup goes through consecutive slots, and only looks at a key when the high bits of its
+hash match - and the keys, and the values, can be scanned (or handed out) as plain arrays.
+
+The table holds at most 3/4 as many entries as it has slots, and doubles once it'd hold more - reusing the stored
+hashes, rather than hashing every key again. Sizing it for the number of entries it'll end up with up front (see
+`flat_hash_new`) avoids that altogether. It holds up to `UINT32_MAX - 1` entries.
+
+Keys are hashed and compared by the functions the table is made with. `hash_int`/`eq_int` and `hash_string`/`eq_string`
+hash and compare ints, and strings (`char*`) by their contents - the strings are not copied into the table, they must
+outlive it. `hash_bytes` hashes a run of bytes, to build hash functions for other keys on.
+*/
+
+/* Hash the key at `key` */
+typedef size_t (*HashFn)(void const* key);
+
+/* Whether the keys at `a` and `b` are equal */
+typedef bool (*HashEq)(void const* a, void const* b);
+
+/* A slot of a `FlatHash` - `entry` is 1 + the index of the entry in it, or 0 if it's empty */
+typedef struct
+{
+    uint32_t tag;
+    uint32_t entry;
+} FlatHashSlot;
+
+typedef struct
+{
+    FlatHashSlot* slots;
+    size_t mask;
+    /* The entries - `len` of them, with room for `cap` - in the order they were inserted */
+    unsigned char* keys;
+    unsigned char* vals;
+    size_t* hashes;
+    size_t len;
+    size_t cap;
+    size_t key_size;
+    size_t val_size;
+    HashFn hash;
+    HashEq eq;
+} FlatHash;
+
+/* Hash `len` bytes at `data` - fast, but not cryptographic */
+size_t hash_bytes(void const* data, size_t len);
+
+/* Hash and compare ints */
+size_t hash_int(void const* key);
+bool eq_int(void const* a, void const* b);
+
+/* Hash and compare strings (i.e `char*`s) by their contents */
+size_t hash_string(void const* key);
+bool eq_string(void const* a, void const* b);
+
+/* Name of the default hash function for keys of type `T` */
+#define hash_of(T) CONCAT(hash_, T)
+
+/* Name of the default comparison function for keys of type `T` */
+#define eq_of(T) CONCAT(eq_, T)
+
+/*
+Make a table of keys of `key_size` bytes, with values of `val_size` bytes, hashed and compared with `hash` and `eq`
+
+It's sized to hold `cap` entries without growing. Exits on OOM
+*/
+FlatHash flat_hash_new(size_t key_size, size_t val_size, HashFn hash, HashEq eq, size_t cap);
+
+/*
+Index of the entry of the key at `key`, inserting it (with a zeroed value) if there's none - the key was inserted if
+the index is the number of entries there were before
+
+Exits on OOM
+*/
+size_t flat_hash_insert(FlatHash* fh, void const* key);
+
+/* Index of the entry of the key at `key`, `SIZE_MAX` if there's none */
+size_t flat_hash_find(FlatHash const* fh, void const* key);
+
+/* Free the table, along with its keys and values */
+void flat_hash_free(FlatHash* fh);
+
+#endif /* !IT_FLATHASH_H */
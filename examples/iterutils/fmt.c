@@ -0,0 +1,70 @@
+#include "fmt.h"
+
+#include <stdint.h>
+#include <string.h>
+
+/* The digits of every number from 0 to 99, two chars each */
+static char const digit_pairs[201] = "00010203040506070809"
+                                     "10111213141516171819"
+                                     "20212223242526272829"
+                                     "30313233343536373839"
+                                     "40414243444546474849"
+                                     "50515253545556575859"
+                                     "60616263646566676869"
+                                     "70717273747576777879"
+                                     "80818283848586878889"
+                                     "90919293949596979899";
+
+static uint32_t const powers_of_10[10] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+/*
+Number of decimal digits in `x`
+
+Without a branch - a comparison chain mispredicts all the time on numbers of mixed lengths. The number of bits in `x`
+times log10(2) (~1233 / 4096) is the number of digits, or one more than it - which the table tells apart
+*/
+static size_t count_digits(uint32_t x)
+{
+    size_t const approx = (size_t)(32 - __builtin_clz(x | 1)) * 1233 >> 12;
+    /* `x | 1` compares the same as `x` against every power of 10 but 1 - so 0 has one digit */
+    return approx + ((x | 1) >= powers_of_10[approx]);
+}
+
+size_t fmt_u32(char* out, uint32_t x)
+{
+    size_t const len = count_digits(x);
+    /* Fill in the digits from the last one, two at a time */
+    char* end = out + len;
+    while (x >= 100) {
+        uint32_t const pair = x % 100;
+        x /= 100;
+        end -= 2;
+        memcpy(end, digit_pairs + 2 * pair, 2);
+    }
+    if (x >= 10) {
+        memcpy(end - 2, digit_pairs + 2 * x, 2);
+    } else {
+        end[-1] = (char)('0' + x);
+    }
+    return len;
+}
+
+size_t fmt_int(char* out, int x)
+{
+    if (x >= 0) {
+        return fmt_u32(out, (uint32_t)x);
+    }
+    /* Negating in unsigned arithmetic works for `INT_MIN` too */
+    out[0] = '-';
+    return 1 + fmt_u32(out + 1, 0u - (uint32_t)x);
+}
+
+StrView arena_fmt_int(int x, IterArena* arena)
+{
+    char buf[FMT_INT_MAX];
+    size_t const len = fmt_int(buf, x);
+    char* const str  = arena_alloc_bytes(arena, len + 1);
+    memcpy(str, buf, len);
+    str[len] = '\0';
+    return (StrView){.ptr = str, .len = len};
+}
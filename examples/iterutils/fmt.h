@@ -0,0 +1,34 @@
+#ifndef IT_FMT_H
+#define IT_FMT_H
+
+#include "../func_iter.h"
+#include "arena.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+Formatting numbers into strings without `snprintf`
+
+`snprintf` parses its format string, and goes through the locale machinery, on every call - which dominates the cost
+of turning each element of an iterable into a string. These write the decimal digits straight into a buffer, two at a
+time out of a table of the hundred digit pairs, instead.
+
+`arena_fmt_int` is meant to be mapped over an iterable with `map_into_arena` (see `map.h`) - each string is bump
+allocated from the arena, so no element needs to be freed on its own.
+*/
+
+/* Most chars `fmt_u32` writes - 10 digits */
+#define FMT_U32_MAX 10
+/* Most chars `fmt_int` writes - a sign and 10 digits */
+#define FMT_INT_MAX 11
+
+/* Write the decimal digits of `x` into `out` (without a NUL terminator), returns the number of chars written */
+size_t fmt_u32(char* out, uint32_t x);
+/* Write the decimal digits of `x`, preceded by a `-` if it's negative, into `out` - same as `fmt_u32` otherwise */
+size_t fmt_int(char* out, int x);
+
+/* Format `x` into a NUL terminated string allocated from `arena`, returns a view of it (without the terminator) */
+StrView arena_fmt_int(int x, IterArena* arena);
+
+#endif /* !IT_FMT_H */
@@ -0,0 +1,116 @@
+#include "group.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct DistinctSet
+{
+    /* The elements yielded so far - the keys of the table, without values */
+    FlatHash seen;
+    size_t elem_size;
+    DistinctFill fill;
+    DistinctHint hint;
+    void* src;
+};
+
+static void* group_malloc(size_t count, size_t size)
+{
+    if (size != 0 && count > SIZE_MAX / size) {
+        fprintf(stderr, "OOM in group");
+        exit(1);
+    }
+    void* const mem = malloc(count * size == 0 ? 1 : count * size);
+    if (mem == NULL) {
+        fprintf(stderr, "OOM in group");
+        exit(1);
+    }
+    return mem;
+}
+
+DistinctSet* distinct_set_new(void const* src, size_t src_size, DistinctFill fill, DistinctHint hint, size_t elem_size,
+                              HashFn hash, HashEq eq, size_t cap)
+{
+    DistinctSet* const set = group_malloc(1, sizeof(*set));
+    *set                   = (DistinctSet){.seen      = flat_hash_new(elem_size, 0, hash, eq, cap),
+                                           .elem_size = elem_size,
+                                           .fill      = fill,
+                                           .hint      = hint,
+                                           .src       = group_malloc(1, src_size)};
+    memcpy(set->src, src, src_size);
+    return set;
+}
+
+size_t distinct_set_read(DistinctSet* set, void* out, size_t cap)
+{
+    unsigned char* const dst = out;
+    size_t const es          = set->elem_size;
+    if (cap == 0) {
+        return 0;
+    }
+    while (true) {
+        size_t const n = set->fill(set->src, dst, cap);
+        if (n == 0) {
+            return 0;
+        }
+        /* Keep the elements that make it into the table as new entries, moving them down over the dropped ones */
+        size_t kept = 0;
+        for (size_t i = 0; i < n; i++) {
+            size_t const before = set->seen.len;
+            if (flat_hash_insert(&set->seen, dst + i * es) != before) {
+                continue;
+            }
+            if (kept != i) {
+                memcpy(dst + kept * es, dst + i * es, es);
+            }
+            kept++;
+        }
+        if (kept != 0) {
+            return kept;
+        }
+    }
+}
+
+SizeHint distinct_set_hint(DistinctSet* set)
+{
+    SizeHint const src = set->hint(set->src);
+    /* The next element is only known to be new if there were none before it */
+    size_t const lower = src.lower != 0 && set->seen.len == 0 ? 1 : 0;
+    return (SizeHint){.lower = lower, .upper = src.upper};
+}
+
+void distinct_set_free(DistinctSet* set)
+{
+    flat_hash_free(&set->seen);
+    free(set->src);
+    free(set);
+}
+
+size_t* group_layout(size_t const* counts, size_t ngroups, size_t const* gidx, void const* elems, size_t n,
+                     size_t elem_size, void** out)
+{
+    size_t* const starts = group_malloc(ngroups + 1, sizeof(size_t));
+    /* Where the next element of each group goes */
+    size_t* const next = group_malloc(ngroups, sizeof(size_t));
+    starts[0]          = 0;
+    for (size_t g = 0; g < ngroups; g++) {
+        next[g]       = starts[g];
+        starts[g + 1] = starts[g] + counts[g];
+    }
+    unsigned char* const dst = group_malloc(n, elem_size);
+    unsigned char const* src = elems;
+    for (size_t i = 0; i < n; i++) {
+        memcpy(dst + next[gidx[i]]++ * elem_size, src + i * elem_size, elem_size);
+    }
+    free(next);
+    *out = dst;
+    return starts;
+}
+
+size_t counts_get(FlatHash const* index, void const* key)
+{
+    size_t const e = flat_hash_find(index, key);
+    return e == SIZE_MAX ? 0 : ((size_t const*)index->vals)[e];
+}
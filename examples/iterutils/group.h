@@ -0,0 +1,272 @@
+#ifndef IT_GROUP_H
+#define IT_GROUP_H
+
+#include "../func_iter.h"
+#include "collect.h"
+#include "flathash.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+Utilities to deduplicate and aggregate iterables, in a hash table (see `flathash.h`)
+
+`distinct` yields the elements of an iterable, skipping every one that's equal to an element yielded before it - in a
+single pass, remembering the elements yielded so far in a hash table. It lives on the heap, and must be freed with
+`free_distinct`.
+
+`count_by` and `group_by` are sinks, that map every element of an iterable to a key with given function. `count_by`
+counts the elements of each key, and `group_by` gathers them - into one array, where each key's elements are next to
+each other, in the order they came in. Both hand out the keys in the order they were first seen, along with the counts
+or where each key's elements start, as plain arrays - and can also be looked up by key, with `count_of` and
+`group_find`.
+
+The elements are hashed and compared by `hash_of(T)` and `eq_of(T)` - and the `_with` variants take any other hash
+and comparison functions, along with the number of distinct keys (or elements) to size the table for up front. Strings
+are hashed and compared by their contents, but aren't copied - they must outlive whatever was built over them.
+
+Example-
+
+Counts(string) counts = count_by(wordsit, word, string, string);
+for (size_t i = 0; i < counts.len; i++) {
+    printf("%s %zu\n", counts.keys[i], counts.counts[i]);
+}
+free_counts(counts);
+*/
+
+/* The state of a `distinct` - the elements yielded so far, and the source */
+typedef struct DistinctSet DistinctSet;
+
+/* Pull up to `cap` elements out of the source iterable at `src` into `out`, returns how many were pulled */
+typedef size_t (*DistinctFill)(void* src, void* out, size_t cap);
+
+/* Size hint of the source iterable at `src` */
+typedef SizeHint (*DistinctHint)(void* src);
+
+/*
+Make a `distinct` over the source iterable of `src_size` bytes at `src` - whose elements, of `elem_size` bytes each, are
+pulled out with `fill`, and hashed and compared with `hash` and `eq` in a table sized for `cap` of them
+
+The source is copied, `fill` and `hint` are called with a pointer to the copy. Exits on OOM
+*/
+DistinctSet* distinct_set_new(void const* src, size_t src_size, DistinctFill fill, DistinctHint hint, size_t elem_size,
+                              HashFn hash, HashEq eq, size_t cap);
+
+/* Copy up to `cap` of the next elements not seen before into `out` - returns how many were copied, 0 once it's over */
+size_t distinct_set_read(DistinctSet* set, void* out, size_t cap);
+
+/* Number of elements left - at most as many as the source has left, and at least one if none were seen yet */
+SizeHint distinct_set_hint(DistinctSet* set);
+
+/* Free the `distinct`, along with the copy of the source and the elements seen */
+void distinct_set_free(DistinctSet* set);
+
+/*
+Lay out `n` elements of `elem_size` bytes at `elems`, element `i` being in group `gidx[i]`, group by group - keeping
+their order within each group
+
+`counts` holds the number of elements in each of the `ngroups` groups. The laid out elements are stored in a new array
+at `out`, and an array of where each group starts in it (and where the last one ends) is returned. Exits on OOM
+*/
+size_t* group_layout(size_t const* counts, size_t ngroups, size_t const* gidx, void const* elems, size_t n,
+                     size_t elem_size, void** out);
+
+/* Number of elements counted for the key at `key`, in the table of counts at `index` */
+size_t counts_get(FlatHash const* index, void const* key);
+
+#define Distinct(T) Distinct##T
+
+/* A `distinct` over an iterable of `T`s */
+#define DefineDistinct(T) typedef DistinctSet Distinct(T)
+
+#define Counts(KeyType) Counts##KeyType
+
+/*
+The number of elements of each key of type `KeyType`, as counted by `count_by`
+
+`counts[i]` elements were counted for the key `keys[i]`, the `len` keys are in the order they were first seen. Both
+arrays are owned by `index`, the table of keys
+*/
+#define DefineCounts(KeyType)                                                                                          \
+    typedef struct                                                                                                     \
+    {                                                                                                                  \
+        KeyType const* keys;                                                                                           \
+        size_t const* counts;                                                                                          \
+        size_t len;                                                                                                    \
+        FlatHash index;                                                                                                \
+    } Counts(KeyType)
+
+#define Groups(ElmntType, KeyType) Groups##ElmntType##KeyType
+
+/*
+The elements of type `ElmntType` of each key of type `KeyType`, as gathered by `group_by`
+
+The elements of the key `keys[i]` are `elems[starts[i]]` up to `elems[starts[i + 1]]`, in the order they came in. The
+`len` keys are in the order they were first seen, and owned by `index`, the table of keys
+*/
+#define DefineGroups(ElmntType, KeyType)                                                                               \
+    typedef struct                                                                                                     \
+    {                                                                                                                  \
+        KeyType const* keys;                                                                                           \
+        size_t* starts;                                                                                                \
+        ElmntType* elems;                                                                                              \
+        size_t len;                                                                                                    \
+        FlatHash index;                                                                                                \
+    } Groups(ElmntType, KeyType)
+
+/* Name of the function that builds a `distinct` over an `Iterable(T)` */
+#define distinct_of(T) CONCAT(distinct_, T)
+
+/* Name of the function that frees a `distinct` built by `distinct_of(T)` */
+#define free_distinct_of(T) CONCAT(free_distinct_, T)
+
+/* Name of the function that counts the elements of an `Iterable(ElmntType)` by keys of type `KeyType` */
+#define count_by_of(ElmntType, KeyType) CONCAT(CONCAT(count_by_, ElmntType), CONCAT(_, KeyType))
+
+/* Name of the function that groups the elements of an `Iterable(ElmntType)` by keys of type `KeyType` */
+#define group_by_of(ElmntType, KeyType) CONCAT(CONCAT(group_by_, ElmntType), CONCAT(_, KeyType))
+
+/* Build an `Iterable(T)` of the elements of given `it` iterable that aren't equal to any before them */
+#define distinct(it, T) distinct_of(T)(it, hash_of(T), eq_of(T), 0)
+
+/* Same as `distinct`, hashing and comparing elements with `hash` and `eq`, in a table sized for `cap` of them */
+#define distinct_with(it, hash, eq, cap, T) distinct_of(T)(it, hash, eq, cap)
+
+/* Free the `distinct` behind given `it` iterable */
+#define free_distinct(it, T) free_distinct_of(T)(it)
+
+/* Count the elements of given `it` iterable, of type `ElmntType`, by their `key` (of type `KeyType`) into `Counts` */
+#define count_by(it, key, ElmntType, KeyType)                                                                          \
+    count_by_of(ElmntType, KeyType)(it, key, hash_of(KeyType), eq_of(KeyType), 0)
+
+/* Same as `count_by`, hashing and comparing keys with `hash` and `eq`, in a table sized for `cap` of them */
+#define count_by_with(it, key, hash, eq, cap, ElmntType, KeyType)                                                      \
+    count_by_of(ElmntType, KeyType)(it, key, hash, eq, cap)
+
+/* Number of elements counted for `key`, of type `KeyType`, in given `Counts` - 0 if there were none */
+#define count_of(counts, key, KeyType) counts_get(&(counts).index, &(KeyType){key})
+
+/* Free the arrays of given `Counts` */
+#define free_counts(counts) flat_hash_free(&(counts).index)
+
+/* Gather the elements of given `it` iterable, of type `ElmntType`, by their `key`, of type `KeyType` - into `Groups` */
+#define group_by(it, key, ElmntType, KeyType)                                                                          \
+    group_by_of(ElmntType, KeyType)(it, key, hash_of(KeyType), eq_of(KeyType), 0)
+
+/* Same as `group_by`, hashing and comparing keys with `hash` and `eq`, in a table sized for `cap` of them */
+#define group_by_with(it, key, hash, eq, cap, ElmntType, KeyType)                                                      \
+    group_by_of(ElmntType, KeyType)(it, key, hash, eq, cap)
+
+/* Index of the group of `key`, of type `KeyType`, in given `Groups` - `SIZE_MAX` if there's none */
+#define group_find(groups, key, KeyType) flat_hash_find(&(groups).index, &(KeyType){key})
+
+/* Free the arrays of given `Groups` */
+#define free_groups(groups) (flat_hash_free(&(groups).index), free((groups).starts), free((groups).elems))
+
+/*
+Define the `next`, `next_batch` and `size_hint` functions of `Distinct(T)`, implement `Iterator` for it, and define
+`distinct_of(T)` and `free_distinct_of(T)`-
+
+Iterable(T) distinct_of(T)(Iterable(T) it, HashFn hash, HashEq eq, size_t cap);
+void free_distinct_of(T)(Iterable(T) it);
+
+`next_batch` pulls a batch out of the source, and drops the elements seen before from it in place
+
+This should be called in a source file
+*/
+#define define_distinct_func(T)                                                                                        \
+    static size_t CONCAT(Distinct(T), _fill)(void* src, void* out, size_t cap)                                         \
+    {                                                                                                                  \
+        return iter_next_batch(*(Iterable(T)*)src, out, cap, T);                                                       \
+    }                                                                                                                  \
+    static SizeHint CONCAT(Distinct(T), _srchint)(void* src) { return iter_size_hint(*(Iterable(T)*)src, T); }         \
+    static Maybe(T) CONCAT(Distinct(T), _nxt)(Distinct(T) * self)                                                      \
+    {                                                                                                                  \
+        T x;                                                                                                           \
+        if (distinct_set_read(self, &x, 1) == 0) {                                                                     \
+            return Nothing(T);                                                                                         \
+        }                                                                                                              \
+        return Just(x, T);                                                                                             \
+    }                                                                                                                  \
+    static size_t CONCAT(Distinct(T), _batch)(Distinct(T) * self, T * out, size_t cap)                                 \
+    {                                                                                                                  \
+        return distinct_set_read(self, out, cap);                                                                      \
+    }                                                                                                                  \
+    static SizeHint CONCAT(Distinct(T), _hint)(Distinct(T) * self) { return distinct_set_hint(self); }                 \
+    impl_next_batch(Distinct(T)*, T, CONCAT(Distinct(T), _batch))                                                      \
+    impl_size_hint(Distinct(T)*, CONCAT(Distinct(T), _hint))                                                           \
+    impl_default_next_into(Distinct(T)*, T, CONCAT(Distinct(T), _nxt))                                                 \
+    impl_iterator_with(Distinct(T)*, T, CONCAT(prep_, Distinct(T)), CONCAT(Distinct(T), _nxt),                         \
+                       iter_slot(next_batch, CONCAT(Distinct(T), _batch)),                                             \
+                       iter_slot(size_hint, CONCAT(Distinct(T), _hint)), iter_default_into(CONCAT(Distinct(T), _nxt))) \
+    Iterable(T) distinct_of(T)(Iterable(T) it, HashFn hash, HashEq eq, size_t cap)                                     \
+    {                                                                                                                  \
+        return CONCAT(prep_, Distinct(T))(distinct_set_new(&it, sizeof(it), CONCAT(Distinct(T), _fill),                \
+                                                           CONCAT(Distinct(T), _srchint), sizeof(T), hash, eq, cap));  \
+    }                                                                                                                  \
+    void free_distinct_of(T)(Iterable(T) it) { distinct_set_free(it.self); }
+
+/*
+Define `count_by_of(ElmntType, KeyType)`-
+
+Counts(KeyType) count_by_of(ElmntType, KeyType)(Iterable(ElmntType) it, KeyType (*key)(ElmntType x), HashFn hash,
+                                                HashEq eq, size_t cap);
+
+The elements are pulled out of the iterable in batches. This should be called in a source file
+*/
+#define define_count_by_func(ElmntType, KeyType)                                                                       \
+    Counts(KeyType) count_by_of(ElmntType, KeyType)(Iterable(ElmntType) it, KeyType (*key)(ElmntType x), HashFn hash,  \
+                                                    HashEq eq, size_t cap)                                             \
+    {                                                                                                                  \
+        FlatHash index = flat_hash_new(sizeof(KeyType), sizeof(size_t), hash, eq, cap);                                \
+        ElmntType buf[ITER_BATCH_SIZE];                                                                                \
+        for (size_t n = iter_next_batch(it, buf, ITER_BATCH_SIZE, ElmntType); n != 0;                                  \
+             n        = iter_next_batch(it, buf, ITER_BATCH_SIZE, ElmntType)) {                                        \
+            for (size_t i = 0; i < n; i++) {                                                                           \
+                KeyType const k = key(buf[i]);                                                                         \
+                /* Inserting may move the values, so they're only looked at once it's done */                          \
+                size_t const e  = flat_hash_insert(&index, &k);                                                        \
+                ((size_t*)index.vals)[e]++;                                                                            \
+            }                                                                                                          \
+        }                                                                                                              \
+        return (Counts(KeyType)){                                                                                      \
+            .keys = (KeyType*)index.keys, .counts = (size_t*)index.vals, .len = index.len, .index = index};            \
+    }
+
+/*
+Define `group_by_of(ElmntType, KeyType)`-
+
+Groups(ElmntType, KeyType) group_by_of(ElmntType, KeyType)(Iterable(ElmntType) it, KeyType (*key)(ElmntType x),
+                                                           HashFn hash, HashEq eq, size_t cap);
+
+The elements are collected into an array first (with `collect_vec_of(ElmntType)`, which must be defined), keyed, and
+then laid out group by group. This should be called in a source file
+*/
+#define define_group_by_func(ElmntType, KeyType)                                                                       \
+    Groups(ElmntType, KeyType) group_by_of(ElmntType, KeyType)(Iterable(ElmntType) it, KeyType (*key)(ElmntType x),    \
+                                                               HashFn hash, HashEq eq, size_t cap)                     \
+    {                                                                                                                  \
+        Vec(ElmntType) const all = collect_vec_of(ElmntType)(it);                                                      \
+        size_t* const gidx       = malloc((all.len == 0 ? 1 : all.len) * sizeof(size_t));                              \
+        if (gidx == NULL) {                                                                                            \
+            fprintf(stderr, "OOM in group_by");                                                                        \
+            exit(1);                                                                                                   \
+        }                                                                                                              \
+        FlatHash index = flat_hash_new(sizeof(KeyType), sizeof(size_t), hash, eq, cap);                                \
+        for (size_t i = 0; i < all.len; i++) {                                                                         \
+            KeyType const k = key(all.data[i]);                                                                        \
+            gidx[i]         = flat_hash_insert(&index, &k);                                                            \
+            ((size_t*)index.vals)[gidx[i]]++;                                                                          \
+        }                                                                                                              \
+        void* elems          = NULL;                                                                                   \
+        size_t* const starts = group_layout((size_t*)index.vals, index.len, gidx, all.data, all.len,                   \
+                                            sizeof(ElmntType), &elems);                                                \
+        free(gidx);                                                                                                    \
+        free_vec(all);                                                                                                 \
+        return (Groups(ElmntType, KeyType)){                                                                           \
+            .keys = (KeyType*)index.keys, .starts = starts, .elems = elems, .len = index.len, .index = index};         \
+    }
+
+#endif /* !IT_GROUP_H */
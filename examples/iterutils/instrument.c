@@ -0,0 +1,210 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "instrument.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef ITER_INSTRUMENT
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define INSTRUMENT_TSC 1
+#include <x86intrin.h>
+#else
+#define INSTRUMENT_TSC 0
+#endif
+
+/* The stage registered last - every stage links to the one before it */
+static IterStats* stages           = NULL;
+static pthread_mutex_t stages_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* Ticks spent in instrumented calls nested in the call this thread is in */
+static __thread uint64_t nested_ticks = 0;
+/* Number of instrumented calls this thread is in */
+static __thread size_t depth = 0;
+/* Depth of the instrumented call this thread left last (as it was in the call), and the upstream ticks of that call */
+static __thread size_t last_depth      = 0;
+static __thread uint64_t last_upstream = 0;
+
+/* The monotonic clock, and the tick count, when the first stage was registered - to convert ticks into nanoseconds */
+static uint64_t origin_ns    = 0;
+static uint64_t origin_ticks = 0;
+
+static uint64_t monotonic_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t now_ticks(void)
+{
+#if INSTRUMENT_TSC
+    return __rdtsc();
+#else
+    return monotonic_ns();
+#endif
+}
+
+IterStats* iter_stats_register(char const* label)
+{
+    pthread_mutex_lock(&stages_lock);
+    IterStats* stats = stages;
+    while (stats != NULL && strcmp(stats->label, label) != 0) {
+        stats = stats->prev;
+    }
+    if (stats == NULL) {
+        stats = calloc(1, sizeof(*stats));
+        if (stats == NULL) {
+            fprintf(stderr, "OOM in iter_stats_register");
+            exit(1);
+        }
+        stats->label = label;
+        stats->prev  = stages;
+        if (stages == NULL) {
+            origin_ns    = monotonic_ns();
+            origin_ticks = now_ticks();
+        }
+        stages = stats;
+    }
+    pthread_mutex_unlock(&stages_lock);
+    return stats;
+}
+
+IterStatsFrame iter_stats_enter(void)
+{
+    IterStatsFrame const frame = {.start = now_ticks(), .outer = nested_ticks};
+    nested_ticks               = 0;
+    last_depth                 = 0;
+    depth++;
+    return frame;
+}
+
+/* Record a call in `stats`, with `upstream` ticks of it spent upstream */
+static void record_call(IterStats* stats, IterStatsFrame frame, size_t elements, uint64_t upstream)
+{
+    uint64_t const ticks = now_ticks() - frame.start;
+    /* The bucket is the index of the highest set bit */
+    size_t bucket = ticks < 2 ? 0 : 63 - (size_t)__builtin_clzll(ticks);
+    bucket        = bucket < INSTRUMENT_BUCKETS ? bucket : INSTRUMENT_BUCKETS - 1;
+    /* Stages may be shared by several threads - the totals are summed up from the histogram when dumped */
+    if (elements == 0) {
+        __atomic_fetch_add(&stats->nothings, 1, __ATOMIC_RELAXED);
+    } else {
+        __atomic_fetch_add(&stats->elements, elements, __ATOMIC_RELAXED);
+    }
+    if (upstream != 0) {
+        __atomic_fetch_add(&stats->upstream_ticks, upstream, __ATOMIC_RELAXED);
+    }
+    __atomic_fetch_add(&stats->hist_calls[bucket], 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&stats->hist_ticks[bucket], ticks, __ATOMIC_RELAXED);
+    /* This call is nested in the one the thread goes back to */
+    last_depth    = depth;
+    last_upstream = upstream;
+    depth--;
+    nested_ticks = frame.outer + ticks;
+}
+
+void iter_stats_leave(IterStats* stats, IterStatsFrame frame, size_t elements)
+{
+    record_call(stats, frame, elements, nested_ticks);
+}
+
+void iter_stats_leave_through(IterStats* stats, IterStatsFrame frame, size_t elements)
+{
+    /* The last call to leave is the one to the source if it was instrumented - calls nested in it left before it */
+    bool const through = last_depth == depth + 1;
+    record_call(stats, frame, elements, through ? last_upstream : nested_ticks);
+}
+
+double iter_stats_ns_per_tick(void)
+{
+#if INSTRUMENT_TSC
+    pthread_mutex_lock(&stages_lock);
+    uint64_t const start_ns    = origin_ns;
+    uint64_t const start_ticks = origin_ticks;
+    pthread_mutex_unlock(&stages_lock);
+    if (start_ns == 0) {
+        return 1;
+    }
+    /* Let at least a millisecond pass since the origin, so the ratio is somewhat precise */
+    uint64_t ns = monotonic_ns();
+    while (ns - start_ns < 1000000) {
+        ns = monotonic_ns();
+    }
+    uint64_t const ticks = now_ticks();
+    return (double)(ns - start_ns) / (double)(ticks - start_ticks);
+#else
+    return 1;
+#endif
+}
+
+/* Print the stages before (i.e registered before) `stats` first, and then `stats` */
+static void dump_stage(FILE* out, IterStats const* stats, double ns_per_tick)
+{
+    if (stats == NULL) {
+        return;
+    }
+    dump_stage(out, stats->prev, ns_per_tick);
+    uint64_t calls = 0;
+    uint64_t ticks = 0;
+    for (size_t i = 0; i < INSTRUMENT_BUCKETS; i++) {
+        calls += __atomic_load_n(&stats->hist_calls[i], __ATOMIC_RELAXED);
+        ticks += __atomic_load_n(&stats->hist_ticks[i], __ATOMIC_RELAXED);
+    }
+    double const total_ms = (double)ticks * ns_per_tick / 1e6;
+    double const up_ms    = (double)__atomic_load_n(&stats->upstream_ticks, __ATOMIC_RELAXED) * ns_per_tick / 1e6;
+    fprintf(out, "%s: %llu calls, %llu Nothing, %llu elements - %.3f ms total, %.3f ms upstream, %.3f ms self",
+            stats->label, (unsigned long long)calls,
+            (unsigned long long)__atomic_load_n(&stats->nothings, __ATOMIC_RELAXED),
+            (unsigned long long)__atomic_load_n(&stats->elements, __ATOMIC_RELAXED), total_ms, up_ms,
+            total_ms - up_ms);
+    fprintf(out, ", %.1f ns per call\n", calls == 0 ? 0.0 : total_ms * 1e6 / (double)calls);
+    for (size_t i = 0; i < INSTRUMENT_BUCKETS; i++) {
+        uint64_t const bcalls = __atomic_load_n(&stats->hist_calls[i], __ATOMIC_RELAXED);
+        if (bcalls == 0) {
+            continue;
+        }
+        double const lo_ns = i == 0 ? 0.0 : (double)((uint64_t)1 << i) * ns_per_tick;
+        double const hi_ns = (double)((uint64_t)1 << (i + 1)) * ns_per_tick;
+        double const bms   = (double)__atomic_load_n(&stats->hist_ticks[i], __ATOMIC_RELAXED) * ns_per_tick / 1e6;
+        fprintf(out, "    %10.0f - %10.0f ns: %12llu calls, %.3f ms\n", lo_ns, hi_ns, (unsigned long long)bcalls, bms);
+    }
+}
+
+void iter_stats_dump(FILE* out)
+{
+    double const ns_per_tick = iter_stats_ns_per_tick();
+    pthread_mutex_lock(&stages_lock);
+    IterStats const* const last = stages;
+    pthread_mutex_unlock(&stages_lock);
+    dump_stage(out, last, ns_per_tick);
+}
+
+void iter_stats_reset(void)
+{
+    pthread_mutex_lock(&stages_lock);
+    for (IterStats* stats = stages; stats != NULL; stats = stats->prev) {
+        IterStats* const prev   = stats->prev;
+        char const* const label = stats->label;
+        memset(stats, 0, sizeof(*stats));
+        stats->label = label;
+        stats->prev  = prev;
+    }
+    pthread_mutex_unlock(&stages_lock);
+}
+#else
+/* Nothing is recorded without `ITER_INSTRUMENT` - there are no stages, and no ticks */
+double iter_stats_ns_per_tick(void) { return 1; }
+
+void iter_stats_dump(FILE* out)
+{
+    fputs("Iterator instrumentation is disabled - build with ITER_INSTRUMENT defined to record it\n", out);
+}
+
+void iter_stats_reset(void) {}
+#endif
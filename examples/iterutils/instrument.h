@@ -0,0 +1,147 @@
+#ifndef IT_INSTRUMENT_H
+#define IT_INSTRUMENT_H
+
+#include "../func_iter.h"
+
+#include <stdint.h>
+#include <stdio.h>
+
+/*
+Utilities to find out which stage of an iterator chain the time goes to
+
+`instrument(it, "label", T)` wraps an iterable in a stage that records every `next` (and `next_batch`) call made
+through it, in the `IterStats` registered under the label - how many calls there were, how many of them yielded
+`Nothing` (or an empty batch), how many elements they yielded and a histogram of how long they took. Building with
+`ITER_INSTRUMENT` defined also records every `next` made through the typeclass of any `impl_iterator` - labelled after
+the iterator's type - without touching the chain (see `ITER_INSTRUMENT` in `iterator.h`).
+
+A call's time includes the time spent upstream, in the calls the stage makes to its source. Time spent in instrumented
+calls nested in a call is also recorded as the call's upstream time - so the time spent in the stage itself is the
+rest. Calls are timed with the time stamp counter on x86 (which is converted into nanoseconds against the monotonic
+clock when the statistics are dumped), and the monotonic clock everywhere else.
+
+`iter_stats_dump` prints every registered stage's statistics. Without `ITER_INSTRUMENT` defined, `instrument` is the
+iterable it's given and nothing is recorded - so instrumented chains cost nothing, but also report nothing. `IterStats`
+and the functions that record calls aren't declared then, only `iter_stats_dump`, `iter_stats_reset` and
+`iter_stats_ns_per_tick` are.
+
+Example-
+
+Iterable(int) takeit = instrument(take_from(srcit, 10, int), "take", int);
+Iterable(int) it     = instrument(map_over(takeit, parse, int, int), "map", int);
+...
+iter_stats_dump(stderr);
+*/
+
+#ifdef ITER_INSTRUMENT
+/* Number of buckets in the latency histograms - calls in bucket `i` took from `2^i` up to `2^(i + 1)` ticks */
+#define INSTRUMENT_BUCKETS 40
+
+struct IterStats
+{
+    char const* label;
+    /* Calls that yielded nothing - i.e `Nothing` or an empty batch - and the elements yielded by the rest */
+    uint64_t nothings;
+    uint64_t elements;
+    /* Ticks spent in instrumented calls nested in the calls */
+    uint64_t upstream_ticks;
+    /* Number of calls whose length falls into each bucket, and the ticks spent in them - these sum up to the totals */
+    uint64_t hist_calls[INSTRUMENT_BUCKETS];
+    uint64_t hist_ticks[INSTRUMENT_BUCKETS];
+    /* The stage registered before this one */
+    IterStats* prev;
+};
+
+/*
+Same as `iter_stats_leave`, for a `next` that makes (at most) one call to its source's `next` - which is instrumented
+as well, under `ITER_INSTRUMENT`. The time that call spent in itself is recorded as time spent in this call itself,
+rather than upstream
+
+Only `next` can take this shortcut - `next_batch` isn't instrumented along the chain, so the last call to leave may be
+a stage further upstream
+*/
+void iter_stats_leave_through(IterStats* stats, IterStatsFrame frame, size_t elements);
+#endif
+
+/* Number of nanoseconds a tick takes */
+double iter_stats_ns_per_tick(void);
+
+/* Print the statistics of every registered stage, in the order they were registered */
+void iter_stats_dump(FILE* out);
+
+/* Zero the statistics of every registered stage - while no calls are being recorded */
+void iter_stats_reset(void);
+
+#define IterInstrument(T) IterInstrument##T
+
+#define DefineIterInstrument(T)                                                                                        \
+    typedef struct                                                                                                     \
+    {                                                                                                                  \
+        /* Spelled out as a struct - `IterStats` is only declared under `ITER_INSTRUMENT` */                           \
+        struct IterStats* const stats;                                                                                 \
+        Iterable(T) const src;                                                                                         \
+    } IterInstrument(T)
+
+/* Name of the function that wraps an IterInstrument(T) for given T into an iterable */
+#define prep_iterinstrument_of(T) CONCAT(CONCAT(prep_, IterInstrument(T)), _itr)
+
+#ifdef ITER_INSTRUMENT
+/* Build an iterable that yields the elements of `it`, recording the calls made through it under `label` */
+#define instrument(it, label, T)                                                                                       \
+    prep_iterinstrument_of(T)(&(IterInstrument(T)){.stats = iter_stats_register(label), .src = it})
+#else
+#define instrument(it, label, T) (it)
+#endif
+
+/*
+Define the iterator implementation function for an IterInstrument struct - only with `ITER_INSTRUMENT` defined
+
+`next` and `next_batch` time the same call on the source - `next` counts the time the source spends in itself as its
+own, `next_batch` counts only the time spent in instrumented stages upstream as upstream. The size hint, and skipping
+elements, are forwarded to the source as they are
+
+The function is named `prep_iterinstrument_of(T)`
+*/
+#ifdef ITER_INSTRUMENT
+#define define_iterinstrument_func(T)                                                                                  \
+    static Maybe(T) CONCAT(IterInstrument(T), _nxt)(IterInstrument(T) * self)                                          \
+    {                                                                                                                  \
+        Iterable(T) const srcit    = self->src;                                                                        \
+        IterStatsFrame const frame = iter_stats_enter();                                                               \
+        Maybe(T) const res         = srcit.tc->next(srcit.self);                                                       \
+        iter_stats_leave_through(self->stats, frame, is_just_of(res, T));                                              \
+        return res;                                                                                                    \
+    }                                                                                                                  \
+    static size_t CONCAT(IterInstrument(T), _batch)(IterInstrument(T) * self, T * out, size_t cap)                     \
+    {                                                                                                                  \
+        IterStatsFrame const frame = iter_stats_enter();                                                               \
+        size_t const n             = iter_next_batch(self->src, out, cap, T);                                          \
+        iter_stats_leave(self->stats, frame, n);                                                                       \
+        return n;                                                                                                      \
+    }                                                                                                                  \
+    static SizeHint CONCAT(IterInstrument(T), _hint)(IterInstrument(T) * self)                                         \
+    {                                                                                                                  \
+        return iter_size_hint(self->src, T);                                                                           \
+    }                                                                                                                  \
+    static size_t CONCAT(IterInstrument(T), _advance)(IterInstrument(T) * self, size_t n)                              \
+    {                                                                                                                  \
+        return iter_advance_by(self->src, n, T);                                                                       \
+    }                                                                                                                  \
+    impl_next_batch(IterInstrument(T)*, T, CONCAT(IterInstrument(T), _batch))                                          \
+    impl_advance_by(IterInstrument(T)*, CONCAT(IterInstrument(T), _advance))                                           \
+    impl_size_hint(IterInstrument(T)*, CONCAT(IterInstrument(T), _hint))                                               \
+    /* The typeclass is built by hand - `impl_iterator_with` would record each `next` again, as its own stage */       \
+    static Maybe(T) CONCAT(IterInstrument(T), _nxt__)(void* self) { return CONCAT(IterInstrument(T), _nxt)(self); }    \
+    Iterable(T) prep_iterinstrument_of(T)(IterInstrument(T) * x)                                                       \
+    {                                                                                                                  \
+        static Iterator(T) const tc = {.next = CONCAT(IterInstrument(T), _nxt__),                                      \
+                                       iter_slot(next_batch, CONCAT(IterInstrument(T), _batch)),                       \
+                                       iter_slot(size_hint, CONCAT(IterInstrument(T), _hint)),                         \
+                                       iter_slot(advance_by, CONCAT(IterInstrument(T), _advance))};                    \
+        return (Iterable(T)){.tc = &tc, .self = x};                                                                    \
+    }
+#else
+#define define_iterinstrument_func(T)
+#endif
+
+#endif /* !IT_INSTRUMENT_H */
@@ -14,15 +14,192 @@
  * a common struct, instead - it's extracted from the actual source backing the iterator on demand
  */
 
-/* Generic function to sum values from any iterable yielding int */
-int sum_intit(Iterable(int) it)
-{
-    int sum = 0;
-    foreach (int, x, it) {
-        sum += x;
+/* The kernels treat elements as `uint32_t`, int elements are handed to them as is */
+typedef char int_is_32_bits[sizeof(int) == sizeof(uint32_t) ? 1 : -1];
+
+/*
+Define the reduction sinks for iterables yielding `T` (an int type of 32 bits) - named `sum_##Short##it` and so on
+
+`bias` is what the kernels compare elements with, i.e `0` for signed `T` and `SIMD_UNSIGNED_BIAS` for unsigned `T`
+
+Iterables that hand out progressions (see `iter_as_progression`) are reduced in closed form first, the kernels only
+see what's left after that
+*/
+#define define_reduce_funcs(T, Short, bias)                                                                            \
+    /* Get the next run of contiguous elements - the whole span of array backed iterables, a staged batch otherwise */ \
+    static size_t CONCAT(next_run_, Short)(Iterable(T) it, T * buf, T const** out)                                   \
+    {                                                                                                                  \
+        Span(T) span;                                                                                                  \
+        if (iter_as_span(it, SIZE_MAX, &span, T)) {                                                                    \
+            *out = span.ptr;                                                                                           \
+            return span.len;                                                                                           \
+        }                                                                                                              \
+        *out = buf;                                                                                                    \
+        return iter_next_batch(it, buf, ITER_BATCH_SIZE, T);                                                           \
+    }                                                                                                                  \
+    /* Get exactly the next `cap` elements (fewer only at the end) - in place if possible, copied into `buf` if not */ \
+    static size_t CONCAT(next_full_run_, Short)(Iterable(T) it, T * buf, size_t cap, T const** out)                  \
+    {                                                                                                                  \
+        size_t n = 0;                                                                                                  \
+        Span(T) span;                                                                                                  \
+        if (iter_as_span(it, cap, &span, T)) {                                                                         \
+            if (span.len == cap || span.len == 0) {                                                                    \
+                *out = span.ptr;                                                                                       \
+                return span.len;                                                                                       \
+            }                                                                                                          \
+            memcpy(buf, span.ptr, span.len * sizeof(*buf));                                                            \
+            n = span.len;                                                                                              \
+        }                                                                                                              \
+        for (size_t got = 1; n < cap && got != 0; n += got) {                                                         \
+            got = iter_next_batch(it, buf + n, cap - n, T);                                                            \
+        }                                                                                                              \
+        *out = buf;                                                                                                    \
+        return n;                                                                                                      \
+    }                                                                                                                  \
+    /* Get the next (non empty) progression, if the iterable hands them out */                                         \
+    static bool CONCAT(next_prog_, Short)(Iterable(T) it, Progression(T) * out)                                        \
+    {                                                                                                                  \
+        return iter_as_progression(it, SIZE_MAX, out, T) && out->len != 0;                                             \
+    }                                                                                                                  \
+    /* Last value of a (non empty) progression */                                                                      \
+    static T CONCAT(prog_last_, Short)(Progression(T) const* prog)                                                     \
+    {                                                                                                                  \
+        return (T)((uintmax_t)prog->first + (uintmax_t)(prog->len - 1) * (uintmax_t)prog->step);                       \
+    }                                                                                                                  \
+    /* Sum of a progression, wrapped around like the kernels' - `len * first + step * len * (len - 1) / 2` */          \
+    static uint32_t CONCAT(prog_sum_, Short)(Progression(T) const* prog)                                               \
+    {                                                                                                                  \
+        uintmax_t const n = prog->len;                                                                                 \
+        /* Halve whichever factor is even, so nothing is lost to the wrap around before the division */                \
+        uintmax_t const tri = n % 2 == 0 ? n / 2 * (n - 1) : (n - 1) / 2 * n;                                          \
+        return (uint32_t)(n * (uint32_t)prog->first + tri * (uint32_t)prog->step);                                     \
+    }                                                                                                                  \
+    /* Number of values of a progression less than `value` (`lt`), and equal to it (`eq`) */                           \
+    static void CONCAT(prog_count_, Short)(Progression(T) const* prog, T value, size_t* lt, size_t* eq)                \
+    {                                                                                                                  \
+        /* Values (and their differences) of a 32 bit `T` are exact in `intmax_t` */                                   \
+        intmax_t const n = (intmax_t)prog->len;                                                                        \
+        intmax_t const f = (intmax_t)prog->first;                                                                      \
+        intmax_t const s = (intmax_t)prog->step;                                                                       \
+        intmax_t const d = (intmax_t)value - f;                                                                        \
+        if (s == 0) {                                                                                                  \
+            *lt = d > 0 ? (size_t)n : 0;                                                                               \
+            *eq = d == 0 ? (size_t)n : 0;                                                                              \
+            return;                                                                                                    \
+        }                                                                                                              \
+        *eq = d % s == 0 && d / s >= 0 && d / s < n;                                                                   \
+        if (s > 0) {                                                                                                   \
+            /* Value `k` is less than `value` for every `k < ceil(d / s)` */                                           \
+            intmax_t const below = d <= 0 ? 0 : (d + s - 1) / s;                                                       \
+            *lt                  = (size_t)(below < n ? below : n);                                                    \
+        } else {                                                                                                       \
+            /* Value `k` is less than `value` for every `k > -d / -s` */                                               \
+            intmax_t const from = d > 0 ? 0 : -d / -s + 1;                                                             \
+            *lt                 = (size_t)(from < n ? n - from : 0);                                                   \
+        }                                                                                                              \
+    }                                                                                                                  \
+    T CONCAT(sum_, CONCAT(Short, it))(Iterable(T) it)                                                                  \
+    {                                                                                                                  \
+        SimdKernels const* const kernels = simd_kernels();                                                             \
+        uint32_t sum                     = 0;                                                                          \
+        Progression(T) prog;                                                                                           \
+        while (CONCAT(next_prog_, Short)(it, &prog)) {                                                                 \
+            sum += CONCAT(prog_sum_, Short)(&prog);                                                                    \
+        }                                                                                                              \
+        T buf[ITER_BATCH_SIZE];                                                                                        \
+        T const* run;                                                                                                  \
+        for (size_t n = CONCAT(next_run_, Short)(it, buf, &run); n != 0;                                               \
+             n        = CONCAT(next_run_, Short)(it, buf, &run)) {                                                     \
+            sum += kernels->sum((uint32_t const*)run, n);                                                              \
+        }                                                                                                              \
+        return (T)sum;                                                                                                 \
+    }                                                                                                                  \
+    Maybe(T) CONCAT(min_, CONCAT(Short, it))(Iterable(T) it)                                                           \
+    {                                                                                                                  \
+        SimdKernels const* const kernels = simd_kernels();                                                             \
+        Maybe(T) res                     = Nothing(T);                                                                 \
+        Progression(T) prog;                                                                                           \
+        while (CONCAT(next_prog_, Short)(it, &prog)) {                                                                 \
+            /* A progression only ever goes one way, its min is at one of its ends */                                  \
+            T const last = CONCAT(prog_last_, Short)(&prog);                                                           \
+            T const x    = prog.first < last ? prog.first : last;                                                      \
+            res          = is_nothing_of(res, T) || x < from_just_(res) ? Just(x, T) : res;                            \
+        }                                                                                                              \
+        T buf[ITER_BATCH_SIZE];                                                                                        \
+        T const* run;                                                                                                  \
+        for (size_t n = CONCAT(next_run_, Short)(it, buf, &run); n != 0;                                               \
+             n        = CONCAT(next_run_, Short)(it, buf, &run)) {                                                     \
+            T const x = (T)kernels->min((uint32_t const*)run, n, bias);                                                \
+            res       = is_nothing_of(res, T) || x < from_just_(res) ? Just(x, T) : res;                               \
+        }                                                                                                              \
+        return res;                                                                                                    \
+    }                                                                                                                  \
+    Maybe(T) CONCAT(max_, CONCAT(Short, it))(Iterable(T) it)                                                           \
+    {                                                                                                                  \
+        SimdKernels const* const kernels = simd_kernels();                                                             \
+        Maybe(T) res                     = Nothing(T);                                                                 \
+        Progression(T) prog;                                                                                           \
+        while (CONCAT(next_prog_, Short)(it, &prog)) {                                                                 \
+            /* A progression only ever goes one way, its max is at one of its ends */                                  \
+            T const last = CONCAT(prog_last_, Short)(&prog);                                                           \
+            T const x    = prog.first > last ? prog.first : last;                                                      \
+            res          = is_nothing_of(res, T) || x > from_just_(res) ? Just(x, T) : res;                            \
+        }                                                                                                              \
+        T buf[ITER_BATCH_SIZE];                                                                                        \
+        T const* run;                                                                                                  \
+        for (size_t n = CONCAT(next_run_, Short)(it, buf, &run); n != 0;                                               \
+             n        = CONCAT(next_run_, Short)(it, buf, &run)) {                                                     \
+            T const x = (T)kernels->max((uint32_t const*)run, n, bias);                                                \
+            res       = is_nothing_of(res, T) || x > from_just_(res) ? Just(x, T) : res;                               \
+        }                                                                                                              \
+        return res;                                                                                                    \
+    }                                                                                                                  \
+    size_t CONCAT(count_if_, CONCAT(Short, it))(Iterable(T) it, CmpOp op, T value)                                     \
+    {                                                                                                                  \
+        SimdKernels const* const kernels = simd_kernels();                                                             \
+        /* The kernels only count `==`, `<` and `>` - the others are counted as the complement of one of those */     \
+        SimdCmp const kop = op == CMP_EQ || op == CMP_NE ? SIMD_CMP_EQ                                                 \
+                            : op == CMP_LT || op == CMP_GE ? SIMD_CMP_LT                                               \
+                                                           : SIMD_CMP_GT;                                              \
+        bool const negate = op == CMP_NE || op == CMP_GE || op == CMP_LE;                                              \
+        size_t count      = 0;                                                                                         \
+        Progression(T) prog;                                                                                           \
+        while (CONCAT(next_prog_, Short)(it, &prog)) {                                                                 \
+            size_t lt, eq;                                                                                             \
+            CONCAT(prog_count_, Short)(&prog, value, &lt, &eq);                                                        \
+            size_t const matched = kop == SIMD_CMP_EQ ? eq : kop == SIMD_CMP_LT ? lt : prog.len - lt - eq;             \
+            count += negate ? prog.len - matched : matched;                                                            \
+        }                                                                                                              \
+        T buf[ITER_BATCH_SIZE];                                                                                        \
+        T const* run;                                                                                                  \
+        for (size_t n = CONCAT(next_run_, Short)(it, buf, &run); n != 0;                                               \
+             n        = CONCAT(next_run_, Short)(it, buf, &run)) {                                                     \
+            size_t const matched = kernels->count((uint32_t const*)run, n, kop, (uint32_t)value, bias);                \
+            count += negate ? n - matched : matched;                                                                   \
+        }                                                                                                              \
+        return count;                                                                                                  \
+    }                                                                                                                  \
+    T CONCAT(dot_, CONCAT(Short, it))(Iterable(T) a, Iterable(T) b)                                                    \
+    {                                                                                                                  \
+        SimdKernels const* const kernels = simd_kernels();                                                             \
+        uint32_t sum                     = 0;                                                                          \
+        T abuf[ITER_BATCH_SIZE], bbuf[ITER_BATCH_SIZE];                                                                \
+        T const *arun, *brun;                                                                                          \
+        while (1) {                                                                                                    \
+            size_t const an = CONCAT(next_full_run_, Short)(a, abuf, ITER_BATCH_SIZE, &arun);                         \
+            size_t const bn = CONCAT(next_full_run_, Short)(b, bbuf, an, &brun);                                      \
+            sum += kernels->dot((uint32_t const*)arun, (uint32_t const*)brun, bn);                                     \
+            if (bn < ITER_BATCH_SIZE) {                                                                                \
+                return (T)sum;                                                                                         \
+            }                                                                                                          \
+        }                                                                                                              \
     }
-    return sum;
-}
+
+// clang-format off
+/* Implement the reduction sinks for int and uint32_t iterables */
+define_reduce_funcs(int, int, 0)
+define_reduce_funcs(uint32_t, u32, SIMD_UNSIGNED_BIAS)
+// clang-format on
 
 /* Generic function to print values from any iterable yielding string */
 void print_strit(Iterable(string) it)
@@ -33,10 +210,82 @@ void print_strit(Iterable(string) it)
     puts("");
 }
 
+static int add_ints(int a, int b) { return a + b; }
+
+static int sum_task(int acc, Iterable(int) task) { return acc + sum_intit(task); }
+
+/* Generic function to sum values from any iterable yielding int, on `nthreads` threads if it can be split */
+int par_sum_intit(Iterable(int) it, size_t nthreads)
+{
+    return par_reduce_of(int, int)(it, 0, sum_task, add_ints, nthreads);
+}
+
+/* Compact the survivors of a filter over 32 bit elements with the vectorized kernel */
+static size_t compact_int(int const* in, uint8_t const* keep, size_t n, int* out)
+{
+    return simd_kernels()->compact((uint32_t const*)in, keep, n, (uint32_t*)out);
+}
+
+static size_t compact_u32(uint32_t const* in, uint8_t const* keep, size_t n, uint32_t* out)
+{
+    return simd_kernels()->compact(in, keep, n, out);
+}
+
 // clang-format off
+/* Implement `take` functionality for int iterables */
+define_itertake_func(int)
 /* Implement `take` functionality for uint32_t iterables */
 define_itertake_func(uint32_t)
+/* Implement `take` functionality for StrView iterables */
+define_itertake_func(StrView)
+/* Implement `skip` functionality for int iterables */
+define_iterskip_func(int)
+/* Implement `skip` functionality for uint32_t iterables */
+define_iterskip_func(uint32_t)
+/* Implement `skip` functionality for StrView iterables */
+define_iterskip_func(StrView)
 /* Implement `map` functionality for int -> int iterables */
 define_itermap_func(int, int)
 /* Implement `map` functionality for int -> char* iterables */
 define_itermap_func(int, string)
+/* Implement `map` functionality for StrView -> int iterables */
+define_itermap_func(StrView, int)
+/* Implement `map_into_arena` functionality for int iterables */
+define_itermaparena_func(int)
+/* Implement `filter` functionality for int and uint32_t iterables, compacting with the vectorized kernel */
+define_iterfilter_func(int, compact_int)
+define_iterfilter_func(uint32_t, compact_u32)
+/* Implement `filter` functionality for StrView iterables, compacting in plain C */
+define_filter_compact(StrView)
+define_iterfilter_func(StrView, filter_compact_of(StrView))
+/* Implement instrumented stages of int and StrView iterables - only with `ITER_INSTRUMENT` defined */
+define_iterinstrument_func(int)
+define_iterinstrument_func(StrView)
+/* Implement parallel folds of int iterables into an int */
+define_par_fold_func(int, int)
+/* Implement reading int iterables ahead on a background thread */
+define_readahead_func(int)
+/* Implement collecting int and char* iterables into arrays */
+define_collect_func(int)
+define_collect_func(string)
+/* Implement deduplicating int and char* iterables */
+define_distinct_func(int)
+define_distinct_func(string)
+/* Implement counting int and char* iterables by int and char* keys */
+define_count_by_func(int, int)
+define_count_by_func(string, string)
+/* Implement grouping int and char* iterables by int keys */
+define_group_by_func(int, int)
+define_group_by_func(string, int)
+/* Implement merging sorted int and StrView iterables */
+define_merge_func(int)
+define_merge_func(StrView)
+/* Implement splitting and caching int and StrView iterables */
+define_tee_func(int)
+define_tee_func(StrView)
+/* Implement mapping int -> int on multiple threads */
+define_par_map_func(int, int)
+/* Implement mapping int -> char* on multiple threads */
+define_par_map_func(int, string)
+/* Implement mapping uint32_t -> uint32_t on multiple threads */
+define_par_map_func(uint32_t, uint32_t)
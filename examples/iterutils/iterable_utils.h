@@ -2,33 +2,227 @@
 #define IT_ITRBLE_UTILS_H
 
 #include "../func_iter.h"
+#include "collect.h"
+#include "filter.h"
+#include "flathash.h"
+#include "fmt.h"
+#include "group.h"
+#include "instrument.h"
 #include "map.h"
+#include "merge.h"
+#include "par_fold.h"
+#include "par_map.h"
+#include "pipeline.h"
+#include "readahead.h"
+#include "simd.h"
+#include "skip.h"
 #include "take.h"
+#include "tee.h"
+
+#include <stddef.h>
+#include <stdint.h>
 
 #define UNIQVAR(x) CONCAT(CONCAT(x, _4x2_), __LINE__) /* "Unique" variable name */
 
 /* Iterate through given `it` iterable that contains elements of type `T` - store each element in `x` */
 #define foreach(T, x, it)                                                                                              \
     Maybe(T) UNIQVAR(res) = (it).tc->next((it).self);                                                                  \
-    for (T x          = from_just_(UNIQVAR(res)); is_just(UNIQVAR(res));                                               \
+    for (T x          = from_just_(UNIQVAR(res)); is_just_of(UNIQVAR(res), T);                                         \
          UNIQVAR(res) = (it).tc->next((it).self), x = from_just_(UNIQVAR(res)))
 
+/*
+Iterate through the iterator struct pointed to by `iterptr`, of type `IterType*`, that yields elements of type `T` -
+store each element in `x`
+
+This calls `static_next(IterType)` directly instead of going through an `Iterable`'s typeclass, so the `next`
+implementation can be inlined into the loop. `IterType` must be the alphanumeric struct name, e.g `ArrIter(int)`
+*/
+#define foreach_static(IterType, T, x, iterptr)                                                                        \
+    Maybe(T) UNIQVAR(res) = static_next(IterType)(iterptr);                                                            \
+    for (T x          = from_just_(UNIQVAR(res)); is_just_of(UNIQVAR(res), T);                                         \
+         UNIQVAR(res) = static_next(IterType)(iterptr), x = from_just_(UNIQVAR(res)))
+
+/*
+Iterate through given `it` iterable that contains elements of type `T` in batches of (at most) `ITER_BATCH_SIZE`
+
+Each batch is stored in the array `buf`, `n` holds the number of elements in it
+*/
+#define foreach_batch(T, buf, n, it)                                                                                   \
+    T buf[ITER_BATCH_SIZE];                                                                                            \
+    for (size_t n = iter_next_batch(it, buf, ITER_BATCH_SIZE, T); n != 0;                                              \
+         n        = iter_next_batch(it, buf, ITER_BATCH_SIZE, T))
+
+/* Implement `IterTake` struct for int iterables */
+DefineIterTake(int);
 /* Implement `IterTake` struct for uint32_t iterables */
 DefineIterTake(uint32_t);
+/* Implement `IterTake` struct for StrView iterables */
+DefineIterTake(StrView);
+/* Implement `IterSkip` struct for int iterables */
+DefineIterSkip(int);
+/* Implement `IterSkip` struct for uint32_t iterables */
+DefineIterSkip(uint32_t);
+/* Implement `IterSkip` struct for StrView iterables */
+DefineIterSkip(StrView);
 /* Implement `IterMap` struct for int -> int iterables */
 DefineIterMap(int, int);
 /* Implement `IterMap` struct for int -> char* iterables */
 DefineIterMap(int, string);
+/* Implement `IterMap` struct for StrView -> int iterables */
+DefineIterMap(StrView, int);
+/* Implement `IterMapArena` struct for int -> StrView iterables, whose strings are allocated from an arena */
+DefineIterMapArena(int);
+/* Implement `IterFilter` struct for int iterables */
+DefineIterFilter(int);
+/* Implement `IterFilter` struct for uint32_t iterables */
+DefineIterFilter(uint32_t);
+/* Implement `IterFilter` struct for StrView iterables */
+DefineIterFilter(StrView);
+/* The consumer end of int iterables read ahead on a background thread */
+DefineReadahead(int);
+/* The consumer end of int -> int maps on multiple threads */
+DefineParMap(int, int);
+/* The consumer end of int -> char* maps on multiple threads */
+DefineParMap(int, string);
+/* The consumer end of uint32_t -> uint32_t maps on multiple threads */
+DefineParMap(uint32_t, uint32_t);
+
+/* Implement `IterInstrument` struct for int iterables */
+DefineIterInstrument(int);
+/* Implement `IterInstrument` struct for StrView iterables */
+DefineIterInstrument(StrView);
+/* Arrays of collected int elements */
+DefineVec(int);
+/* Arrays of collected char* elements */
+DefineVec(string);
+/* Deduplicated int iterables */
+DefineDistinct(int);
+/* Deduplicated char* iterables */
+DefineDistinct(string);
+/* Numbers of elements by int keys */
+DefineCounts(int);
+/* Numbers of elements by char* keys */
+DefineCounts(string);
+/* int elements grouped by int keys */
+DefineGroups(int, int);
+/* char* elements grouped by int keys */
+DefineGroups(string, int);
+/* Merges of sorted int iterables */
+DefineMerge(int);
+/* Merges of sorted StrView iterables */
+DefineMerge(StrView);
+/* Cursors over a buffer of int elements */
+DefineTee(int);
+/* Cursors over a buffer of StrView elements */
+DefineTee(StrView);
+
+/* Comparisons the `count_if_` sinks support - counting the elements for which `element op value` holds */
+typedef enum
+{
+    CMP_EQ,
+    CMP_NE,
+    CMP_LT,
+    CMP_LE,
+    CMP_GT,
+    CMP_GE
+} CmpOp;
+
+/*
+Reductions over any iterable yielding int (`_intit`) or uint32_t (`_u32it`)
+
+These run vectorized kernels (see `simd.h`) over the span of array backed iterables, and over batches staged in a
+buffer of `ITER_BATCH_SIZE` elements for everything else. Sums and dot products wrap around on overflow
+*/
 
 /* Generic function to sum values from any iterable yielding int */
 int sum_intit(Iterable(int) it);
+uint32_t sum_u32it(Iterable(uint32_t) it);
+/* Smallest and largest values from any iterable, `Nothing` if it's empty */
+Maybe(int) min_intit(Iterable(int) it);
+Maybe(uint32_t) min_u32it(Iterable(uint32_t) it);
+Maybe(int) max_intit(Iterable(int) it);
+Maybe(uint32_t) max_u32it(Iterable(uint32_t) it);
+/* Number of values from any iterable for which `x op value` holds */
+size_t count_if_intit(Iterable(int) it, CmpOp op, int value);
+size_t count_if_u32it(Iterable(uint32_t) it, CmpOp op, uint32_t value);
+/* Sum of the products of the values from two iterables, pairwise - stops at the end of the shorter one */
+int dot_intit(Iterable(int) a, Iterable(int) b);
+uint32_t dot_u32it(Iterable(uint32_t) a, Iterable(uint32_t) b);
 
 /* Generic function to print values from any iterable yielding string */
 void print_strit(Iterable(string) it);
 
+/* Generic function to sum values from any iterable yielding int, on `nthreads` threads if it can be split */
+int par_sum_intit(Iterable(int) it, size_t nthreads);
+
+/* Fold an int iterable into an int, on `nthreads` threads if it can be split */
+int par_fold_of(int, int)(Iterable(int) it, int init, int (*fold)(int acc, int x), int (*combine)(int a, int b),
+                          size_t nthreads);
+int par_reduce_of(int, int)(Iterable(int) it, int init, int (*reduce)(int acc, Iterable(int) task),
+                            int (*combine)(int a, int b), size_t nthreads);
+
+/* Read an int iterable ahead on a background thread, at most `capacity` elements ahead */
+Iterable(int) readahead_of(int)(Iterable(int) it, size_t capacity);
+void free_readahead_of(int)(Iterable(int) it);
+
+/* Map a function over an iterable on `nthreads` threads, keeping the order of the elements */
+Iterable(int) par_map_of(int, int)(Iterable(int) it, int (*fn)(int x), size_t nthreads);
+Iterable(string) par_map_of(int, string)(Iterable(int) it, string (*fn)(int x), size_t nthreads);
+Iterable(uint32_t) par_map_of(uint32_t, uint32_t)(Iterable(uint32_t) it, uint32_t (*fn)(uint32_t x), size_t nthreads);
+void free_par_map_of(int, int)(Iterable(int) it);
+void free_par_map_of(int, string)(Iterable(string) it);
+void free_par_map_of(uint32_t, uint32_t)(Iterable(uint32_t) it);
+
+/* Collect an iterable into an array on the heap, or into a buffer */
+Vec(int) collect_vec_of(int)(Iterable(int) it);
+Vec(string) collect_vec_of(string)(Iterable(string) it);
+size_t collect_into_of(int)(Iterable(int) it, int* buf, size_t cap);
+size_t collect_into_of(string)(Iterable(string) it, string* buf, size_t cap);
+
+/* Deduplicate an iterable, or count or group its elements by key, in a hash table */
+Iterable(int) distinct_of(int)(Iterable(int) it, HashFn hash, HashEq eq, size_t cap);
+Iterable(string) distinct_of(string)(Iterable(string) it, HashFn hash, HashEq eq, size_t cap);
+void free_distinct_of(int)(Iterable(int) it);
+void free_distinct_of(string)(Iterable(string) it);
+Counts(int) count_by_of(int, int)(Iterable(int) it, int (*key)(int x), HashFn hash, HashEq eq, size_t cap);
+Counts(string) count_by_of(string, string)(Iterable(string) it, string (*key)(string x), HashFn hash, HashEq eq,
+                                           size_t cap);
+Groups(int, int) group_by_of(int, int)(Iterable(int) it, int (*key)(int x), HashFn hash, HashEq eq, size_t cap);
+Groups(string, int) group_by_of(string, int)(Iterable(string) it, int (*key)(string x), HashFn hash, HashEq eq,
+                                             size_t cap);
+
+/* Merge `k` iterables, each sorted by `cmp`, into one sorted iterable - and free the merge */
+Iterable(int) merge_sorted_of(int)(Iterable(int) const* its, size_t k, MergeCmp cmp, bool dedup);
+Iterable(StrView) merge_sorted_of(StrView)(Iterable(StrView) const* its, size_t k, MergeCmp cmp, bool dedup);
+void free_merge_of(int)(Iterable(int) it);
+void free_merge_of(StrView)(Iterable(StrView) it);
+
+/* Split an iterable into `n` cursors that each yield all of its elements, or cache it for replays */
+void tee_of(int)(Iterable(int) it, size_t n, Iterable(int)* out);
+void tee_of(StrView)(Iterable(StrView) it, size_t n, Iterable(StrView)* out);
+Iterable(int) cache_of(int)(Iterable(int) it);
+Iterable(StrView) cache_of(StrView)(Iterable(StrView) it);
+Iterable(int) cache_replay_of(int)(Iterable(int) it);
+Iterable(StrView) cache_replay_of(StrView)(Iterable(StrView) it);
+void free_tee_of(int)(Iterable(int) it);
+void free_tee_of(StrView)(Iterable(StrView) it);
+
 /* Make an iterable of the first n elements of given iterable */
+Iterable(int) prep_itertake_of(int)(IterTake(int) * x);
 Iterable(uint32_t) prep_itertake_of(uint32_t)(IterTake(uint32_t) * x);
+Iterable(StrView) prep_itertake_of(StrView)(IterTake(StrView) * x);
+/* Make an iterable of the elements after the first n of given iterable */
+Iterable(int) prep_iterskip_of(int)(IterSkip(int) * x);
+Iterable(uint32_t) prep_iterskip_of(uint32_t)(IterSkip(uint32_t) * x);
+Iterable(StrView) prep_iterskip_of(StrView)(IterSkip(StrView) * x);
 Iterable(int) prep_itermap_of(int, int)(IterMap(int, int) * x);
 Iterable(string) prep_itermap_of(int, string)(IterMap(int, string) * x);
+Iterable(int) prep_itermap_of(StrView, int)(IterMap(StrView, int) * x);
+Iterable(StrView) prep_itermaparena_of(int)(IterMapArena(int) * x);
+Iterable(int) prep_iterfilter_of(int)(IterFilter(int) * x);
+Iterable(uint32_t) prep_iterfilter_of(uint32_t)(IterFilter(uint32_t) * x);
+Iterable(StrView) prep_iterfilter_of(StrView)(IterFilter(StrView) * x);
+Iterable(int) prep_iterinstrument_of(int)(IterInstrument(int) * x);
+Iterable(StrView) prep_iterinstrument_of(StrView)(IterInstrument(StrView) * x);
 
 #endif /* !IT_ITRBLE_UTILS_H */
@@ -1,6 +1,7 @@
 #ifndef IT_MAP_H
 #define IT_MAP_H
 
+#include "arena.h"
 #include "iterable_utils.h"
 
 #define IterMap(ElmntType, FnRetType) IterMap##ElmntType##FnRetType
@@ -20,22 +21,132 @@
 #define map_over(it, fn, ElmntType, FnRetType)                                                                         \
     prep_itermap_of(ElmntType, FnRetType)(&(IterMap(ElmntType, FnRetType)){.mapfn = fn, .src = it})
 
+/* Same as `map_over`, but the `IterMap` is stored in given `IterArena*` - so the iterable can outlive the scope */
+#define arena_map_over(arena, it, fn, ElmntType, FnRetType)                                                            \
+    prep_itermap_of(ElmntType, FnRetType)(arena_new(arena, IterMap(ElmntType, FnRetType), .mapfn = fn, .src = it))
+
 /*
 Define the iterator implementation function for an IterMap struct
 Also define a function with the given `Name` - which takes in an iterable and a function to map over said iterable,
 wraps said iterable and function in an `IterMap` struct and wraps that around its `Iterable` impl
+
+Batches are pulled from the source iterable into a staging buffer of `ITER_BATCH_SIZE` elements and mapped in place
+Mapping doesn't change the number of elements, so the size hint is just the source's hint
+The map can be split whenever the source can - the front half maps the same function over the source's front half
+Skipping elements is forwarded to the source iterable - the function isn't called on the skipped elements
 */
 #define define_itermap_func(ElmntType, FnRetType)                                                                      \
     static Maybe(FnRetType) CONCAT(IterMap(ElmntType, FnRetType), _nxt)(IterMap(ElmntType, FnRetType) * self)          \
     {                                                                                                                  \
         Iterable(ElmntType) const srcit = self->src;                                                                   \
         Maybe(ElmntType) res            = srcit.tc->next(srcit.self);                                                  \
-        if (is_nothing(res)) {                                                                                         \
+        if (is_nothing_of(res, ElmntType)) {                                                                           \
             return Nothing(FnRetType);                                                                                 \
         }                                                                                                              \
         return Just(self->mapfn(from_just_(res)), FnRetType);                                                          \
     }                                                                                                                  \
-    impl_iterator(IterMap(ElmntType, FnRetType)*, FnRetType, prep_itermap_of(ElmntType, FnRetType),                    \
-                  CONCAT(IterMap(ElmntType, FnRetType), _nxt))
+    static size_t CONCAT(IterMap(ElmntType, FnRetType), _batch)(IterMap(ElmntType, FnRetType) * self, FnRetType * out, \
+                                                                size_t cap)                                            \
+    {                                                                                                                  \
+        ElmntType buf[ITER_BATCH_SIZE];                                                                                \
+        size_t const n = iter_next_batch(self->src, buf, cap < ITER_BATCH_SIZE ? cap : ITER_BATCH_SIZE, ElmntType);    \
+        for (size_t i = 0; i < n; i++) {                                                                               \
+            out[i] = self->mapfn(buf[i]);                                                                              \
+        }                                                                                                              \
+        return n;                                                                                                      \
+    }                                                                                                                  \
+    static SizeHint CONCAT(IterMap(ElmntType, FnRetType), _hint)(IterMap(ElmntType, FnRetType) * self)                 \
+    {                                                                                                                  \
+        return iter_size_hint(self->src, ElmntType);                                                                   \
+    }                                                                                                                  \
+    static size_t CONCAT(IterMap(ElmntType, FnRetType), _advance)(IterMap(ElmntType, FnRetType) * self, size_t n)      \
+    {                                                                                                                  \
+        return iter_advance_by(self->src, n, ElmntType);                                                               \
+    }                                                                                                                  \
+    static IterMap(ElmntType, FnRetType) *                                                                             \
+        CONCAT(IterMap(ElmntType, FnRetType), _split)(IterMap(ElmntType, FnRetType) * self, Allocator alloc)           \
+    {                                                                                                                  \
+        Iterable(ElmntType) front;                                                                                     \
+        if (!iter_split(self->src, alloc, &front, ElmntType)) {                                                        \
+            return NULL;                                                                                               \
+        }                                                                                                              \
+        return alloc_new(alloc, IterMap(ElmntType, FnRetType), .mapfn = self->mapfn, .src = front);                    \
+    }                                                                                                                  \
+    impl_next_batch(IterMap(ElmntType, FnRetType)*, FnRetType, CONCAT(IterMap(ElmntType, FnRetType), _batch))          \
+    impl_size_hint(IterMap(ElmntType, FnRetType)*, CONCAT(IterMap(ElmntType, FnRetType), _hint))                       \
+    impl_advance_by(IterMap(ElmntType, FnRetType)*, CONCAT(IterMap(ElmntType, FnRetType), _advance))                   \
+    impl_split(IterMap(ElmntType, FnRetType)*, CONCAT(IterMap(ElmntType, FnRetType), _split))                          \
+    impl_iterator_with(IterMap(ElmntType, FnRetType)*, FnRetType, prep_itermap_of(ElmntType, FnRetType),               \
+                       CONCAT(IterMap(ElmntType, FnRetType), _nxt),                                                    \
+                       iter_slot(next_batch, CONCAT(IterMap(ElmntType, FnRetType), _batch)),                           \
+                       iter_slot(size_hint, CONCAT(IterMap(ElmntType, FnRetType), _hint)),                             \
+                       iter_slot(advance_by, CONCAT(IterMap(ElmntType, FnRetType), _advance)),                         \
+                       iter_slot(split, CONCAT(IterMap(ElmntType, FnRetType), _split)))
+
+#define IterMapArena(ElmntType) IterMapArena##ElmntType
+
+#define DefineIterMapArena(ElmntType)                                                                                  \
+    typedef struct                                                                                                     \
+    {                                                                                                                  \
+        StrView (*const mapfn)(ElmntType x, IterArena* arena);                                                         \
+        IterArena* const dst;                                                                                          \
+        Iterable(ElmntType) const src;                                                                                 \
+    } IterMapArena(ElmntType)
+
+/* Name of the function that wraps an IterMapArena(ElmntType) for given ElmntType into an iterable */
+#define prep_itermaparena_of(ElmntType) CONCAT(CONCAT(prep_, IterMapArena(ElmntType)), _itr)
+
+/*
+Map the function `fn` of type `StrView (*)(ElmntType, IterArena*)` over `it` to make a new `Iterable(StrView)` - `fn`
+allocates the chars of each string it builds from given `IterArena*`, and returns a view of them (e.g `arena_fmt_int`)
+
+Nothing is freed per element - the views stay valid until the arena is reset (e.g once a batch of them has been
+consumed) or freed, which releases all of them at once
+*/
+#define map_into_arena(it, fn, arena, ElmntType)                                                                       \
+    prep_itermaparena_of(ElmntType)(&(IterMapArena(ElmntType)){.mapfn = fn, .dst = arena, .src = it})
+
+/*
+Define the iterator implementation function for an IterMapArena struct
+
+Batches are pulled from the source iterable into a staging buffer of `ITER_BATCH_SIZE` elements, and each one is
+mapped into the arena. The size hint is the source's hint. Skipping elements is forwarded to the source iterable,
+without mapping them. Splitting isn't supported - the arena isn't thread safe
+*/
+#define define_itermaparena_func(ElmntType)                                                                            \
+    static Maybe(StrView) CONCAT(IterMapArena(ElmntType), _nxt)(IterMapArena(ElmntType) * self)                        \
+    {                                                                                                                  \
+        Iterable(ElmntType) const srcit = self->src;                                                                   \
+        Maybe(ElmntType) res            = srcit.tc->next(srcit.self);                                                  \
+        if (is_nothing_of(res, ElmntType)) {                                                                           \
+            return Nothing(StrView);                                                                                   \
+        }                                                                                                              \
+        return Just(self->mapfn(from_just_(res), self->dst), StrView);                                                 \
+    }                                                                                                                  \
+    static size_t CONCAT(IterMapArena(ElmntType), _batch)(IterMapArena(ElmntType) * self, StrView * out, size_t cap)   \
+    {                                                                                                                  \
+        ElmntType buf[ITER_BATCH_SIZE];                                                                                \
+        size_t const n = iter_next_batch(self->src, buf, cap < ITER_BATCH_SIZE ? cap : ITER_BATCH_SIZE, ElmntType);    \
+        for (size_t i = 0; i < n; i++) {                                                                               \
+            out[i] = self->mapfn(buf[i], self->dst);                                                                   \
+        }                                                                                                              \
+        return n;                                                                                                      \
+    }                                                                                                                  \
+    static SizeHint CONCAT(IterMapArena(ElmntType), _hint)(IterMapArena(ElmntType) * self)                             \
+    {                                                                                                                  \
+        return iter_size_hint(self->src, ElmntType);                                                                   \
+    }                                                                                                                  \
+    static size_t CONCAT(IterMapArena(ElmntType), _advance)(IterMapArena(ElmntType) * self, size_t n)                  \
+    {                                                                                                                  \
+        return iter_advance_by(self->src, n, ElmntType);                                                               \
+    }                                                                                                                  \
+    impl_next_batch(IterMapArena(ElmntType)*, StrView, CONCAT(IterMapArena(ElmntType), _batch))                        \
+    impl_advance_by(IterMapArena(ElmntType)*, CONCAT(IterMapArena(ElmntType), _advance))                               \
+    impl_size_hint(IterMapArena(ElmntType)*, CONCAT(IterMapArena(ElmntType), _hint))                                   \
+    impl_iterator_with(IterMapArena(ElmntType)*, StrView, prep_itermaparena_of(ElmntType),                             \
+                       CONCAT(IterMapArena(ElmntType), _nxt),                                                          \
+                       iter_slot(next_batch, CONCAT(IterMapArena(ElmntType), _batch)),                                 \
+                       iter_slot(size_hint, CONCAT(IterMapArena(ElmntType), _hint)),                                   \
+                       iter_slot(advance_by, CONCAT(IterMapArena(ElmntType), _advance)))
 
 #endif /* !IT_MAP_H */
@@ -0,0 +1,268 @@
+#include "merge.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* A source of a merge, and the buffer of its heads - the next one is at `head`, the buffered ones end at `end` */
+typedef struct
+{
+    unsigned char* buf;
+    unsigned char* head;
+    unsigned char* end;
+    /* Set once the source is exhausted - it then loses every match */
+    bool done;
+} MergeSource;
+
+struct MergeTree
+{
+    /*
+    The loser tree - source `s` is leaf `k + s`, and node `i` (for `0 < i < k`) plays the winners of nodes `2i` and
+    `2i + 1`. `tree[i]` is the source that lost the match at node `i`, `tree[0]` the source that won the final
+    */
+    size_t* tree;
+    size_t k;
+    bool built;
+    MergeSource* sources;
+    /* The buffers of the sources' heads, `ITER_BATCH_SIZE` elements each */
+    unsigned char* heads;
+    /* The copies of the source iterables, `src_size` bytes each */
+    unsigned char* srcs;
+    size_t src_size;
+    size_t elem_size;
+    MergeFill fill;
+    MergeHint hint;
+    MergeCmp cmp;
+    /* For a dedup merge, the last element yielded - if any */
+    bool dedup;
+    bool has_last;
+    unsigned char* last;
+};
+
+static void* merge_malloc(size_t size)
+{
+    void* const mem = malloc(size == 0 ? 1 : size);
+    if (mem == NULL) {
+        fprintf(stderr, "OOM in merge_sorted");
+        exit(1);
+    }
+    return mem;
+}
+
+int cmp_int(void const* a, void const* b)
+{
+    int const x = *(int const*)a;
+    int const y = *(int const*)b;
+    return (x > y) - (x < y);
+}
+
+int cmp_strview(void const* a, void const* b)
+{
+    StrView const* const x = a;
+    StrView const* const y = b;
+    size_t const len       = x->len < y->len ? x->len : y->len;
+    int const res          = len == 0 ? 0 : memcmp(x->ptr, y->ptr, len);
+    return res != 0 ? res : (x->len > y->len) - (x->len < y->len);
+}
+
+MergeTree* merge_tree_new(void const* srcs, size_t k, size_t src_size, MergeFill fill, MergeHint hint, size_t elem_size,
+                          MergeCmp cmp, bool dedup)
+{
+    if (k > SIZE_MAX / 2 / (ITER_BATCH_SIZE * elem_size)) {
+        fprintf(stderr, "OOM in merge_sorted");
+        exit(1);
+    }
+    MergeTree* const tree = merge_malloc(sizeof(*tree));
+    *tree = (MergeTree){.tree      = merge_malloc(k * sizeof(size_t)),
+                        .k         = k,
+                        .built     = false,
+                        .sources   = merge_malloc(k * sizeof(MergeSource)),
+                        .heads     = merge_malloc(k * ITER_BATCH_SIZE * elem_size),
+                        .srcs      = merge_malloc(k * src_size),
+                        .src_size  = src_size,
+                        .elem_size = elem_size,
+                        .fill      = fill,
+                        .hint      = hint,
+                        .cmp       = cmp,
+                        .dedup     = dedup,
+                        .has_last  = false,
+                        .last      = merge_malloc(elem_size)};
+    memcpy(tree->srcs, srcs, k * src_size);
+    for (size_t s = 0; s < k; s++) {
+        unsigned char* const buf = tree->heads + s * ITER_BATCH_SIZE * elem_size;
+        tree->sources[s]         = (MergeSource){.buf = buf, .head = buf, .end = buf, .done = false};
+    }
+    return tree;
+}
+
+/* Pull the next batch of heads out of source `s`, marking it done if it has none left */
+static void merge_refill(MergeTree* tree, size_t s)
+{
+    MergeSource* const src = tree->sources + s;
+    size_t const n         = tree->fill(tree->srcs + s * tree->src_size, src->buf, ITER_BATCH_SIZE);
+    src->head              = src->buf;
+    src->end               = src->buf + n * tree->elem_size;
+    src->done              = n == 0;
+}
+
+/*
+Whether source `a` wins a match against source `b`, by `cmp` - the smaller head wins, ties go to the source that comes
+first
+*/
+static inline bool merge_beats(MergeTree const* tree, MergeCmp cmp, size_t a, size_t b)
+{
+    MergeSource const* const x = tree->sources + a;
+    MergeSource const* const y = tree->sources + b;
+    if (x->done || y->done) {
+        return !x->done || (y->done && a < b);
+    }
+    int const res = cmp(x->head, y->head);
+    return res < 0 || (res == 0 && a < b);
+}
+
+/* Fill every source's heads, and play every match bottom up */
+static void merge_build(MergeTree* tree)
+{
+    size_t const k = tree->k;
+    for (size_t s = 0; s < k; s++) {
+        merge_refill(tree, s);
+    }
+    /* The winners of the matches at each node, and at each leaf (i.e the sources themselves) */
+    size_t* const winners = merge_malloc(2 * k * sizeof(size_t));
+    for (size_t s = 0; s < k; s++) {
+        winners[k + s] = s;
+    }
+    for (size_t i = k - 1; i > 0; i--) {
+        size_t const a = winners[2 * i];
+        size_t const b = winners[2 * i + 1];
+        bool const won = merge_beats(tree, tree->cmp, a, b);
+        winners[i]     = won ? a : b;
+        tree->tree[i]  = won ? b : a;
+    }
+    tree->tree[0] = winners[1];
+    free(winners);
+    tree->built = true;
+}
+
+/* Replay the matches from the leaf of source `s`, whose head has changed, up to the root */
+static inline void merge_replay(MergeTree* tree, MergeCmp cmp, size_t s)
+{
+    size_t* const nodes = tree->tree;
+    size_t winner       = s;
+    for (size_t i = (tree->k + s) / 2; i > 0; i /= 2) {
+        size_t const loser = nodes[i];
+        if (merge_beats(tree, cmp, loser, winner)) {
+            nodes[i] = winner;
+            winner   = loser;
+        }
+    }
+    nodes[0] = winner;
+}
+
+/* Copy an element of `size` bytes - with a constant size for the common ones, so it's a plain load and store */
+static inline void merge_copy(void* dst, void const* src, size_t size)
+{
+    switch (size) {
+        case 4:
+            memcpy(dst, src, 4);
+            break;
+        case 8:
+            memcpy(dst, src, 8);
+            break;
+        case 16:
+            memcpy(dst, src, 16);
+            break;
+        default:
+            memcpy(dst, src, size);
+    }
+}
+
+/*
+Copy up to `cap` of the next elements of the merge into `out`, comparing them with `cmp` (the merge's own) - which is
+called directly, so it's inlined when this is called with a known function
+*/
+static inline size_t merge_read_with(MergeTree* tree, MergeCmp cmp, void* out, size_t cap)
+{
+    size_t const es          = tree->elem_size;
+    unsigned char* const dst = out;
+    /* The element a dedup merge compares against - the last one copied into `out`, once there is one */
+    void const* last = tree->has_last ? tree->last : NULL;
+    size_t n         = 0;
+    while (n < cap) {
+        size_t const s         = tree->tree[0];
+        MergeSource* const src = tree->sources + s;
+        if (src->done) {
+            /* The winner only runs out when every source has */
+            break;
+        }
+        if (!tree->dedup || last == NULL || cmp(last, src->head) != 0) {
+            merge_copy(dst + n * es, src->head, es);
+            last = dst + n * es;
+            n++;
+        }
+        src->head += es;
+        if (src->head == src->end) {
+            merge_refill(tree, s);
+        }
+        merge_replay(tree, cmp, s);
+    }
+    if (tree->dedup && n != 0) {
+        memcpy(tree->last, last, es);
+        tree->has_last = true;
+    }
+    return n;
+}
+
+size_t merge_tree_read(MergeTree* tree, void* out, size_t cap)
+{
+    if (tree->k == 0) {
+        return 0;
+    }
+    if (!tree->built) {
+        merge_build(tree);
+    }
+    /* Ints in their natural order are compared inline, rather than through a call per match */
+    if (tree->cmp == cmp_int) {
+        return merge_read_with(tree, cmp_int, out, cap);
+    }
+    return merge_read_with(tree, tree->cmp, out, cap);
+}
+
+/* `a + b`, or `SIZE_MAX` if that overflows */
+static size_t merge_add(size_t a, size_t b) { return a > SIZE_MAX - b ? SIZE_MAX : a + b; }
+
+SizeHint merge_tree_hint(MergeTree* tree)
+{
+    size_t lower = 0;
+    size_t upper = 0;
+    bool bounded = true;
+    for (size_t s = 0; s < tree->k; s++) {
+        MergeSource const* const src = tree->sources + s;
+        size_t const ahead           = (size_t)(src->end - src->head) / tree->elem_size;
+        SizeHint const sh            = src->done ? size_hint_exact(0) : tree->hint(tree->srcs + s * tree->src_size);
+        lower                        = merge_add(lower, merge_add(sh.lower, ahead));
+        bounded                      = bounded && is_just_of(sh.upper, size_t);
+        if (bounded) {
+            size_t const left = merge_add(from_just_(sh.upper), ahead);
+            bounded           = left != SIZE_MAX && upper <= SIZE_MAX - 1 - left;
+            upper += left;
+        }
+    }
+    if (tree->dedup) {
+        /* Everything left may be a duplicate of the last element yielded, or of the first one left */
+        lower = lower != 0 && !tree->has_last ? 1 : 0;
+    }
+    return (SizeHint){.lower = lower, .upper = bounded ? Just(upper, size_t) : Nothing(size_t)};
+}
+
+void merge_tree_free(MergeTree* tree)
+{
+    free(tree->heads);
+    free(tree->sources);
+    free(tree->srcs);
+    free(tree->tree);
+    free(tree->last);
+    free(tree);
+}
@@ -0,0 +1,136 @@
+#ifndef IT_MERGE_H
+#define IT_MERGE_H
+
+#include "../func_iter.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+Utilities to merge several sorted iterables into one sorted iterable
+
+`merge_sorted` merges `k` iterables, each sorted by the same comparison function, in a loser tree - a tournament tree
+whose internal nodes remember the source that lost the match played there, and whose root remembers the overall winner.
+Yielding an element only replays the matches on the path from the winner's leaf to the root, so it takes `log2(k)`
+comparisons - rather than the `k - 1` of scanning every source's head, or the `k - 1` adapters an element goes through
+when 2-way merges are chained pairwise.
+
+Every source has a buffer of heads, which is refilled `ITER_BATCH_SIZE` elements at a time (see `iter_next_batch`) - so
+the calls to the sources are amortized over a batch too. Ties go to the source that comes first, so the merge is
+stable. `merge_sorted_dedup` also drops every element that compares equal to the one yielded before it - i.e, as the
+sources are sorted, it yields each distinct element once.
+
+The comparison function has the signature of `qsort`'s, `cmp_int` and `cmp_strview` compare ints and StrViews in their
+natural (lexicographic, for StrViews) order. The source iterables are copied, and only touched by the merge from then
+on - whatever their `self`s point to must outlive it. The merge lives on the heap, and must be freed with `free_merge`.
+
+Example-
+
+Iterable(int) shards[3] = {arr_into_iter(a, na, int), arr_into_iter(b, nb, int), arr_into_iter(c, nc, int)};
+Iterable(int) it        = merge_sorted(shards, 3, cmp_int, int);
+...
+free_merge(it, int);
+*/
+
+/* The state of a merge - the sources, the buffers of their heads and the loser tree over them */
+typedef struct MergeTree MergeTree;
+
+/* Compare the elements at `a` and `b` - negative if `a` goes first, positive if `b` does, zero if they're equal */
+typedef int (*MergeCmp)(void const* a, void const* b);
+
+/* Pull up to `cap` elements out of the source iterable at `src` into `out`, returns how many were pulled */
+typedef size_t (*MergeFill)(void* src, void* out, size_t cap);
+
+/* Size hint of the source iterable at `src` */
+typedef SizeHint (*MergeHint)(void* src);
+
+/* Compare two ints, or two StrViews, in their natural order - for `merge_sorted` (or `qsort`) */
+int cmp_int(void const* a, void const* b);
+int cmp_strview(void const* a, void const* b);
+
+/*
+Make a merge of the `k` source iterables, of `src_size` bytes each, in the array at `srcs` - whose elements, of
+`elem_size` bytes each, are pulled out with `fill` and ordered by `cmp`
+
+The sources are copied into the merge, `fill` and `hint` are called with a pointer to a copy. If `dedup` is set,
+elements that compare equal to the one yielded before them are dropped. Exits on OOM
+*/
+MergeTree* merge_tree_new(void const* srcs, size_t k, size_t src_size, MergeFill fill, MergeHint hint, size_t elem_size,
+                          MergeCmp cmp, bool dedup);
+
+/* Copy up to `cap` of the next elements of the merge into `out` - returns how many were copied, 0 once it's over */
+size_t merge_tree_read(MergeTree* tree, void* out, size_t cap);
+
+/* Number of elements left in the merge - the buffered heads, and what the sources have left */
+SizeHint merge_tree_hint(MergeTree* tree);
+
+/* Free the merge, and the copies of the sources in it */
+void merge_tree_free(MergeTree* tree);
+
+#define Merge(T) Merge##T
+
+/* A merge of iterables of `T`s */
+#define DefineMerge(T) typedef MergeTree Merge(T)
+
+/* Name of the function that merges sorted `Iterable(T)`s */
+#define merge_sorted_of(T) CONCAT(merge_sorted_, T)
+
+/* Name of the function that frees a merge built by `merge_sorted_of(T)` */
+#define free_merge_of(T) CONCAT(free_merge_, T)
+
+/*
+Build an `Iterable(T)` that merges the `k` iterables in the array at `its`, each one sorted by `cmp`, into one sorted by
+`cmp` - keeping every element of every source
+
+The merge must be freed with `free_merge`
+*/
+#define merge_sorted(its, k, cmp, T) merge_sorted_of(T)(its, k, cmp, false)
+
+/* Same as `merge_sorted`, but each run of elements that compare equal is yielded as its first element only */
+#define merge_sorted_dedup(its, k, cmp, T) merge_sorted_of(T)(its, k, cmp, true)
+
+/* Free the merge behind given `it` iterable, built by `merge_sorted` or `merge_sorted_dedup` */
+#define free_merge(it, T) free_merge_of(T)(it)
+
+/*
+Define the `next`, `next_batch` and `size_hint` functions of `Merge(T)`, implement `Iterator` for it, and define
+`merge_sorted_of(T)` and `free_merge_of(T)`-
+
+Iterable(T) merge_sorted_of(T)(Iterable(T) const* its, size_t k, MergeCmp cmp, bool dedup);
+void free_merge_of(T)(Iterable(T) it);
+
+This should be called in a source file
+*/
+#define define_merge_func(T)                                                                                           \
+    static size_t CONCAT(Merge(T), _fill)(void* src, void* out, size_t cap)                                            \
+    {                                                                                                                  \
+        return iter_next_batch(*(Iterable(T)*)src, out, cap, T);                                                       \
+    }                                                                                                                  \
+    static SizeHint CONCAT(Merge(T), _srchint)(void* src) { return iter_size_hint(*(Iterable(T)*)src, T); }            \
+    static Maybe(T) CONCAT(Merge(T), _nxt)(Merge(T) * self)                                                            \
+    {                                                                                                                  \
+        T x;                                                                                                           \
+        if (merge_tree_read(self, &x, 1) == 0) {                                                                       \
+            return Nothing(T);                                                                                         \
+        }                                                                                                              \
+        return Just(x, T);                                                                                             \
+    }                                                                                                                  \
+    static size_t CONCAT(Merge(T), _batch)(Merge(T) * self, T * out, size_t cap)                                       \
+    {                                                                                                                  \
+        return merge_tree_read(self, out, cap);                                                                        \
+    }                                                                                                                  \
+    static SizeHint CONCAT(Merge(T), _hint)(Merge(T) * self) { return merge_tree_hint(self); }                         \
+    impl_next_batch(Merge(T)*, T, CONCAT(Merge(T), _batch))                                                            \
+    impl_size_hint(Merge(T)*, CONCAT(Merge(T), _hint))                                                                 \
+    impl_default_next_into(Merge(T)*, T, CONCAT(Merge(T), _nxt))                                                       \
+    impl_iterator_with(Merge(T)*, T, CONCAT(prep_, Merge(T)), CONCAT(Merge(T), _nxt),                                  \
+                       iter_slot(next_batch, CONCAT(Merge(T), _batch)), iter_slot(size_hint, CONCAT(Merge(T), _hint)), \
+                       iter_default_into(CONCAT(Merge(T), _nxt)))                                                      \
+    Iterable(T) merge_sorted_of(T)(Iterable(T) const* its, size_t k, MergeCmp cmp, bool dedup)                         \
+    {                                                                                                                  \
+        return CONCAT(prep_, Merge(T))(merge_tree_new(its, k, sizeof(*its), CONCAT(Merge(T), _fill),                   \
+                                                      CONCAT(Merge(T), _srchint), sizeof(T), cmp, dedup));             \
+    }                                                                                                                  \
+    void free_merge_of(T)(Iterable(T) it) { merge_tree_free(it.self); }
+
+#endif /* !IT_MERGE_H */
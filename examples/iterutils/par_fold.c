@@ -0,0 +1,196 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "par_fold.h"
+
+#include "arena.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Size of the blocks of the arenas the workers store split off tasks in */
+#define PAR_ARENA_SIZE 4096
+
+/*
+A worker's tasks - the owner pushes and pops at the tail, thieves take from the head
+
+Tasks are at least `PAR_GRAIN` elements each, so a plain mutex is cheap in comparison
+*/
+typedef struct
+{
+    pthread_mutex_t lock;
+    ParTask* tasks;
+    size_t head;
+    size_t tail;
+    size_t cap;
+} ParDeque;
+
+typedef struct ParPool ParPool;
+
+typedef struct
+{
+    ParPool* pool;
+    size_t id;
+    ParDeque deque;
+    IterArena arena;
+    void* acc;
+} ParWorker;
+
+struct ParPool
+{
+    ParFoldOps const* ops;
+    ParWorker* workers;
+    size_t nworkers;
+    /* Guards `pending` - the number of tasks pushed, but not yet folded */
+    pthread_mutex_t lock;
+    size_t pending;
+};
+
+static void* par_malloc(size_t size)
+{
+    void* const mem = malloc(size);
+    if (mem == NULL) {
+        fprintf(stderr, "OOM in par_fold_run");
+        exit(1);
+    }
+    return mem;
+}
+
+static void deque_push(ParDeque* deque, ParTask task)
+{
+    pthread_mutex_lock(&deque->lock);
+    if (deque->tail == deque->cap) {
+        if (deque->head != 0) {
+            /* Reuse the space freed up by thieves */
+            memmove(deque->tasks, deque->tasks + deque->head, (deque->tail - deque->head) * sizeof(*deque->tasks));
+            deque->tail -= deque->head;
+            deque->head = 0;
+        } else {
+            size_t const cap     = deque->cap * 2;
+            ParTask* const tasks = realloc(deque->tasks, cap * sizeof(*tasks));
+            if (tasks == NULL) {
+                fprintf(stderr, "OOM in deque_push");
+                exit(1);
+            }
+            deque->tasks = tasks;
+            deque->cap   = cap;
+        }
+    }
+    deque->tasks[deque->tail++] = task;
+    pthread_mutex_unlock(&deque->lock);
+}
+
+/* Take a task from the tail (`own` is true) or the head of the deque, returns false if it's empty */
+static bool deque_take(ParDeque* deque, bool own, ParTask* out)
+{
+    pthread_mutex_lock(&deque->lock);
+    bool const found = deque->head != deque->tail;
+    if (found) {
+        *out = own ? deque->tasks[--deque->tail] : deque->tasks[deque->head++];
+        if (deque->head == deque->tail) {
+            deque->head = deque->tail = 0;
+        }
+    }
+    pthread_mutex_unlock(&deque->lock);
+    return found;
+}
+
+/* Find the next task for the worker - its own most recent one, or the oldest one of another worker */
+static bool find_task(ParWorker* self, ParTask* out)
+{
+    if (deque_take(&self->deque, true, out)) {
+        return true;
+    }
+    ParPool* const pool = self->pool;
+    for (size_t i = 1; i < pool->nworkers; i++) {
+        if (deque_take(&pool->workers[(self->id + i) % pool->nworkers].deque, false, out)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void* worker_loop(void* arg)
+{
+    ParWorker* const self       = arg;
+    ParPool* const pool         = self->pool;
+    ParFoldOps const* const ops = pool->ops;
+    while (1) {
+        ParTask task;
+        if (!find_task(self, &task)) {
+            pthread_mutex_lock(&pool->lock);
+            bool const done = pool->pending == 0;
+            pthread_mutex_unlock(&pool->lock);
+            if (done) {
+                return NULL;
+            }
+            sched_yield();
+            continue;
+        }
+        /* Split the task down to the grain, leaving the front halves for whoever gets to them first */
+        while (ops->remaining(task) >= 2 * PAR_GRAIN) {
+            void* const front = ops->split(task, arena_allocator(&self->arena));
+            if (front == NULL) {
+                break;
+            }
+            pthread_mutex_lock(&pool->lock);
+            pool->pending++;
+            pthread_mutex_unlock(&pool->lock);
+            deque_push(&self->deque, (ParTask){.self = front, .tc = task.tc});
+        }
+        ops->fold(ops->ctx, task, self->acc);
+        pthread_mutex_lock(&pool->lock);
+        pool->pending--;
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+void par_fold_run(ParFoldOps const* ops, ParTask root, size_t nthreads, void* acc)
+{
+    ParPool pool = {
+        .ops = ops, .workers = par_malloc(nthreads * sizeof(ParWorker)), .nworkers = nthreads, .pending = 1};
+    pthread_mutex_init(&pool.lock, NULL);
+    for (size_t i = 0; i < nthreads; i++) {
+        ParWorker* const w = &pool.workers[i];
+        *w                 = (ParWorker){
+            .pool  = &pool,
+            .id    = i,
+            .deque = {.tasks = par_malloc(16 * sizeof(ParTask)), .head = 0, .tail = 0, .cap = 16},
+            .arena = new_arena(PAR_ARENA_SIZE),
+            .acc   = memcpy(par_malloc(ops->acc_size), ops->init, ops->acc_size),
+        };
+        pthread_mutex_init(&w->deque.lock, NULL);
+    }
+    deque_push(&pool.workers[0].deque, root);
+
+    /* The calling thread is worker 0, the rest get a thread each - if one can't be spawned, the others take over */
+    pthread_t* const threads = par_malloc(nthreads * sizeof(pthread_t));
+    bool* const spawned      = par_malloc(nthreads * sizeof(bool));
+    for (size_t i = 1; i < nthreads; i++) {
+        spawned[i] = pthread_create(&threads[i], NULL, worker_loop, &pool.workers[i]) == 0;
+    }
+    worker_loop(&pool.workers[0]);
+    for (size_t i = 1; i < nthreads; i++) {
+        if (spawned[i]) {
+            pthread_join(threads[i], NULL);
+        }
+    }
+
+    memcpy(acc, pool.workers[0].acc, ops->acc_size);
+    for (size_t i = 0; i < nthreads; i++) {
+        ParWorker* const w = &pool.workers[i];
+        if (i != 0) {
+            ops->combine(ops->ctx, acc, w->acc);
+        }
+        pthread_mutex_destroy(&w->deque.lock);
+        free(w->deque.tasks);
+        free_arena(&w->arena);
+        free(w->acc);
+    }
+    pthread_mutex_destroy(&pool.lock);
+    free(spawned);
+    free(threads);
+    free(pool.workers);
+}
@@ -0,0 +1,165 @@
+#ifndef IT_PAR_FOLD_H
+#define IT_PAR_FOLD_H
+
+#include "../func_iter.h"
+#include "arena.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+Utilities to fold an iterable on multiple threads
+
+The iterable is split (see `iter_split`) into tasks of at most `2 * PAR_GRAIN` elements, which are folded by a pool of
+worker threads. Every worker keeps a deque of tasks - it splits the task it's working on and pushes the front halves
+onto its own deque, pops its next task off the same end (so the most recently split, cache warm, task is worked on
+first), and steals from the other end of another worker's deque once it runs dry. The state of the split off halves
+is stored in the worker's own `IterArena`, so there's no locking on allocation.
+
+Every worker folds its tasks into its own accumulator, which are combined once all tasks are done - so the `combine`
+function must be associative and commutative, and the initial accumulator must be its identity (e.g 0 for a sum).
+
+Iterables that don't implement `split` (or a single thread) are folded sequentially on the calling thread.
+
+Example-
+
+define_par_fold_func(int, long)
+...
+long total = par_fold_of(int, long)(it, 0, add_elmnt, add_acc, 4);
+*/
+
+/* Tasks with at least `2 * PAR_GRAIN` elements left are split further */
+#ifndef PAR_GRAIN
+#define PAR_GRAIN 4096
+#endif
+
+/* An `Iterable` with its element type erased */
+typedef struct
+{
+    void* self;
+    void const* tc;
+} ParTask;
+
+/* The element type specific operations of a parallel fold, as used by `par_fold_run` */
+typedef struct
+{
+    /* Split the front half off the task, returns its `self` (sharing the task's `tc`) or `NULL` */
+    void* (*const split)(ParTask task, Allocator alloc);
+    /* Lower bound on the number of elements left in the task */
+    size_t (*const remaining)(ParTask task);
+    /* Fold all elements of the task into the accumulator at `acc` */
+    void (*const fold)(void const* ctx, ParTask task, void* acc);
+    /* Combine the accumulator at `other` into the one at `acc` */
+    void (*const combine)(void const* ctx, void* acc, void const* other);
+    /* Passed to `fold` and `combine` */
+    void const* ctx;
+    /* The initial accumulator, `acc_size` bytes long */
+    void const* init;
+    size_t acc_size;
+} ParFoldOps;
+
+/* Fold `root` on `nthreads` threads (the calling thread being one of them), store the result in `acc` */
+void par_fold_run(ParFoldOps const* ops, ParTask root, size_t nthreads, void* acc);
+
+#define ParFold(ElmntType, AccType) ParFold##ElmntType##AccType
+
+/* Name of the function that folds an `Iterable(ElmntType)` into an `AccType` one element at a time, in parallel */
+#define par_fold_of(ElmntType, AccType) CONCAT(CONCAT(par_fold_, ElmntType), CONCAT(_, AccType))
+
+/* Name of the function that folds an `Iterable(ElmntType)` into an `AccType` one task at a time, in parallel */
+#define par_reduce_of(ElmntType, AccType) CONCAT(CONCAT(par_reduce_, ElmntType), CONCAT(_, AccType))
+
+/*
+Define `par_fold_of(ElmntType, AccType)` and `par_reduce_of(ElmntType, AccType)`-
+
+AccType par_fold_of(ElmntType, AccType)(Iterable(ElmntType) it, AccType init, AccType (*fold)(AccType acc, ElmntType x),
+                                        AccType (*combine)(AccType a, AccType b), size_t nthreads);
+
+AccType par_reduce_of(ElmntType, AccType)(Iterable(ElmntType) it, AccType init,
+                                          AccType (*reduce)(AccType acc, Iterable(ElmntType) task),
+                                          AccType (*combine)(AccType a, AccType b), size_t nthreads);
+
+`fold` is called for every element, while `reduce` is handed each task as a whole - so it can consume it with an
+existing sequential function (e.g `sum_intit`), which may take shortcuts such as `iter_as_span`
+
+This should be called in a source file
+*/
+#define define_par_fold_func(ElmntType, AccType)                                                                       \
+    typedef struct                                                                                                     \
+    {                                                                                                                  \
+        AccType (*const fold)(AccType acc, ElmntType x);                                                               \
+        AccType (*const reduce)(AccType acc, Iterable(ElmntType) task);                                                \
+        AccType (*const combine)(AccType a, AccType b);                                                                \
+    } ParFold(ElmntType, AccType);                                                                                     \
+    static void* CONCAT(ParFold(ElmntType, AccType), _split)(ParTask task, Allocator alloc)                            \
+    {                                                                                                                  \
+        Iterator(ElmntType) const* const tc = task.tc;                                                                 \
+        return tc->split(task.self, alloc);                                                                            \
+    }                                                                                                                  \
+    static size_t CONCAT(ParFold(ElmntType, AccType), _remaining)(ParTask task)                                        \
+    {                                                                                                                  \
+        Iterable(ElmntType) const it = {.self = task.self, .tc = task.tc};                                             \
+        return iter_size_hint(it, ElmntType).lower;                                                                    \
+    }                                                                                                                  \
+    static void CONCAT(ParFold(ElmntType, AccType), _fold)(void const* ctx, ParTask task, void* acc)                   \
+    {                                                                                                                  \
+        ParFold(ElmntType, AccType) const* const fns = ctx;                                                            \
+        Iterable(ElmntType) const it                 = {.self = task.self, .tc = task.tc};                             \
+        AccType res                                  = *(AccType*)acc;                                                 \
+        if (fns->reduce != NULL) {                                                                                     \
+            res = fns->reduce(res, it);                                                                                \
+        } else {                                                                                                       \
+            ElmntType buf[ITER_BATCH_SIZE];                                                                            \
+            for (size_t n = iter_next_batch(it, buf, ITER_BATCH_SIZE, ElmntType); n != 0;                              \
+                 n        = iter_next_batch(it, buf, ITER_BATCH_SIZE, ElmntType)) {                                    \
+                for (size_t i = 0; i < n; i++) {                                                                       \
+                    res = fns->fold(res, buf[i]);                                                                      \
+                }                                                                                                      \
+            }                                                                                                          \
+        }                                                                                                              \
+        *(AccType*)acc = res;                                                                                          \
+    }                                                                                                                  \
+    static void CONCAT(ParFold(ElmntType, AccType), _combine)(void const* ctx, void* acc, void const* other)           \
+    {                                                                                                                  \
+        ParFold(ElmntType, AccType) const* const fns = ctx;                                                            \
+        *(AccType*)acc                               = fns->combine(*(AccType*)acc, *(AccType const*)other);           \
+    }                                                                                                                  \
+    static AccType CONCAT(ParFold(ElmntType, AccType), _run)(Iterable(ElmntType) it, AccType init,                     \
+                                                             ParFold(ElmntType, AccType) const* fns, size_t nthreads)  \
+    {                                                                                                                  \
+        ParFoldOps const ops = {.split     = CONCAT(ParFold(ElmntType, AccType), _split),                              \
+                                .remaining = CONCAT(ParFold(ElmntType, AccType), _remaining),                          \
+                                .fold      = CONCAT(ParFold(ElmntType, AccType), _fold),                               \
+                                .combine   = CONCAT(ParFold(ElmntType, AccType), _combine),                            \
+                                .ctx       = fns,                                                                      \
+                                .init      = &init,                                                                    \
+                                .acc_size  = sizeof(AccType)};                                                         \
+        ParTask const root   = {.self = it.self, .tc = it.tc};                                                         \
+        AccType acc          = init;                                                                                   \
+        /* No point in spawning more threads than there are tasks to hand out */                                      \
+        size_t const ntasks = ops.remaining(root) / PAR_GRAIN;                                                         \
+        nthreads            = ntasks < nthreads ? ntasks : nthreads;                                                   \
+        if (it.tc->split == NULL || nthreads < 2) {                                                                    \
+            /* Can't be split, or nobody to share it with - fold it right here */                                     \
+            ops.fold(fns, root, &acc);                                                                                 \
+            return acc;                                                                                                \
+        }                                                                                                              \
+        par_fold_run(&ops, root, nthreads, &acc);                                                                      \
+        return acc;                                                                                                    \
+    }                                                                                                                  \
+    AccType par_fold_of(ElmntType, AccType)(Iterable(ElmntType) it, AccType init,                                      \
+                                            AccType (*fold)(AccType acc, ElmntType x),                                 \
+                                            AccType (*combine)(AccType a, AccType b), size_t nthreads)                 \
+    {                                                                                                                  \
+        ParFold(ElmntType, AccType) const fns = {.fold = fold, .reduce = NULL, .combine = combine};                    \
+        return CONCAT(ParFold(ElmntType, AccType), _run)(it, init, &fns, nthreads);                                    \
+    }                                                                                                                  \
+    AccType par_reduce_of(ElmntType, AccType)(Iterable(ElmntType) it, AccType init,                                    \
+                                              AccType (*reduce)(AccType acc, Iterable(ElmntType) task),                \
+                                              AccType (*combine)(AccType a, AccType b), size_t nthreads)               \
+    {                                                                                                                  \
+        ParFold(ElmntType, AccType) const fns = {.fold = NULL, .reduce = reduce, .combine = combine};                  \
+        return CONCAT(ParFold(ElmntType, AccType), _run)(it, init, &fns, nthreads);                                    \
+    }
+
+#endif /* !IT_PAR_FOLD_H */
@@ -0,0 +1,186 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "par_map.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* A slot of the window - a chunk of source elements, and the same elements mapped */
+typedef struct
+{
+    void* in;
+    void* out;
+    size_t len;
+    /* Whether `out` holds the mapped elements yet */
+    bool mapped;
+} ParMapChunk;
+
+/*
+Chunks are numbered in the order they're pulled out of the source - chunk `i` lives in slot `i % nchunks`
+
+Those before `consumed` have been handed out and released, `consumed` itself is the one handed out last (while
+`holding` is set). Those from `claimed` up to `submitted` are waiting for a thread to map them. Chunks are at least a
+few hundred elements each, so a plain mutex is cheap in comparison
+*/
+struct ParMapPool
+{
+    pthread_mutex_t lock;
+    /* Workers wait on `work_cond` for chunks to map, the consumer waits on `mapped_cond` for the chunk it needs */
+    pthread_cond_t work_cond;
+    pthread_cond_t mapped_cond;
+    ParMapChunk* chunks;
+    size_t nchunks;
+    size_t consumed;
+    size_t claimed;
+    size_t submitted;
+    bool holding;
+    bool exhausted;
+    bool stop;
+    ParMapOps ops;
+    void* src;
+    void* fn;
+    pthread_t* threads;
+    bool* spawned;
+    size_t nworkers;
+};
+
+static void* par_map_malloc(size_t size)
+{
+    void* const mem = malloc(size);
+    if (mem == NULL) {
+        fprintf(stderr, "OOM in par_map_start");
+        exit(1);
+    }
+    return mem;
+}
+
+/* Map the oldest chunk nobody has claimed yet - the lock must be held, it's released while mapping */
+static void map_claimed(ParMapPool* pool)
+{
+    ParMapChunk* const chunk = &pool->chunks[pool->claimed++ % pool->nchunks];
+    pthread_mutex_unlock(&pool->lock);
+    pool->ops.map(pool->fn, chunk->in, chunk->out, chunk->len);
+    pthread_mutex_lock(&pool->lock);
+    chunk->mapped = true;
+}
+
+static void* worker_loop(void* arg)
+{
+    ParMapPool* const pool = arg;
+    pthread_mutex_lock(&pool->lock);
+    while (1) {
+        while (!pool->stop && pool->claimed == pool->submitted) {
+            pthread_cond_wait(&pool->work_cond, &pool->lock);
+        }
+        if (pool->stop) {
+            break;
+        }
+        map_claimed(pool);
+        /* Only the consumer ever waits for a chunk to be mapped */
+        pthread_cond_signal(&pool->mapped_cond);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+ParMapPool* par_map_start(ParMapOps const* ops, void const* src, size_t src_size, void const* fn, size_t fn_size,
+                          size_t nthreads)
+{
+    nthreads               = nthreads == 0 ? 1 : nthreads;
+    size_t const nchunks   = nthreads * PAR_MAP_WINDOW;
+    ParMapPool* const pool = par_map_malloc(sizeof(*pool));
+    *pool                  = (ParMapPool){
+        .chunks   = par_map_malloc(nchunks * sizeof(ParMapChunk)),
+        .nchunks  = nchunks,
+        .ops      = *ops,
+        .src      = memcpy(par_map_malloc(src_size), src, src_size),
+        .fn       = memcpy(par_map_malloc(fn_size), fn, fn_size),
+        .threads  = par_map_malloc(nthreads * sizeof(pthread_t)),
+        .spawned  = par_map_malloc(nthreads * sizeof(bool)),
+        .nworkers = nthreads - 1,
+    };
+    for (size_t i = 0; i < nchunks; i++) {
+        pool->chunks[i] = (ParMapChunk){
+            .in  = par_map_malloc(PAR_MAP_CHUNK * ops->in_size),
+            .out = par_map_malloc(PAR_MAP_CHUNK * ops->out_size),
+        };
+    }
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_cond, NULL);
+    pthread_cond_init(&pool->mapped_cond, NULL);
+    for (size_t i = 0; i < pool->nworkers; i++) {
+        pool->spawned[i] = pthread_create(&pool->threads[i], NULL, worker_loop, pool) == 0;
+    }
+    return pool;
+}
+
+bool par_map_acquire(ParMapPool* pool, void const** out, size_t* len)
+{
+    pthread_mutex_lock(&pool->lock);
+    if (pool->holding) {
+        pool->consumed++;
+        pool->holding = false;
+    }
+    /* Top the window up - the source is only ever touched by this thread, so it's pulled from without the lock */
+    while (!pool->exhausted && pool->submitted - pool->consumed < pool->nchunks) {
+        ParMapChunk* const chunk = &pool->chunks[pool->submitted % pool->nchunks];
+        pthread_mutex_unlock(&pool->lock);
+        size_t const n = pool->ops.fill(pool->src, chunk->in, PAR_MAP_CHUNK);
+        pthread_mutex_lock(&pool->lock);
+        if (n == 0) {
+            pool->exhausted = true;
+            break;
+        }
+        chunk->len    = n;
+        chunk->mapped = false;
+        pool->submitted++;
+        pthread_cond_signal(&pool->work_cond);
+    }
+    if (pool->consumed == pool->submitted) {
+        pthread_mutex_unlock(&pool->lock);
+        return false;
+    }
+    ParMapChunk const* const chunk = &pool->chunks[pool->consumed % pool->nchunks];
+    while (!chunk->mapped) {
+        if (pool->claimed != pool->submitted) {
+            /* Rather than sit idle, help out with the chunks after it */
+            map_claimed(pool);
+        } else {
+            pthread_cond_wait(&pool->mapped_cond, &pool->lock);
+        }
+    }
+    pool->holding = true;
+    pthread_mutex_unlock(&pool->lock);
+    *out = chunk->out;
+    *len = chunk->len;
+    return true;
+}
+
+void par_map_stop(ParMapPool* pool)
+{
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = true;
+    pthread_cond_broadcast(&pool->work_cond);
+    pthread_mutex_unlock(&pool->lock);
+    for (size_t i = 0; i < pool->nworkers; i++) {
+        if (pool->spawned[i]) {
+            pthread_join(pool->threads[i], NULL);
+        }
+    }
+    pthread_cond_destroy(&pool->mapped_cond);
+    pthread_cond_destroy(&pool->work_cond);
+    pthread_mutex_destroy(&pool->lock);
+    for (size_t i = 0; i < pool->nchunks; i++) {
+        free(pool->chunks[i].in);
+        free(pool->chunks[i].out);
+    }
+    free(pool->chunks);
+    free(pool->src);
+    free(pool->fn);
+    free(pool->threads);
+    free(pool->spawned);
+    free(pool);
+}
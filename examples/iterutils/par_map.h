@@ -0,0 +1,202 @@
+#ifndef IT_PAR_MAP_H
+#define IT_PAR_MAP_H
+
+#include "../func_iter.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+Utilities to map a function over an iterable on multiple threads, keeping the order of the elements
+
+The consumer's thread pulls chunks of at most `PAR_MAP_CHUNK` elements out of the source (see `iter_next_batch`) into
+a window of `PAR_MAP_WINDOW` chunks per thread, and a pool of worker threads maps them - in the order they were
+pulled. The chunks are handed back out in that same order: the window doubles as the reorder buffer, a chunk mapped
+before the ones ahead of it just waits in there. A chunk's slot is only refilled once the consumer is done with it, so
+no more than the window's worth of elements is ever in flight - even for an infinite source.
+
+The calling thread is one of the `nthreads` - while the chunk it needs next is still being mapped, it maps the oldest
+chunk nobody has picked up yet. So a single thread maps everything on the calling thread, with no pool at all.
+
+The source iterable is only consumed by the adapter - it (and whatever its `self` points to) must outlive the adapter.
+`fn` is called on worker threads, so it must be safe to call concurrently.
+
+Example-
+
+Iterable(string) it = par_map_over(intit, inttostr, int, string, 4);
+foreach (string, s, it) {
+    ...
+}
+free_par_map(it, int, string);
+*/
+
+/* Number of elements mapped at once, by a single thread */
+#ifndef PAR_MAP_CHUNK
+#define PAR_MAP_CHUNK ITER_BATCH_SIZE
+#endif
+
+/* Number of chunks in flight - pulled out of the source, but not yet handed out - per thread */
+#ifndef PAR_MAP_WINDOW
+#define PAR_MAP_WINDOW 4
+#endif
+
+/* The element type specific operations of a parallel map, as used by the `par_map_` functions */
+typedef struct
+{
+    /* Pull up to `cap` elements out of the source iterable at `src` into `in`, returns how many were pulled */
+    size_t (*fill)(void* src, void* in, size_t cap);
+    /* Map the `n` elements at `in` into `out`, with the function at `fn` */
+    void (*map)(void const* fn, void const* in, void* out, size_t n);
+    /* Size of a source element, and of a mapped one */
+    size_t in_size;
+    size_t out_size;
+} ParMapOps;
+
+/* The window of chunks, and the worker threads mapping them */
+typedef struct ParMapPool ParMapPool;
+
+/*
+Start `nthreads - 1` worker threads (the consumer being the last one) mapping chunks of the source iterable
+
+The `src_size` bytes at `src` (the source iterable), and the `fn_size` bytes at `fn` (the function to map), are copied
+into the pool - `ops->fill` and `ops->map` are called with pointers to those copies. Exits on OOM. Workers that can't
+be spawned are left out, the consumer maps whatever they would have
+*/
+ParMapPool* par_map_start(ParMapOps const* ops, void const* src, size_t src_size, void const* fn, size_t fn_size,
+                          size_t nthreads);
+
+/*
+Release the chunk of mapped elements handed out by the previous call, and acquire the next one - in the source's order
+
+The chunk is stored in `out` (its number of elements in `len`), it stays in the pool until the next call. Returns
+`false`, with nothing acquired, once the source has been fully mapped and handed out
+*/
+bool par_map_acquire(ParMapPool* pool, void const** out, size_t* len);
+
+/* Stop the worker threads - once they're done with the chunk they're mapping, if any - and free the pool */
+void par_map_stop(ParMapPool* pool);
+
+#define ParMap(ElmntType, FnRetType) ParMap##ElmntType##FnRetType
+
+/* The consumer end of a parallel map - the chunk it's taking elements out of is from `curr` up to `end` */
+#define DefineParMap(ElmntType, FnRetType)                                                                             \
+    typedef struct                                                                                                     \
+    {                                                                                                                  \
+        ParMapPool* const pool;                                                                                        \
+        FnRetType const* curr;                                                                                         \
+        FnRetType const* end;                                                                                          \
+    } ParMap(ElmntType, FnRetType)
+
+/* Name of the function that maps a function over an `Iterable(ElmntType)` on multiple threads */
+#define par_map_of(ElmntType, FnRetType) CONCAT(CONCAT(par_map_, ElmntType), CONCAT(_, FnRetType))
+
+/* Name of the function that stops a parallel map, and frees the adapter */
+#define free_par_map_of(ElmntType, FnRetType) CONCAT(CONCAT(free_par_map_, ElmntType), CONCAT(_, FnRetType))
+
+/*
+Map the function `fn` of type `FnRetType (*)(ElmntType)` over `it` on `nthreads` threads, to make a new iterable
+
+The mapped elements come out in the same order as the elements of `it`. The adapter is allocated on the heap, it must
+be freed with `free_par_map` - whether it has been fully consumed or not
+*/
+#define par_map_over(it, fn, ElmntType, FnRetType, nthreads) par_map_of(ElmntType, FnRetType)(it, fn, nthreads)
+
+/* Stop given `it` iterable, built by `par_map_over`, from mapping and free it */
+#define free_par_map(it, ElmntType, FnRetType) free_par_map_of(ElmntType, FnRetType)(it)
+
+/*
+Define the `next` and `next_batch` functions of `ParMap(ElmntType, FnRetType)`, implement `Iterator` for it, and
+define `par_map_of(ElmntType, FnRetType)` and `free_par_map_of(ElmntType, FnRetType)`-
+
+Iterable(FnRetType) par_map_of(ElmntType, FnRetType)(Iterable(ElmntType) it, FnRetType (*fn)(ElmntType x),
+                                                     size_t nthreads);
+void free_par_map_of(ElmntType, FnRetType)(Iterable(FnRetType) it);
+
+`next` bumps a pointer through the chunk acquired from the pool, and only goes back to the pool once it runs out.
+`next_batch` copies out of the chunk
+
+This should be called in a source file
+*/
+#define define_par_map_func(ElmntType, FnRetType)                                                                      \
+    static size_t CONCAT(ParMap(ElmntType, FnRetType), _fill)(void* src, void* in, size_t cap)                         \
+    {                                                                                                                  \
+        return iter_next_batch(*(Iterable(ElmntType)*)src, in, cap, ElmntType);                                        \
+    }                                                                                                                  \
+    static void CONCAT(ParMap(ElmntType, FnRetType), _map)(void const* fn, void const* in, void* out, size_t n)        \
+    {                                                                                                                  \
+        FnRetType (*const mapfn)(ElmntType x) = *(FnRetType(* const*)(ElmntType))fn;                                   \
+        ElmntType const* const src            = in;                                                                    \
+        FnRetType* const dst                  = out;                                                                   \
+        for (size_t i = 0; i < n; i++) {                                                                               \
+            dst[i] = mapfn(src[i]);                                                                                    \
+        }                                                                                                              \
+    }                                                                                                                  \
+    /* Acquire the next chunk of mapped elements out of the pool, returns `false` once there's none left */           \
+    static bool CONCAT(ParMap(ElmntType, FnRetType), _advance)(ParMap(ElmntType, FnRetType) * self)                    \
+    {                                                                                                                  \
+        void const* chunk;                                                                                             \
+        size_t len;                                                                                                    \
+        if (!par_map_acquire(self->pool, &chunk, &len)) {                                                              \
+            return false;                                                                                              \
+        }                                                                                                              \
+        self->curr = chunk;                                                                                            \
+        self->end  = self->curr + len;                                                                                 \
+        return true;                                                                                                   \
+    }                                                                                                                  \
+    static Maybe(FnRetType) CONCAT(ParMap(ElmntType, FnRetType), _nxt)(ParMap(ElmntType, FnRetType) * self)            \
+    {                                                                                                                  \
+        if (self->curr == self->end && !CONCAT(ParMap(ElmntType, FnRetType), _advance)(self)) {                        \
+            return Nothing(FnRetType);                                                                                 \
+        }                                                                                                              \
+        return Just(*self->curr++, FnRetType);                                                                         \
+    }                                                                                                                  \
+    static size_t CONCAT(ParMap(ElmntType, FnRetType), _batch)(ParMap(ElmntType, FnRetType) * self, FnRetType * out,   \
+                                                               size_t cap)                                             \
+    {                                                                                                                  \
+        size_t n = 0;                                                                                                  \
+        while (n < cap) {                                                                                              \
+            if (self->curr == self->end && (n != 0 || !CONCAT(ParMap(ElmntType, FnRetType), _advance)(self))) {        \
+                /* Don't wait on the pool for more, once there's something to hand out */                             \
+                break;                                                                                                 \
+            }                                                                                                          \
+            size_t const avail = (size_t)(self->end - self->curr);                                                     \
+            size_t const len   = cap - n < avail ? cap - n : avail;                                                    \
+            memcpy(out + n, self->curr, len * sizeof(*out));                                                           \
+            self->curr += len;                                                                                         \
+            n += len;                                                                                                  \
+        }                                                                                                              \
+        return n;                                                                                                      \
+    }                                                                                                                  \
+    impl_next_batch(ParMap(ElmntType, FnRetType)*, FnRetType, CONCAT(ParMap(ElmntType, FnRetType), _batch))            \
+    impl_default_next_into(ParMap(ElmntType, FnRetType)*, FnRetType, CONCAT(ParMap(ElmntType, FnRetType), _nxt))       \
+    impl_iterator_with(ParMap(ElmntType, FnRetType)*, FnRetType, CONCAT(prep_, ParMap(ElmntType, FnRetType)),          \
+                       CONCAT(ParMap(ElmntType, FnRetType), _nxt),                                                     \
+                       iter_slot(next_batch, CONCAT(ParMap(ElmntType, FnRetType), _batch)),                            \
+                       iter_default_into(CONCAT(ParMap(ElmntType, FnRetType), _nxt)))                                  \
+    Iterable(FnRetType) par_map_of(ElmntType, FnRetType)(Iterable(ElmntType) it, FnRetType (*fn)(ElmntType x),         \
+                                                         size_t nthreads)                                              \
+    {                                                                                                                  \
+        static ParMapOps const ops = {.fill     = CONCAT(ParMap(ElmntType, FnRetType), _fill),                         \
+                                      .map      = CONCAT(ParMap(ElmntType, FnRetType), _map),                          \
+                                      .in_size  = sizeof(ElmntType),                                                   \
+                                      .out_size = sizeof(FnRetType)};                                                  \
+        ParMap(ElmntType, FnRetType)* const self = malloc(sizeof(*self));                                              \
+        if (self == NULL) {                                                                                            \
+            fprintf(stderr, "OOM in par_map_over");                                                                    \
+            exit(1);                                                                                                   \
+        }                                                                                                              \
+        ParMapPool* const pool = par_map_start(&ops, &it, sizeof(it), &fn, sizeof(fn), nthreads);                      \
+        memcpy(self, &(ParMap(ElmntType, FnRetType)){.pool = pool, .curr = NULL, .end = NULL}, sizeof(*self));        \
+        return CONCAT(prep_, ParMap(ElmntType, FnRetType))(self);                                                      \
+    }                                                                                                                  \
+    void free_par_map_of(ElmntType, FnRetType)(Iterable(FnRetType) it)                                                 \
+    {                                                                                                                  \
+        ParMap(ElmntType, FnRetType)* const self = it.self;                                                            \
+        par_map_stop(self->pool);                                                                                      \
+        free(self);                                                                                                    \
+    }
+
+#endif /* !IT_PAR_MAP_H */
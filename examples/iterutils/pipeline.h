@@ -0,0 +1,130 @@
+#ifndef IT_PIPELINE_H
+#define IT_PIPELINE_H
+
+#include "../func_iter.h"
+#include "arena.h"
+
+/*
+Utilities to define a fused pipeline of `map`, `filter` and `take` stages over a source iterable.
+
+Chaining `map_over`, `take_from` and co. puts an indirect call, and a `Maybe` wrap and unwrap, at every stage. A
+pipeline instead expands a fixed chain of stages into one monomorphic `next` function - which pulls from the source,
+runs every stage inline (the stage functions are called directly, so they can be inlined too) and wraps the result in
+a `Maybe` only once, at the end.
+
+The pipeline is still an ordinary `Iterable`, so it can be passed to (and combined with) anything else taking one.
+
+Example-
+
+DefinePipeline(OddSquares, int, int, pipe_take(8, int), pipe_filter(is_odd, int), pipe_map(square, int, int))
+...
+Iterable(int) it = pipeline_from(arrit, OddSquares);
+
+Each stage is one of-
+- `pipe_map(fn, ElmntType, FnRetType)` - Map `fn`, of type `FnRetType (*)(ElmntType)`, over the elements
+- `pipe_filter(pred, ElmntType)` - Only keep the elements for which `pred`, of type `bool (*)(ElmntType)`, is true
+- `pipe_take(n, ElmntType)` - Stop after `n` elements have passed through this stage
+
+`n` is evaluated on every call to `next`, it should be a constant.
+At most `PIPE_MAX_STAGES` stages are supported.
+*/
+
+#define PIPE_MAX_STAGES 8
+
+/* Stages are tuples of (kind, argument, input type, output type) */
+#define pipe_map(fn, ElmntType, FnRetType) (PipeMap, fn, ElmntType, FnRetType)
+#define pipe_filter(pred, ElmntType)       (PipeFilter, pred, ElmntType, ElmntType)
+#define pipe_take(n, ElmntType)            (PipeTake, n, ElmntType, ElmntType)
+
+/* Name of the function that wraps a pipeline struct into an iterable */
+#define prep_pipeline_of(Name) CONCAT(CONCAT(prep_, Name), _itr)
+
+/* Build an iterable that runs the pipeline `Name` over the elements of given `it` iterable */
+#define pipeline_from(it, Name) prep_pipeline_of(Name)(&(Name){.taken = {0}, .src = it})
+
+/* Same as `pipeline_from`, but the pipeline is stored in given `IterArena*` - so the iterable can outlive the scope */
+#define arena_pipeline_from(arena, it, Name) prep_pipeline_of(Name)(arena_new(arena, Name, .taken = {0}, .src = it))
+
+/* Number of arguments passed (1 to PIPE_MAX_STAGES) */
+#define PIPE_NARGS(...)                                   PIPE_NARGS_(__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define PIPE_NARGS_(_1, _2, _3, _4, _5, _6, _7, _8, N, ...) N
+
+/* Call `m(i, o, stage)` for every stage - `i` and `o` being the indices of the stage's input and output values */
+#define PIPE_FOR_EACH(m, ...)                       CONCAT(PIPE_FOR_EACH_, PIPE_NARGS(__VA_ARGS__))(m, __VA_ARGS__)
+#define PIPE_FOR_EACH_1(m, s1)                      m(0, 1, s1)
+#define PIPE_FOR_EACH_2(m, s1, s2)                  PIPE_FOR_EACH_1(m, s1) m(1, 2, s2)
+#define PIPE_FOR_EACH_3(m, s1, s2, s3)              PIPE_FOR_EACH_2(m, s1, s2) m(2, 3, s3)
+#define PIPE_FOR_EACH_4(m, s1, s2, s3, s4)          PIPE_FOR_EACH_3(m, s1, s2, s3) m(3, 4, s4)
+#define PIPE_FOR_EACH_5(m, s1, s2, s3, s4, s5)      PIPE_FOR_EACH_4(m, s1, s2, s3, s4) m(4, 5, s5)
+#define PIPE_FOR_EACH_6(m, s1, s2, s3, s4, s5, s6)  PIPE_FOR_EACH_5(m, s1, s2, s3, s4, s5) m(5, 6, s6)
+#define PIPE_FOR_EACH_7(m, s1, s2, s3, s4, s5, s6, s7)                                                                 \
+    PIPE_FOR_EACH_6(m, s1, s2, s3, s4, s5, s6) m(6, 7, s7)
+#define PIPE_FOR_EACH_8(m, s1, s2, s3, s4, s5, s6, s7, s8)                                                             \
+    PIPE_FOR_EACH_7(m, s1, s2, s3, s4, s5, s6, s7) m(7, 8, s8)
+
+/* Unpack a stage tuple into the arguments of `m`, prefixed by the `i` and `o` indices */
+#define PIPE_UNPACK_(...)           __VA_ARGS__
+#define PIPE_APPLY(m, args)         m args
+#define PIPE_DISPATCH(m, i, o, stg) PIPE_APPLY(m, (i, o, PIPE_UNPACK_ stg))
+
+/* Name of the local variable holding the value at index `i` */
+#define PIPE_VAL(i) CONCAT(pipe_val_, i)
+
+/* Condition (`||`-ed together) under which a stage can't let any more elements through */
+#define PIPE_DONE(i, o, stg)                         PIPE_DISPATCH(PIPE_DONE_, i, o, stg)
+#define PIPE_DONE_(i, o, kind, arg, InType, OutType) CONCAT(PIPE_DONE_, kind)(i, arg)
+#define PIPE_DONE_PipeMap(i, arg)
+#define PIPE_DONE_PipeFilter(i, arg)
+#define PIPE_DONE_PipeTake(i, arg) || self->taken[i] >= (size_t)(arg)
+
+/* Code run by a stage, computes `PIPE_VAL(o)` from `PIPE_VAL(i)` - `continue`s to drop the element */
+#define PIPE_STAGE(i, o, stg)                         PIPE_DISPATCH(PIPE_STAGE_, i, o, stg)
+#define PIPE_STAGE_(i, o, kind, arg, InType, OutType) CONCAT(PIPE_STAGE_, kind)(i, o, arg, InType, OutType)
+#define PIPE_STAGE_PipeMap(i, o, fn, InType, OutType)                                                                  \
+    OutType (*const CONCAT(pipe_fn_, i))(InType x) = (fn);                                                             \
+    (void)CONCAT(pipe_fn_, i);                                                                                         \
+    OutType const PIPE_VAL(o) = (fn)(PIPE_VAL(i));
+#define PIPE_STAGE_PipeFilter(i, o, pred, InType, OutType)                                                             \
+    bool (*const CONCAT(pipe_fn_, i))(InType x) = (pred);                                                              \
+    (void)CONCAT(pipe_fn_, i);                                                                                         \
+    if (!(pred)(PIPE_VAL(i))) {                                                                                        \
+        continue;                                                                                                      \
+    }                                                                                                                  \
+    OutType const PIPE_VAL(o) = PIPE_VAL(i);
+#define PIPE_STAGE_PipeTake(i, o, n, InType, OutType)                                                                  \
+    ++(self->taken[i]);                                                                                                \
+    OutType const PIPE_VAL(o) = PIPE_VAL(i);
+
+/*
+Define a pipeline struct named `Name`, that runs the given stages over an `Iterable(SrcType)` and yields `OutType`
+
+Also define its `next` function (which is `static_next(Name)`, so `foreach_static` works on it) and implement
+`Iterator` for it - the function is named `prep_pipeline_of(Name)`
+
+This should be called in a source file
+*/
+#define DefinePipeline(Name, SrcType, OutType, ...)                                                                    \
+    typedef struct                                                                                                     \
+    {                                                                                                                  \
+        size_t taken[PIPE_MAX_STAGES];                                                                                 \
+        Iterable(SrcType) const src;                                                                                   \
+    } Name;                                                                                                            \
+    static Maybe(OutType) static_next(Name)(Name * self)                                                               \
+    {                                                                                                                  \
+        Iterable(SrcType) const srcit = self->src;                                                                     \
+        while (1) {                                                                                                    \
+            if (0 PIPE_FOR_EACH(PIPE_DONE, __VA_ARGS__)) {                                                             \
+                return Nothing(OutType);                                                                               \
+            }                                                                                                          \
+            Maybe(SrcType) const res = srcit.tc->next(srcit.self);                                                     \
+            if (is_nothing_of(res, SrcType)) {                                                                         \
+                return Nothing(OutType);                                                                               \
+            }                                                                                                          \
+            SrcType const PIPE_VAL(0) = from_just_(res);                                                               \
+            PIPE_FOR_EACH(PIPE_STAGE, __VA_ARGS__)                                                                     \
+            return Just(PIPE_VAL(PIPE_NARGS(__VA_ARGS__)), OutType);                                                   \
+        }                                                                                                              \
+    }                                                                                                                  \
+    impl_iterator(Name*, OutType, prep_pipeline_of(Name), static_next(Name))
+
+#endif /* !IT_PIPELINE_H */
@@ -0,0 +1,231 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "readahead.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Number of times a side re-checks the ring before it goes to sleep, waiting on the other side */
+#define READAHEAD_SPIN 256
+
+/* Keeps what follows off the cache line of what precedes it, so the producer and consumer don't share one */
+typedef union
+{
+    size_t val;
+    unsigned char pad[64];
+} ReadaheadPos;
+
+struct ReadaheadRing
+{
+    /*
+    Number of elements ever published by the producer, and released by the consumer - only ever grow, the slot of
+    element `i` is `i & mask`. Each one is written by one side only, and read by the other
+    */
+    ReadaheadPos tail;
+    ReadaheadPos head;
+    /* Set by the producer once the source is exhausted, and by the consumer once it wants the producer gone */
+    int done;
+    int stop;
+    /* Set by a side while it sleeps (on its condition variable), so the other side knows to wake it */
+    int cons_waiting;
+    int prod_waiting;
+    pthread_mutex_t lock;
+    pthread_cond_t cons_cond;
+    pthread_cond_t prod_cond;
+    /* Owned by the consumer - the number of elements handed out by the last `readahead_ring_acquire` */
+    size_t held;
+    unsigned char* slots;
+    size_t mask;
+    size_t elem_size;
+    ReadaheadFill fill;
+    void* src;
+    pthread_t thread;
+    /* Whether the producer thread could be spawned, the consumer fills the ring itself otherwise */
+    bool spawned;
+};
+
+static void* readahead_malloc(size_t size)
+{
+    void* const mem = malloc(size);
+    if (mem == NULL) {
+        fprintf(stderr, "OOM in readahead_ring_start");
+        exit(1);
+    }
+    return mem;
+}
+
+static size_t load_pos(ReadaheadPos const* pos)
+{
+    return __atomic_load_n(&pos->val, __ATOMIC_ACQUIRE);
+}
+
+/*
+Publish a new position, and wake the other side if it sleeps
+
+The store and the load of the other side's `waiting` flag are sequentially consistent - as are the store of that flag
+and the load of the position in `wait_for` - so either the sleeper sees the new position before it sleeps, or this sees
+the flag and signals it (under the lock, so not before the sleeper waits on the condition variable)
+*/
+static void publish_pos(ReadaheadRing* ring, ReadaheadPos* pos, size_t val, int* waiting, pthread_cond_t* cond)
+{
+    __atomic_store_n(&pos->val, val, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(waiting, __ATOMIC_SEQ_CST)) {
+        pthread_mutex_lock(&ring->lock);
+        pthread_cond_signal(cond);
+        pthread_mutex_unlock(&ring->lock);
+    }
+}
+
+/* Same as `publish_pos`, for the `done` and `stop` flags */
+static void publish_flag(ReadaheadRing* ring, int* flag, int* waiting, pthread_cond_t* cond)
+{
+    __atomic_store_n(flag, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(waiting, __ATOMIC_SEQ_CST)) {
+        pthread_mutex_lock(&ring->lock);
+        pthread_cond_signal(cond);
+        pthread_mutex_unlock(&ring->lock);
+    }
+}
+
+/* Whether the producer has something for the consumer - the consumer's own `head` is `head` */
+static bool cons_ready(ReadaheadRing* ring, size_t head)
+{
+    return __atomic_load_n(&ring->tail.val, __ATOMIC_SEQ_CST) != head ||
+           __atomic_load_n(&ring->done, __ATOMIC_SEQ_CST);
+}
+
+/* Whether the producer has room to fill, or has to stop - the producer's own `tail` is `tail` */
+static bool prod_ready(ReadaheadRing* ring, size_t tail)
+{
+    return tail - __atomic_load_n(&ring->head.val, __ATOMIC_SEQ_CST) <= ring->mask ||
+           __atomic_load_n(&ring->stop, __ATOMIC_SEQ_CST);
+}
+
+/* Spin on `ready` for a while, then sleep on `cond` until it's true */
+static void wait_for(ReadaheadRing* ring, bool (*ready)(ReadaheadRing* ring, size_t pos), size_t pos, int* waiting,
+                     pthread_cond_t* cond)
+{
+    for (size_t i = 0; i < READAHEAD_SPIN; i++) {
+        if (ready(ring, pos)) {
+            return;
+        }
+    }
+    pthread_mutex_lock(&ring->lock);
+    __atomic_store_n(waiting, 1, __ATOMIC_SEQ_CST);
+    while (!ready(ring, pos)) {
+        pthread_cond_wait(cond, &ring->lock);
+    }
+    __atomic_store_n(waiting, 0, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&ring->lock);
+}
+
+static void* produce(void* arg)
+{
+    ReadaheadRing* const ring = arg;
+    size_t const cap          = ring->mask + 1;
+    size_t tail               = ring->tail.val;
+    while (!__atomic_load_n(&ring->stop, __ATOMIC_ACQUIRE)) {
+        size_t const room = cap - (tail - load_pos(&ring->head));
+        if (room == 0) {
+            wait_for(ring, prod_ready, tail, &ring->prod_waiting, &ring->prod_cond);
+            continue;
+        }
+        /* Fill the free slots up to the end of the ring, they're contiguous */
+        size_t const idx = tail & ring->mask;
+        size_t len       = cap - idx < room ? cap - idx : room;
+        len              = len < READAHEAD_BATCH ? len : READAHEAD_BATCH;
+        size_t const n   = ring->fill(ring->src, ring->slots + idx * ring->elem_size, len);
+        if (n == 0) {
+            break;
+        }
+        tail += n;
+        publish_pos(ring, &ring->tail, tail, &ring->cons_waiting, &ring->cons_cond);
+    }
+    publish_flag(ring, &ring->done, &ring->cons_waiting, &ring->cons_cond);
+    return NULL;
+}
+
+ReadaheadRing* readahead_ring_start(void const* src, size_t src_size, ReadaheadFill fill, size_t elem_size,
+                                    size_t capacity)
+{
+    size_t cap = 2;
+    while (cap < capacity) {
+        cap *= 2;
+    }
+    ReadaheadRing* const ring = readahead_malloc(sizeof(*ring));
+    *ring                     = (ReadaheadRing){
+        .slots     = readahead_malloc(cap * elem_size),
+        .mask      = cap - 1,
+        .elem_size = elem_size,
+        .fill      = fill,
+        .src       = memcpy(readahead_malloc(src_size), src, src_size),
+    };
+    pthread_mutex_init(&ring->lock, NULL);
+    pthread_cond_init(&ring->cons_cond, NULL);
+    pthread_cond_init(&ring->prod_cond, NULL);
+    /* If the thread can't be spawned, the source is still consumed - just not ahead of time */
+    ring->spawned = pthread_create(&ring->thread, NULL, produce, ring) == 0;
+    return ring;
+}
+
+/* `readahead_ring_acquire` without a producer thread - fill the (empty) ring right here */
+static bool acquire_inline(ReadaheadRing* ring, void const** out, size_t* len)
+{
+    size_t const cap = ring->mask + 1;
+    size_t const n   = ring->fill(ring->src, ring->slots, cap < READAHEAD_BATCH ? cap : READAHEAD_BATCH);
+    ring->held       = n;
+    *out             = ring->slots;
+    *len             = n;
+    return n != 0;
+}
+
+bool readahead_ring_acquire(ReadaheadRing* ring, void const** out, size_t* len)
+{
+    if (!ring->spawned) {
+        return acquire_inline(ring, out, len);
+    }
+    size_t const head = ring->head.val + ring->held;
+    if (ring->held != 0) {
+        ring->held = 0;
+        publish_pos(ring, &ring->head, head, &ring->prod_waiting, &ring->prod_cond);
+    }
+    size_t tail = load_pos(&ring->tail);
+    if (tail == head) {
+        wait_for(ring, cons_ready, head, &ring->cons_waiting, &ring->cons_cond);
+        /* Elements may have been published right before `done` was set */
+        tail = load_pos(&ring->tail);
+        if (tail == head) {
+            return false;
+        }
+    }
+    /* Hand out no more than a batch at once, so the producer gets its slots back in time to keep up */
+    size_t const idx = head & ring->mask;
+    size_t n         = tail - head;
+    n                = ring->mask + 1 - idx < n ? ring->mask + 1 - idx : n;
+    n                = n < READAHEAD_BATCH ? n : READAHEAD_BATCH;
+    ring->held       = n;
+    *out             = ring->slots + idx * ring->elem_size;
+    *len             = n;
+    return true;
+}
+
+void readahead_ring_stop(ReadaheadRing* ring)
+{
+    if (ring->spawned) {
+        /* The producer checks `stop` between batches, and when it wakes up on a full ring */
+        pthread_mutex_lock(&ring->lock);
+        __atomic_store_n(&ring->stop, 1, __ATOMIC_SEQ_CST);
+        pthread_cond_signal(&ring->prod_cond);
+        pthread_mutex_unlock(&ring->lock);
+        pthread_join(ring->thread, NULL);
+    }
+    pthread_cond_destroy(&ring->prod_cond);
+    pthread_cond_destroy(&ring->cons_cond);
+    pthread_mutex_destroy(&ring->lock);
+    free(ring->src);
+    free(ring->slots);
+    free(ring);
+}
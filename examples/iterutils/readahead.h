@@ -0,0 +1,173 @@
+#ifndef IT_READAHEAD_H
+#define IT_READAHEAD_H
+
+#include "../func_iter.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+Utilities to consume an iterable on a background thread, ahead of its consumer
+
+A producer thread pulls batches (see `iter_next_batch`) out of the source iterable, straight into the free slots of a
+bounded ring buffer, and the consumer takes whole runs of filled slots back out - so the source's `next` and the
+consumer's work overlap. The ring has a single producer and a single consumer, its positions are published with
+atomic stores, and neither side takes a lock while the other keeps up. Once a side has spun for a while on a full (or
+empty) ring, it sleeps until the other side makes progress.
+
+The end of the source is handed to the consumer as `Nothing`, once every element before it has been consumed.
+Freeing the adapter (with `free_readahead`) before that stops the producer - after the batch it's pulling, if any - and
+joins it.
+
+The source iterable is only touched by the producer thread from then on - it (and whatever its `self` points to) must
+outlive the adapter, and must not be used by anyone else meanwhile.
+
+Example-
+
+Iterable(int) it = readahead(parsedit, 4096, int);
+foreach (int, x, it) {
+    ...
+}
+free_readahead(it, int);
+*/
+
+/* Number of elements the producer pulls out of the source at most, before publishing them */
+#ifndef READAHEAD_BATCH
+#define READAHEAD_BATCH ITER_BATCH_SIZE
+#endif
+
+/* The ring buffer, and the producer thread filling it */
+typedef struct ReadaheadRing ReadaheadRing;
+
+/* Pull up to `cap` elements out of the source iterable at `src` into `out`, returns how many were pulled */
+typedef size_t (*ReadaheadFill)(void* src, void* out, size_t cap);
+
+/*
+Start a producer thread filling a ring of (at least) `capacity` elements of `elem_size` bytes, by calling `fill`
+
+The `src_size` bytes at `src` (the source iterable) are copied into the ring, `fill` is called with a pointer to that
+copy. Exits on OOM. If the thread can't be created, the consumer fills the ring itself instead - one batch at a time,
+as it runs out
+*/
+ReadaheadRing* readahead_ring_start(void const* src, size_t src_size, ReadaheadFill fill, size_t elem_size,
+                                    size_t capacity);
+
+/*
+Release the run of elements handed out by the previous call, and acquire the next one - waiting until there is one
+
+The run is stored in `out` (its number of elements in `len`), it stays in the ring until the next call. Returns
+`false`, with nothing acquired, once the source has been fully consumed
+*/
+bool readahead_ring_acquire(ReadaheadRing* ring, void const** out, size_t* len);
+
+/* Stop the producer thread, wait for it to exit and free the ring */
+void readahead_ring_stop(ReadaheadRing* ring);
+
+#define Readahead(T) Readahead##T
+
+/* The consumer end of a ring of `T`s - the run it's taking elements out of is from `curr` up to `end` */
+#define DefineReadahead(T)                                                                                             \
+    typedef struct                                                                                                     \
+    {                                                                                                                  \
+        ReadaheadRing* const ring;                                                                                     \
+        T const* curr;                                                                                                 \
+        T const* end;                                                                                                  \
+    } Readahead(T)
+
+/* Name of the function that starts reading an `Iterable(T)` ahead */
+#define readahead_of(T) CONCAT(readahead_, T)
+
+/* Name of the function that stops reading an `Iterable(T)` ahead, and frees the adapter */
+#define free_readahead_of(T) CONCAT(free_readahead_, T)
+
+/*
+Build an `Iterable(T)` that yields the elements of given `it` iterable, pulled out of it on a background thread
+
+At most `capacity` elements are read ahead. The adapter is allocated on the heap, it must be freed with
+`free_readahead` - whether it has been fully consumed or not
+*/
+#define readahead(it, capacity, T) readahead_of(T)(it, capacity)
+
+/* Stop given `it` iterable, built by `readahead`, from reading ahead and free it */
+#define free_readahead(it, T) free_readahead_of(T)(it)
+
+/*
+Define the `next` and `next_batch` functions of `Readahead(T)`, implement `Iterator` for it, and define
+`readahead_of(T)` and `free_readahead_of(T)`-
+
+Iterable(T) readahead_of(T)(Iterable(T) it, size_t capacity);
+void free_readahead_of(T)(Iterable(T) it);
+
+`next` bumps a pointer through the run of elements acquired from the ring, and only goes back to the ring once it
+runs out. `next_batch` copies out of the run
+
+This should be called in a source file
+*/
+#define define_readahead_func(T)                                                                                       \
+    static size_t CONCAT(Readahead(T), _fill)(void* src, void* out, size_t cap)                                        \
+    {                                                                                                                  \
+        return iter_next_batch(*(Iterable(T)*)src, out, cap, T);                                                       \
+    }                                                                                                                  \
+    /* Acquire the next run of elements out of the ring, returns `false` once there's none left */                    \
+    static bool CONCAT(Readahead(T), _advance)(Readahead(T) * self)                                                    \
+    {                                                                                                                  \
+        void const* run;                                                                                               \
+        size_t len;                                                                                                    \
+        if (!readahead_ring_acquire(self->ring, &run, &len)) {                                                         \
+            return false;                                                                                              \
+        }                                                                                                              \
+        self->curr = run;                                                                                              \
+        self->end  = self->curr + len;                                                                                 \
+        return true;                                                                                                   \
+    }                                                                                                                  \
+    static Maybe(T) CONCAT(Readahead(T), _nxt)(Readahead(T) * self)                                                    \
+    {                                                                                                                  \
+        if (self->curr == self->end && !CONCAT(Readahead(T), _advance)(self)) {                                        \
+            return Nothing(T);                                                                                         \
+        }                                                                                                              \
+        return Just(*self->curr++, T);                                                                                 \
+    }                                                                                                                  \
+    static size_t CONCAT(Readahead(T), _batch)(Readahead(T) * self, T * out, size_t cap)                               \
+    {                                                                                                                  \
+        size_t n = 0;                                                                                                  \
+        while (n < cap) {                                                                                              \
+            if (self->curr == self->end && (n != 0 || !CONCAT(Readahead(T), _advance)(self))) {                        \
+                /* Don't wait on the ring for more, once there's something to hand out */                             \
+                break;                                                                                                 \
+            }                                                                                                          \
+            size_t const avail = (size_t)(self->end - self->curr);                                                     \
+            size_t const len   = cap - n < avail ? cap - n : avail;                                                    \
+            memcpy(out + n, self->curr, len * sizeof(*out));                                                           \
+            self->curr += len;                                                                                         \
+            n += len;                                                                                                  \
+        }                                                                                                              \
+        return n;                                                                                                      \
+    }                                                                                                                  \
+    impl_next_batch(Readahead(T)*, T, CONCAT(Readahead(T), _batch))                                                    \
+    impl_default_next_into(Readahead(T)*, T, CONCAT(Readahead(T), _nxt))                                               \
+    impl_iterator_with(Readahead(T)*, T, CONCAT(prep_, Readahead(T)), CONCAT(Readahead(T), _nxt),                      \
+                       iter_slot(next_batch, CONCAT(Readahead(T), _batch)),                                            \
+                       iter_default_into(CONCAT(Readahead(T), _nxt)))                                                  \
+    Iterable(T) readahead_of(T)(Iterable(T) it, size_t capacity)                                                       \
+    {                                                                                                                  \
+        Readahead(T)* const self = malloc(sizeof(*self));                                                              \
+        if (self == NULL) {                                                                                            \
+            fprintf(stderr, "OOM in readahead");                                                                       \
+            exit(1);                                                                                                   \
+        }                                                                                                              \
+        ReadaheadRing* const ring =                                                                                    \
+            readahead_ring_start(&it, sizeof(it), CONCAT(Readahead(T), _fill), sizeof(T), capacity);                   \
+        memcpy(self, &(Readahead(T)){.ring = ring, .curr = NULL, .end = NULL}, sizeof(*self));                        \
+        return CONCAT(prep_, Readahead(T))(self);                                                                      \
+    }                                                                                                                  \
+    void free_readahead_of(T)(Iterable(T) it)                                                                          \
+    {                                                                                                                  \
+        Readahead(T)* const self = it.self;                                                                            \
+        readahead_ring_stop(self->ring);                                                                               \
+        free(self);                                                                                                    \
+    }
+
+#endif /* !IT_READAHEAD_H */
@@ -0,0 +1,408 @@
+#include "simd.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_X86 1
+#include <immintrin.h>
+#else
+#define SIMD_X86 0
+#endif
+
+/* Turn an element into a key whose unsigned order is the order the element should be compared in */
+#define SIMD_KEY(x, bias) ((x) ^ (bias) ^ SIMD_UNSIGNED_BIAS)
+
+/* Plain C kernels - the compiler may still vectorize these for the baseline instruction set */
+
+static uint32_t scalar_sum(uint32_t const* arr, size_t n)
+{
+    uint32_t sum = 0;
+    for (size_t i = 0; i < n; i++) {
+        sum += arr[i];
+    }
+    return sum;
+}
+
+static uint32_t scalar_dot(uint32_t const* a, uint32_t const* b, size_t n)
+{
+    uint32_t sum = 0;
+    for (size_t i = 0; i < n; i++) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+static uint32_t scalar_min(uint32_t const* arr, size_t n, uint32_t bias)
+{
+    uint32_t res = arr[0];
+    for (size_t i = 1; i < n; i++) {
+        res = SIMD_KEY(arr[i], bias) < SIMD_KEY(res, bias) ? arr[i] : res;
+    }
+    return res;
+}
+
+static uint32_t scalar_max(uint32_t const* arr, size_t n, uint32_t bias)
+{
+    uint32_t res = arr[0];
+    for (size_t i = 1; i < n; i++) {
+        res = SIMD_KEY(arr[i], bias) > SIMD_KEY(res, bias) ? arr[i] : res;
+    }
+    return res;
+}
+
+static size_t scalar_count(uint32_t const* arr, size_t n, SimdCmp op, uint32_t value, uint32_t bias)
+{
+    uint32_t const key = SIMD_KEY(value, bias);
+    size_t count       = 0;
+    switch (op) {
+        case SIMD_CMP_EQ:
+            for (size_t i = 0; i < n; i++) {
+                count += arr[i] == value;
+            }
+            break;
+        case SIMD_CMP_LT:
+            for (size_t i = 0; i < n; i++) {
+                count += SIMD_KEY(arr[i], bias) < key;
+            }
+            break;
+        case SIMD_CMP_GT:
+            for (size_t i = 0; i < n; i++) {
+                count += SIMD_KEY(arr[i], bias) > key;
+            }
+            break;
+    }
+    return count;
+}
+
+/* Every element is written, but only the kept ones move the cursor - so there's no branch to mispredict */
+static size_t scalar_compact(uint32_t const* in, uint8_t const* keep, size_t n, uint32_t* out)
+{
+    size_t len = 0;
+    for (size_t i = 0; i < n; i++) {
+        out[len] = in[i];
+        len += keep[i];
+    }
+    return len;
+}
+
+static SimdKernels const scalar_kernels = {.sum     = scalar_sum,
+                                           .dot     = scalar_dot,
+                                           .min     = scalar_min,
+                                           .max     = scalar_max,
+                                           .count   = scalar_count,
+                                           .compact = scalar_compact,
+                                           .name    = "scalar"};
+
+#if SIMD_X86
+
+/*
+Comparison counts are accumulated in 32 bit lanes, which are flushed into a `size_t` every `SIMD_COUNT_BLOCK` elements
+- well before they could overflow
+*/
+#define SIMD_COUNT_BLOCK ((size_t)1 << 30)
+
+/* SSE2 kernels */
+
+__attribute__((target("sse2"))) static inline uint32_t sse2_hsum(__m128i v)
+{
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+    return (uint32_t)_mm_cvtsi128_si32(v);
+}
+
+/* SSE2 has no 32 bit `mullo` - multiply the even and odd lanes into 64 bit products, and keep their low halves */
+__attribute__((target("sse2"))) static inline __m128i sse2_mullo(__m128i a, __m128i b)
+{
+    __m128i const even = _mm_mul_epu32(a, b);
+    __m128i const odd  = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+/* SSE2 has no 32 bit `min`/`max` either - pick lanes with a comparison mask */
+__attribute__((target("sse2"))) static inline __m128i sse2_select(__m128i mask, __m128i a, __m128i b)
+{
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+__attribute__((target("sse2"))) static uint32_t sse2_sum(uint32_t const* arr, size_t n)
+{
+    __m128i acc0 = _mm_setzero_si128(), acc1 = _mm_setzero_si128();
+    size_t i     = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm_add_epi32(acc0, _mm_loadu_si128((__m128i const*)(arr + i)));
+        acc1 = _mm_add_epi32(acc1, _mm_loadu_si128((__m128i const*)(arr + i + 4)));
+    }
+    return sse2_hsum(_mm_add_epi32(acc0, acc1)) + scalar_sum(arr + i, n - i);
+}
+
+__attribute__((target("sse2"))) static uint32_t sse2_dot(uint32_t const* a, uint32_t const* b, size_t n)
+{
+    __m128i acc = _mm_setzero_si128();
+    size_t i    = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i const va = _mm_loadu_si128((__m128i const*)(a + i));
+        __m128i const vb = _mm_loadu_si128((__m128i const*)(b + i));
+        acc              = _mm_add_epi32(acc, sse2_mullo(va, vb));
+    }
+    return sse2_hsum(acc) + scalar_dot(a + i, b + i, n - i);
+}
+
+/* Reduce the lanes of `v` (holding biased keys) to the smallest (or largest) one, and unbias it */
+__attribute__((target("sse2"))) static uint32_t sse2_hpick(__m128i v, bool max, uint32_t bias)
+{
+    uint32_t lanes[4];
+    _mm_storeu_si128((__m128i*)lanes, _mm_xor_si128(v, _mm_set1_epi32((int)bias)));
+    return max ? scalar_max(lanes, 4, bias) : scalar_min(lanes, 4, bias);
+}
+
+__attribute__((target("sse2"))) static uint32_t sse2_minmax(uint32_t const* arr, size_t n, uint32_t bias, bool max)
+{
+    if (n < 4) {
+        return max ? scalar_max(arr, n, bias) : scalar_min(arr, n, bias);
+    }
+    __m128i const vbias = _mm_set1_epi32((int)bias);
+    __m128i res         = _mm_xor_si128(_mm_loadu_si128((__m128i const*)arr), vbias);
+    size_t i            = 4;
+    for (; i + 4 <= n; i += 4) {
+        __m128i const v    = _mm_xor_si128(_mm_loadu_si128((__m128i const*)(arr + i)), vbias);
+        __m128i const mask = max ? _mm_cmpgt_epi32(v, res) : _mm_cmplt_epi32(v, res);
+        res                = sse2_select(mask, v, res);
+    }
+    uint32_t const head = sse2_hpick(res, max, bias);
+    if (i == n) {
+        return head;
+    }
+    uint32_t const tail    = max ? scalar_max(arr + i, n - i, bias) : scalar_min(arr + i, n - i, bias);
+    uint32_t const both[2] = {head, tail};
+    return max ? scalar_max(both, 2, bias) : scalar_min(both, 2, bias);
+}
+
+__attribute__((target("sse2"))) static uint32_t sse2_min(uint32_t const* arr, size_t n, uint32_t bias)
+{
+    return sse2_minmax(arr, n, bias, false);
+}
+
+__attribute__((target("sse2"))) static uint32_t sse2_max(uint32_t const* arr, size_t n, uint32_t bias)
+{
+    return sse2_minmax(arr, n, bias, true);
+}
+
+__attribute__((target("sse2"))) static size_t sse2_count(uint32_t const* arr, size_t n, SimdCmp op, uint32_t value,
+                                                         uint32_t bias)
+{
+    __m128i const vbias = _mm_set1_epi32((int)bias);
+    __m128i const vval  = _mm_xor_si128(_mm_set1_epi32((int)value), vbias);
+    size_t count        = 0;
+    size_t i            = 0;
+    while (i + 4 <= n) {
+        size_t const end = n - i > SIMD_COUNT_BLOCK ? i + SIMD_COUNT_BLOCK : n;
+        __m128i acc      = _mm_setzero_si128();
+        for (; i + 4 <= end; i += 4) {
+            __m128i const v    = _mm_xor_si128(_mm_loadu_si128((__m128i const*)(arr + i)), vbias);
+            __m128i const mask = op == SIMD_CMP_EQ   ? _mm_cmpeq_epi32(v, vval)
+                                 : op == SIMD_CMP_LT ? _mm_cmplt_epi32(v, vval)
+                                                     : _mm_cmpgt_epi32(v, vval);
+            /* Matching lanes are all ones, i.e -1 */
+            acc = _mm_sub_epi32(acc, mask);
+        }
+        count += sse2_hsum(acc);
+    }
+    return count + scalar_count(arr + i, n - i, op, value, bias);
+}
+
+/* SSE2 has no variable shuffle to move the kept lanes together, so it compacts with the plain C kernel */
+static SimdKernels const sse2_kernels = {.sum     = sse2_sum,
+                                         .dot     = sse2_dot,
+                                         .min     = sse2_min,
+                                         .max     = sse2_max,
+                                         .count   = sse2_count,
+                                         .compact = scalar_compact,
+                                         .name    = "sse2"};
+
+/* AVX2 kernels */
+
+__attribute__((target("avx2"))) static inline uint32_t avx2_hsum(__m256i v)
+{
+    return sse2_hsum(_mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1)));
+}
+
+__attribute__((target("avx2"))) static uint32_t avx2_sum(uint32_t const* arr, size_t n)
+{
+    __m256i acc0 = _mm256_setzero_si256(), acc1 = _mm256_setzero_si256();
+    size_t i     = 0;
+    for (; i + 16 <= n; i += 16) {
+        acc0 = _mm256_add_epi32(acc0, _mm256_loadu_si256((__m256i const*)(arr + i)));
+        acc1 = _mm256_add_epi32(acc1, _mm256_loadu_si256((__m256i const*)(arr + i + 8)));
+    }
+    return avx2_hsum(_mm256_add_epi32(acc0, acc1)) + scalar_sum(arr + i, n - i);
+}
+
+__attribute__((target("avx2"))) static uint32_t avx2_dot(uint32_t const* a, uint32_t const* b, size_t n)
+{
+    __m256i acc = _mm256_setzero_si256();
+    size_t i    = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i const va = _mm256_loadu_si256((__m256i const*)(a + i));
+        __m256i const vb = _mm256_loadu_si256((__m256i const*)(b + i));
+        acc              = _mm256_add_epi32(acc, _mm256_mullo_epi32(va, vb));
+    }
+    return avx2_hsum(acc) + scalar_dot(a + i, b + i, n - i);
+}
+
+__attribute__((target("avx2"))) static uint32_t avx2_minmax(uint32_t const* arr, size_t n, uint32_t bias, bool max)
+{
+    if (n < 8) {
+        return max ? scalar_max(arr, n, bias) : scalar_min(arr, n, bias);
+    }
+    __m256i const vbias = _mm256_set1_epi32((int)bias);
+    __m256i res         = _mm256_xor_si256(_mm256_loadu_si256((__m256i const*)arr), vbias);
+    size_t i            = 8;
+    for (; i + 8 <= n; i += 8) {
+        __m256i const v = _mm256_xor_si256(_mm256_loadu_si256((__m256i const*)(arr + i)), vbias);
+        res             = max ? _mm256_max_epi32(res, v) : _mm256_min_epi32(res, v);
+    }
+    __m128i const lo    = _mm256_castsi256_si128(res);
+    __m128i const hi    = _mm256_extracti128_si256(res, 1);
+    uint32_t const head = sse2_hpick(max ? _mm_max_epi32(lo, hi) : _mm_min_epi32(lo, hi), max, bias);
+    if (i == n) {
+        return head;
+    }
+    uint32_t const tail    = max ? scalar_max(arr + i, n - i, bias) : scalar_min(arr + i, n - i, bias);
+    uint32_t const both[2] = {head, tail};
+    return max ? scalar_max(both, 2, bias) : scalar_min(both, 2, bias);
+}
+
+__attribute__((target("avx2"))) static uint32_t avx2_min(uint32_t const* arr, size_t n, uint32_t bias)
+{
+    return avx2_minmax(arr, n, bias, false);
+}
+
+__attribute__((target("avx2"))) static uint32_t avx2_max(uint32_t const* arr, size_t n, uint32_t bias)
+{
+    return avx2_minmax(arr, n, bias, true);
+}
+
+__attribute__((target("avx2"))) static size_t avx2_count(uint32_t const* arr, size_t n, SimdCmp op, uint32_t value,
+                                                         uint32_t bias)
+{
+    __m256i const vbias = _mm256_set1_epi32((int)bias);
+    __m256i const vval  = _mm256_xor_si256(_mm256_set1_epi32((int)value), vbias);
+    size_t count        = 0;
+    size_t i            = 0;
+    while (i + 8 <= n) {
+        size_t const end = n - i > SIMD_COUNT_BLOCK ? i + SIMD_COUNT_BLOCK : n;
+        __m256i acc      = _mm256_setzero_si256();
+        for (; i + 8 <= end; i += 8) {
+            __m256i const v    = _mm256_xor_si256(_mm256_loadu_si256((__m256i const*)(arr + i)), vbias);
+            __m256i const mask = op == SIMD_CMP_EQ   ? _mm256_cmpeq_epi32(v, vval)
+                                 : op == SIMD_CMP_LT ? _mm256_cmpgt_epi32(vval, v)
+                                                     : _mm256_cmpgt_epi32(v, vval);
+            /* Matching lanes are all ones, i.e -1 */
+            acc = _mm256_sub_epi32(acc, mask);
+        }
+        count += avx2_hsum(acc);
+    }
+    return count + scalar_count(arr + i, n - i, op, value, bias);
+}
+
+/*
+The lanes kept by every 4 bit mask, one octal digit each - the lowest digit is the lane that goes first
+
+Two entries make up the permutation for a group of 8 lanes, the high one shifted past the low one's kept lanes
+*/
+static uint16_t const avx2_compact_lanes[16] = {0,  0,   01,  010,  02,  020,  021,  0210,
+                                                03, 030, 031, 0310, 032, 0320, 0321, 03210};
+
+/* Kept bytes are 1 - negating them sets their sign bit, which `movemask` collects */
+__attribute__((target("sse2"))) static inline unsigned keep_mask(__m128i bytes)
+{
+    return (unsigned)_mm_movemask_epi8(_mm_sub_epi8(_mm_setzero_si128(), bytes));
+}
+
+__attribute__((target("avx2"))) static size_t avx2_compact(uint32_t const* in, uint8_t const* keep, size_t n,
+                                                           uint32_t* out)
+{
+    __m256i const shifts = _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21);
+    size_t len           = 0;
+    size_t i             = 0;
+    for (; i + 8 <= n; i += 8) {
+        unsigned const mask = keep_mask(_mm_loadl_epi64((__m128i const*)(keep + i)));
+        unsigned const lo   = mask & 0xF;
+        unsigned const hi   = mask >> 4;
+        /* The high group's lanes are 4 more than its entry says - i.e 4 is added to every digit */
+        uint32_t const lanes = avx2_compact_lanes[lo] |
+                               (uint32_t)(avx2_compact_lanes[hi] + 04444) << (3 * __builtin_popcount(lo));
+        /* `permutevar8x32` only looks at the low 3 bits of every index */
+        __m256i const idx = _mm256_srlv_epi32(_mm256_set1_epi32((int)lanes), shifts);
+        __m256i const v   = _mm256_loadu_si256((__m256i const*)(in + i));
+        _mm256_storeu_si256((__m256i*)(out + len), _mm256_permutevar8x32_epi32(v, idx));
+        len += (size_t)__builtin_popcount(mask);
+    }
+    return len + scalar_compact(in + i, keep + i, n - i, out + len);
+}
+
+static SimdKernels const avx2_kernels = {.sum     = avx2_sum,
+                                         .dot     = avx2_dot,
+                                         .min     = avx2_min,
+                                         .max     = avx2_max,
+                                         .count   = avx2_count,
+                                         .compact = avx2_compact,
+                                         .name    = "avx2"};
+
+/* AVX-512 kernels */
+
+__attribute__((target("avx512f"))) static size_t avx512_compact(uint32_t const* in, uint8_t const* keep, size_t n,
+                                                                uint32_t* out)
+{
+    size_t len = 0;
+    size_t i   = 0;
+    for (; i + 16 <= n; i += 16) {
+        __mmask16 const mask = (__mmask16)keep_mask(_mm_loadu_si128((__m128i const*)(keep + i)));
+        __m512i const v      = _mm512_loadu_si512(in + i);
+        _mm512_storeu_si512(out + len, _mm512_maskz_compress_epi32(mask, v));
+        len += (size_t)__builtin_popcount(mask);
+    }
+    return len + avx2_compact(in + i, keep + i, n - i, out + len);
+}
+
+static SimdKernels const avx512_kernels = {.sum     = avx2_sum,
+                                           .dot     = avx2_dot,
+                                           .min     = avx2_min,
+                                           .max     = avx2_max,
+                                           .count   = avx2_count,
+                                           .compact = avx512_compact,
+                                           .name    = "avx512"};
+
+#endif /* SIMD_X86 */
+
+SimdKernels const* simd_kernels_for(SimdLevel level)
+{
+    switch (level) {
+        case SIMD_SCALAR: return &scalar_kernels;
+#if SIMD_X86
+        case SIMD_SSE2: return __builtin_cpu_supports("sse2") ? &sse2_kernels : NULL;
+        case SIMD_AVX2: return __builtin_cpu_supports("avx2") ? &avx2_kernels : NULL;
+        case SIMD_AVX512: return __builtin_cpu_supports("avx512f") ? &avx512_kernels : NULL;
+#else
+        case SIMD_SSE2: return NULL;
+        case SIMD_AVX2: return NULL;
+        case SIMD_AVX512: return NULL;
+#endif
+    }
+    return NULL;
+}
+
+SimdKernels const* simd_kernels(void)
+{
+    SimdKernels const* kernels = simd_kernels_for(SIMD_AVX512);
+    if (kernels == NULL) {
+        kernels = simd_kernels_for(SIMD_AVX2);
+    }
+    if (kernels == NULL) {
+        kernels = simd_kernels_for(SIMD_SSE2);
+    }
+    return kernels == NULL ? &scalar_kernels : kernels;
+}
@@ -0,0 +1,67 @@
+#ifndef IT_SIMD_H
+#define IT_SIMD_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+Vectorized kernels over contiguous arrays of 32 bit integers, used by the reduction sinks in `iterable_utils.h`
+
+There's a table of kernels for every instruction set they're written for - plain C, SSE2, AVX2 and AVX-512 - and
+`simd_kernels()` picks the best one the running CPU supports. The SSE2, AVX2 and AVX-512 kernels are only available on
+x86 with GCC compatible compilers, they're compiled with function level target attributes - so the rest of the program
+doesn't need to be built for AVX2. Only `compact` has an AVX-512 kernel, the AVX-512 table uses the AVX2 ones for the
+rest.
+
+Sums and dot products wrap around on overflow, so they're bit for bit the same for signed and unsigned elements. The
+kernels that compare elements take a `bias` - `0` compares them as signed, `SIMD_UNSIGNED_BIAS` as unsigned.
+*/
+
+/* Pass as `bias` to compare elements as unsigned - flipping the sign bit maps unsigned order onto signed order */
+#define SIMD_UNSIGNED_BIAS UINT32_C(0x80000000)
+
+/* Comparisons the `count` kernel supports - element `op` value */
+typedef enum
+{
+    SIMD_CMP_EQ,
+    SIMD_CMP_LT,
+    SIMD_CMP_GT
+} SimdCmp;
+
+typedef enum
+{
+    SIMD_SCALAR,
+    SIMD_SSE2,
+    SIMD_AVX2,
+    SIMD_AVX512
+} SimdLevel;
+
+typedef struct
+{
+    /* Sum of the `n` elements at `arr` */
+    uint32_t (*const sum)(uint32_t const* arr, size_t n);
+    /* Sum of the products of the `n` elements at `a` and `b` */
+    uint32_t (*const dot)(uint32_t const* a, uint32_t const* b, size_t n);
+    /* Smallest and largest of the `n` elements at `arr`, `n` must not be 0 */
+    uint32_t (*const min)(uint32_t const* arr, size_t n, uint32_t bias);
+    uint32_t (*const max)(uint32_t const* arr, size_t n, uint32_t bias);
+    /* Number of the `n` elements at `arr` for which `element op value` holds */
+    size_t (*const count)(uint32_t const* arr, size_t n, SimdCmp op, uint32_t value, uint32_t bias);
+    /*
+    Copy the elements of the `n` at `in` whose `keep` byte is 1 (the rest must be 0) to `out`, in order - returns how
+    many were copied
+
+    `out` must have room for all `n` elements, whatever is past the copied ones is clobbered. It may be `in` itself
+    */
+    size_t (*const compact)(uint32_t const* in, uint8_t const* keep, size_t n, uint32_t* out);
+    /* Name of the instruction set, e.g "avx2" */
+    char const* const name;
+} SimdKernels;
+
+/* The kernels for the best instruction set the running CPU supports */
+SimdKernels const* simd_kernels(void);
+
+/* The kernels for given instruction set, or `NULL` if the running CPU (or compiler) doesn't support it */
+SimdKernels const* simd_kernels_for(SimdLevel level);
+
+#endif /* !IT_SIMD_H */
@@ -0,0 +1,123 @@
+#ifndef IT_SKIP_H
+#define IT_SKIP_H
+
+#include "../func_iter.h"
+#include "arena.h"
+
+/*
+Utilities to define an IterSkip type for a specific element type and its corresponding iterator impl.
+
+An IterSkip struct keeps track of how many elements of its source iterable are still to be skipped - the iterator impl
+for this struct skips all of them (with `iter_advance_by`) the first time it's asked for anything, and then yields the
+rest of the source's elements.
+
+This allows to implement the `skip_from` macro - which takes in the source iterable, and the number of elements to skip,
+and returns an iterable of the elements after them. Skipping costs whatever the source's `advance_by` costs - O(1) for
+an array or a range, O(log n) for the fibonacci sequence, and `n` calls to `next` for sources that can't do better.
+
+This is identical to the `skip` (or `drop`) function iterator typeclasses usually have.
+*/
+
+#define IterSkip(ElmntType) IterSkip##ElmntType
+
+#define DefineIterSkip(ElmntType)                                                                                      \
+    typedef struct                                                                                                     \
+    {                                                                                                                  \
+        size_t pending;                                                                                                \
+        Iterable(ElmntType) const src;                                                                                 \
+    } IterSkip(ElmntType)
+
+/* Name of the function that wraps an IterSkip(ElmntType) for given ElmntType into an iterable */
+#define prep_iterskip_of(ElmntType) CONCAT(CONCAT(prep_, IterSkip(ElmntType)), _itr)
+
+/* Build an iterable of the elements of given `it` iterable after its first `n` - lazily, nothing is skipped yet */
+#define skip_from(it, n, T) prep_iterskip_of(T)(&(IterSkip(T)){.pending = n, .src = it})
+
+/* Same as `skip_from`, but the `IterSkip` is stored in given `IterArena*` - so the iterable can outlive the scope */
+#define arena_skip_from(arena, it, n, T)                                                                               \
+    prep_iterskip_of(T)(arena_new(arena, IterSkip(T), .pending = n, .src = it))
+
+/*
+Define the iterator implementation function for an IterSkip struct
+
+Every function but `size_hint` first skips the pending elements, and is then forwarded to the source iterable as it is
+- batches, spans, progressions, skipping more elements and splitting
+The size hint is the source's hint, less the pending elements
+
+The function is named `prep_iterskip_of(ElmntType)`
+*/
+#define define_iterskip_func(ElmntType)                                                                                \
+    /* Skip the pending elements, if they haven't been skipped yet */                                                  \
+    static void CONCAT(IterSkip(ElmntType), _flush)(IterSkip(ElmntType) * self)                                        \
+    {                                                                                                                  \
+        if (self->pending != 0) {                                                                                      \
+            iter_advance_by(self->src, self->pending, ElmntType);                                                      \
+            self->pending = 0;                                                                                         \
+        }                                                                                                              \
+    }                                                                                                                  \
+    static Maybe(ElmntType) CONCAT(IterSkip(ElmntType), _nxt)(IterSkip(ElmntType) * self)                              \
+    {                                                                                                                  \
+        CONCAT(IterSkip(ElmntType), _flush)(self);                                                                     \
+        Iterable(ElmntType) const srcit = self->src;                                                                   \
+        return srcit.tc->next(srcit.self);                                                                             \
+    }                                                                                                                  \
+    static size_t CONCAT(IterSkip(ElmntType), _batch)(IterSkip(ElmntType) * self, ElmntType * out, size_t cap)         \
+    {                                                                                                                  \
+        CONCAT(IterSkip(ElmntType), _flush)(self);                                                                     \
+        return iter_next_batch(self->src, out, cap, ElmntType);                                                        \
+    }                                                                                                                  \
+    static SizeHint CONCAT(IterSkip(ElmntType), _hint)(IterSkip(ElmntType) * self)                                     \
+    {                                                                                                                  \
+        SizeHint const src = iter_size_hint(self->src, ElmntType);                                                     \
+        /* An infinite source stays infinite, however many elements are skipped */                                     \
+        if (src.lower == SIZE_MAX && is_nothing_of(src.upper, size_t)) {                                               \
+            return src;                                                                                                \
+        }                                                                                                              \
+        size_t const lower = src.lower > self->pending ? src.lower - self->pending : 0;                                \
+        if (is_nothing_of(src.upper, size_t)) {                                                                        \
+            return (SizeHint){.lower = lower, .upper = Nothing(size_t)};                                               \
+        }                                                                                                              \
+        size_t const srcmax = from_just_(src.upper);                                                                   \
+        size_t const upper  = srcmax > self->pending ? srcmax - self->pending : 0;                                     \
+        return (SizeHint){.lower = lower, .upper = Just(upper, size_t)};                                               \
+    }                                                                                                                  \
+    static bool CONCAT(IterSkip(ElmntType), _span)(IterSkip(ElmntType) * self, size_t max, Span(ElmntType) * out)      \
+    {                                                                                                                  \
+        CONCAT(IterSkip(ElmntType), _flush)(self);                                                                     \
+        return iter_as_span(self->src, max, out, ElmntType);                                                           \
+    }                                                                                                                  \
+    static bool CONCAT(IterSkip(ElmntType), _prog)(IterSkip(ElmntType) * self, size_t max,                             \
+                                                   Progression(ElmntType) * out)                                       \
+    {                                                                                                                  \
+        CONCAT(IterSkip(ElmntType), _flush)(self);                                                                     \
+        return iter_as_progression(self->src, max, out, ElmntType);                                                    \
+    }                                                                                                                  \
+    static size_t CONCAT(IterSkip(ElmntType), _advance)(IterSkip(ElmntType) * self, size_t n)                          \
+    {                                                                                                                  \
+        CONCAT(IterSkip(ElmntType), _flush)(self);                                                                     \
+        return iter_advance_by(self->src, n, ElmntType);                                                               \
+    }                                                                                                                  \
+    static IterSkip(ElmntType) * CONCAT(IterSkip(ElmntType), _split)(IterSkip(ElmntType) * self, Allocator alloc)      \
+    {                                                                                                                  \
+        CONCAT(IterSkip(ElmntType), _flush)(self);                                                                     \
+        Iterable(ElmntType) front;                                                                                     \
+        if (!iter_split(self->src, alloc, &front, ElmntType)) {                                                        \
+            return NULL;                                                                                               \
+        }                                                                                                              \
+        return alloc_new(alloc, IterSkip(ElmntType), .pending = 0, .src = front);                                      \
+    }                                                                                                                  \
+    impl_next_batch(IterSkip(ElmntType)*, ElmntType, CONCAT(IterSkip(ElmntType), _batch))                              \
+    impl_size_hint(IterSkip(ElmntType)*, CONCAT(IterSkip(ElmntType), _hint))                                           \
+    impl_as_span(IterSkip(ElmntType)*, ElmntType, CONCAT(IterSkip(ElmntType), _span))                                  \
+    impl_as_progression(IterSkip(ElmntType)*, ElmntType, CONCAT(IterSkip(ElmntType), _prog))                           \
+    impl_advance_by(IterSkip(ElmntType)*, CONCAT(IterSkip(ElmntType), _advance))                                       \
+    impl_split(IterSkip(ElmntType)*, CONCAT(IterSkip(ElmntType), _split))                                              \
+    impl_iterator_with(IterSkip(ElmntType)*, ElmntType, prep_iterskip_of(ElmntType),                                   \
+                       CONCAT(IterSkip(ElmntType), _nxt), iter_slot(next_batch, CONCAT(IterSkip(ElmntType), _batch)),  \
+                       iter_slot(size_hint, CONCAT(IterSkip(ElmntType), _hint)),                                       \
+                       iter_slot(as_span, CONCAT(IterSkip(ElmntType), _span)),                                         \
+                       iter_slot(as_progression, CONCAT(IterSkip(ElmntType), _prog)),                                  \
+                       iter_slot(advance_by, CONCAT(IterSkip(ElmntType), _advance)),                                   \
+                       iter_slot(split, CONCAT(IterSkip(ElmntType), _split)))
+
+#endif /* !IT_SKIP_H */
@@ -2,6 +2,7 @@
 #define IT_TAKE_H
 
 #include "../func_iter.h"
+#include "arena.h"
 
 /*
 Utilities to define an IterTake type for a specific element type and its corresponding iterator impl.
@@ -32,9 +33,19 @@ This is identical to the `take` function iterator typeclasses usually have.
 /* Build an iterable that consists of at most `n` elements from given `it` iterable */
 #define take_from(it, n, T) prep_itertake_of(T)(&(IterTake(T)){.i = 0, .limit = n, .src = it})
 
+/* Same as `take_from`, but the `IterTake` is stored in given `IterArena*` - so the iterable can outlive the scope */
+#define arena_take_from(arena, it, n, T)                                                                               \
+    prep_itertake_of(T)(arena_new(arena, IterTake(T), .i = 0, .limit = n, .src = it))
+
 /*
 Define the iterator implementation function for an IterTake struct
 
+Batches are forwarded to the source iterable, capped at the number of elements left to take
+The size hint is the source's hint, capped the same way - it is always bounded above
+If the source hands out spans, so does the IterTake - shortened to the number of elements left to take
+Progressions are forwarded the same way, so taking from a range is an O(1) slice of it
+Skipping elements is forwarded to the source iterable too, capped the same way
+
 The function is named `prep_itertake_of(ElmntType)`
 */
 #define define_itertake_func(ElmntType)                                                                                \
@@ -47,6 +58,59 @@ The function is named `prep_itertake_of(ElmntType)`
         }                                                                                                              \
         return Nothing(ElmntType);                                                                                     \
     }                                                                                                                  \
-    impl_iterator(IterTake(ElmntType)*, ElmntType, prep_itertake_of(ElmntType), CONCAT(IterTake(ElmntType), _nxt))
+    static size_t CONCAT(IterTake(ElmntType), _batch)(IterTake(ElmntType) * self, ElmntType * out, size_t cap)         \
+    {                                                                                                                  \
+        size_t const left = self->limit - self->i;                                                                     \
+        size_t const n    = iter_next_batch(self->src, out, cap < left ? cap : left, ElmntType);                       \
+        self->i += n;                                                                                                  \
+        return n;                                                                                                      \
+    }                                                                                                                  \
+    static SizeHint CONCAT(IterTake(ElmntType), _hint)(IterTake(ElmntType) * self)                                     \
+    {                                                                                                                  \
+        size_t const left   = self->limit - self->i;                                                                   \
+        SizeHint const src  = iter_size_hint(self->src, ElmntType);                                                    \
+        size_t const srcmax = is_just(src.upper) ? from_just_(src.upper) : SIZE_MAX;                                   \
+        size_t const lower  = src.lower < left ? src.lower : left;                                                     \
+        size_t const upper  = srcmax < left ? srcmax : left;                                                           \
+        return (SizeHint){.lower = lower, .upper = Just(upper, size_t)};                                               \
+    }                                                                                                                  \
+    static bool CONCAT(IterTake(ElmntType), _span)(IterTake(ElmntType) * self, size_t max, Span(ElmntType) * out)      \
+    {                                                                                                                  \
+        size_t const left = self->limit - self->i;                                                                     \
+        if (!iter_as_span(self->src, max < left ? max : left, out, ElmntType)) {                                       \
+            return false;                                                                                              \
+        }                                                                                                              \
+        self->i += out->len;                                                                                           \
+        return true;                                                                                                   \
+    }                                                                                                                  \
+    static bool CONCAT(IterTake(ElmntType), _prog)(IterTake(ElmntType) * self, size_t max,                             \
+                                                   Progression(ElmntType) * out)                                       \
+    {                                                                                                                  \
+        size_t const left = self->limit - self->i;                                                                     \
+        if (!iter_as_progression(self->src, max < left ? max : left, out, ElmntType)) {                                \
+            return false;                                                                                              \
+        }                                                                                                              \
+        self->i += out->len;                                                                                           \
+        return true;                                                                                                   \
+    }                                                                                                                  \
+    static size_t CONCAT(IterTake(ElmntType), _advance)(IterTake(ElmntType) * self, size_t n)                          \
+    {                                                                                                                  \
+        size_t const left = self->limit - self->i;                                                                     \
+        size_t const skip = iter_advance_by(self->src, n < left ? n : left, ElmntType);                                \
+        self->i += skip;                                                                                               \
+        return skip;                                                                                                   \
+    }                                                                                                                  \
+    impl_next_batch(IterTake(ElmntType)*, ElmntType, CONCAT(IterTake(ElmntType), _batch))                              \
+    impl_size_hint(IterTake(ElmntType)*, CONCAT(IterTake(ElmntType), _hint))                                           \
+    impl_as_span(IterTake(ElmntType)*, ElmntType, CONCAT(IterTake(ElmntType), _span))                                  \
+    impl_as_progression(IterTake(ElmntType)*, ElmntType, CONCAT(IterTake(ElmntType), _prog))                           \
+    impl_advance_by(IterTake(ElmntType)*, CONCAT(IterTake(ElmntType), _advance))                                       \
+    impl_iterator_with(IterTake(ElmntType)*, ElmntType, prep_itertake_of(ElmntType),                                   \
+                       CONCAT(IterTake(ElmntType), _nxt),                                                              \
+                       iter_slot(next_batch, CONCAT(IterTake(ElmntType), _batch)),                                     \
+                       iter_slot(size_hint, CONCAT(IterTake(ElmntType), _hint)),                                       \
+                       iter_slot(as_span, CONCAT(IterTake(ElmntType), _span)),                                         \
+                       iter_slot(as_progression, CONCAT(IterTake(ElmntType), _prog)),                                  \
+                       iter_slot(advance_by, CONCAT(IterTake(ElmntType), _advance)))
 
 #endif /* !IT_TAKE_H */
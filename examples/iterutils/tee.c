@@ -0,0 +1,196 @@
+#include "tee.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct TeeBuffer
+{
+    /*
+    Elements `base` up to `end` (counted from the start of the source) are buffered, element `i` is in slot
+    `i & mask`. `base` only moves once every cursor has moved past it - and never, for a cache
+    */
+    unsigned char* slots;
+    size_t mask;
+    size_t elem_size;
+    size_t base;
+    size_t end;
+    /* Set once the source is exhausted */
+    bool done;
+    bool cache;
+    /* The cursors made along with the buffer */
+    TeeCursor* cursors;
+    size_t ncursors;
+    /* The cursors made by `tee_buffer_replay`, allocated one by one */
+    TeeCursor** replays;
+    size_t nreplays;
+    size_t replays_cap;
+    TeeFill fill;
+    TeeHint hint;
+    void* src;
+};
+
+static void* tee_malloc(size_t size)
+{
+    void* const mem = malloc(size);
+    if (mem == NULL) {
+        fprintf(stderr, "OOM in tee");
+        exit(1);
+    }
+    return mem;
+}
+
+TeeCursor* tee_buffer_new(void const* src, size_t src_size, TeeFill fill, TeeHint hint, size_t elem_size,
+                          size_t ncursors, bool cache)
+{
+    size_t cap = 1;
+    while (cap < ITER_BATCH_SIZE) {
+        cap *= 2;
+    }
+    TeeBuffer* const buf = tee_malloc(sizeof(*buf));
+    *buf = (TeeBuffer){.slots       = tee_malloc(cap * elem_size),
+                       .mask        = cap - 1,
+                       .elem_size   = elem_size,
+                       .base        = 0,
+                       .end         = 0,
+                       .done        = false,
+                       .cache       = cache,
+                       .cursors     = tee_malloc((ncursors == 0 ? 1 : ncursors) * sizeof(TeeCursor)),
+                       .ncursors    = ncursors,
+                       .replays     = NULL,
+                       .nreplays    = 0,
+                       .replays_cap = 0,
+                       .fill        = fill,
+                       .hint        = hint,
+                       .src         = tee_malloc(src_size)};
+    memcpy(buf->src, src, src_size);
+    for (size_t i = 0; i < ncursors; i++) {
+        memcpy(buf->cursors + i, &(TeeCursor){.buf = buf, .pos = 0}, sizeof(TeeCursor));
+    }
+    return buf->cursors;
+}
+
+TeeCursor* tee_buffer_replay(TeeBuffer* buf)
+{
+    if (buf->nreplays == buf->replays_cap) {
+        buf->replays_cap = buf->replays_cap == 0 ? 4 : buf->replays_cap * 2;
+        TeeCursor** const replays = realloc(buf->replays, buf->replays_cap * sizeof(*replays));
+        if (replays == NULL) {
+            fprintf(stderr, "OOM in tee_buffer_replay");
+            exit(1);
+        }
+        buf->replays = replays;
+    }
+    TeeCursor* const cur = tee_malloc(sizeof(*cur));
+    memcpy(cur, &(TeeCursor){.buf = buf, .pos = 0}, sizeof(*cur));
+    buf->replays[buf->nreplays++] = cur;
+    return cur;
+}
+
+/* Copy `n` elements into the slots of elements `i` onwards, of a ring of `mask + 1` slots */
+static void ring_put(unsigned char* slots, size_t mask, size_t es, size_t i, void const* src, size_t n)
+{
+    size_t const slot = i & mask;
+    size_t const head = mask + 1 - slot < n ? mask + 1 - slot : n;
+    memcpy(slots + slot * es, src, head * es);
+    memcpy(slots, (unsigned char const*)src + head * es, (n - head) * es);
+}
+
+/* Copy `n` elements out of the slots of elements `i` onwards, of a ring of `mask + 1` slots */
+static void ring_get(unsigned char const* slots, size_t mask, size_t es, size_t i, void* out, size_t n)
+{
+    size_t const slot = i & mask;
+    size_t const head = mask + 1 - slot < n ? mask + 1 - slot : n;
+    memcpy(out, slots + slot * es, head * es);
+    memcpy((unsigned char*)out + head * es, slots, (n - head) * es);
+}
+
+/* Double the size of the ring, which must be full - every element is moved to its slot in the new one */
+static void tee_buffer_grow(TeeBuffer* buf)
+{
+    size_t const cap           = buf->mask + 1;
+    size_t const es            = buf->elem_size;
+    unsigned char* const grown = tee_malloc(2 * cap * es);
+    /* The elements run from `base`'s slot to the end of the ring, and wrap around to just before that slot */
+    size_t const first = buf->base & buf->mask;
+    ring_put(grown, 2 * cap - 1, es, buf->base, buf->slots + first * es, cap - first);
+    ring_put(grown, 2 * cap - 1, es, buf->base + cap - first, buf->slots, first);
+    free(buf->slots);
+    buf->slots = grown;
+    buf->mask  = 2 * cap - 1;
+}
+
+/* Pull the next batch out of the source into the ring, returns `false` once it's exhausted */
+static bool tee_buffer_pull(TeeBuffer* buf)
+{
+    if (buf->done) {
+        return false;
+    }
+    if (buf->end - buf->base == buf->mask + 1) {
+        tee_buffer_grow(buf);
+    }
+    /* Pull straight into the free slots - up to the oldest element, or the end of the ring, whichever comes first */
+    size_t const slot  = buf->end & buf->mask;
+    size_t const room  = buf->mask + 1 - (buf->end - buf->base);
+    size_t const tail  = buf->mask + 1 - slot;
+    size_t const space = room < tail ? room : tail;
+    size_t const want  = space < ITER_BATCH_SIZE ? space : ITER_BATCH_SIZE;
+    size_t const n     = buf->fill(buf->src, buf->slots + slot * buf->elem_size, want);
+    if (n == 0) {
+        buf->done = true;
+        return false;
+    }
+    buf->end += n;
+    return true;
+}
+
+size_t tee_cursor_read(TeeCursor* cur, void* out, size_t cap)
+{
+    TeeBuffer* const buf = cur->buf;
+    if (cap == 0 || (cur->pos == buf->end && !tee_buffer_pull(buf))) {
+        return 0;
+    }
+    size_t const avail = buf->end - cur->pos;
+    size_t const n     = cap < avail ? cap : avail;
+    ring_get(buf->slots, buf->mask, buf->elem_size, cur->pos, out, n);
+    bool const slowest = cur->pos == buf->base;
+    cur->pos += n;
+    if (slowest && !buf->cache) {
+        /* The cursor may have been the last one holding on to the oldest elements */
+        size_t base = cur->pos;
+        for (size_t i = 0; i < buf->ncursors; i++) {
+            base = buf->cursors[i].pos < base ? buf->cursors[i].pos : base;
+        }
+        buf->base = base;
+    }
+    return n;
+}
+
+SizeHint tee_cursor_hint(TeeCursor const* cur)
+{
+    TeeBuffer* const buf = cur->buf;
+    size_t const ahead   = buf->end - cur->pos;
+    if (buf->done) {
+        return size_hint_exact(ahead);
+    }
+    SizeHint const src = buf->hint(buf->src);
+    size_t const lower = src.lower > SIZE_MAX - ahead ? SIZE_MAX : src.lower + ahead;
+    if (is_nothing(src.upper) || from_just_(src.upper) > SIZE_MAX - ahead) {
+        return (SizeHint){.lower = lower, .upper = Nothing(size_t)};
+    }
+    return (SizeHint){.lower = lower, .upper = Just(from_just_(src.upper) + ahead, size_t)};
+}
+
+void tee_buffer_free(TeeBuffer* buf)
+{
+    for (size_t i = 0; i < buf->nreplays; i++) {
+        free(buf->replays[i]);
+    }
+    free(buf->replays);
+    free(buf->cursors);
+    free(buf->slots);
+    free(buf->src);
+    free(buf);
+}
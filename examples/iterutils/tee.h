@@ -0,0 +1,178 @@
+#ifndef IT_TEE_H
+#define IT_TEE_H
+
+#include "../func_iter.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+Utilities to consume an iterable several times over, while only evaluating it once
+
+`tee` splits a source iterable into `n` cursors, each one yielding every element of the source - independently of the
+others. Elements are pulled out of the source (in batches, see `iter_next_batch`) as the fastest cursor needs them,
+into a ring buffer shared by all cursors. The ring only holds the window between the slowest and the fastest cursor -
+an element is dropped as soon as every cursor has moved past it, and the ring doubles in size whenever the window
+outgrows it. So cursors that move in lockstep need next to no memory, while a cursor that is never consumed keeps
+everything after it around.
+
+`cache` keeps every element pulled out of the source instead, so it can be replayed from the start any number of
+times - with `cache_replay`, even once the source has been exhausted.
+
+The source iterable is only touched by the cursors from then on - it (and whatever its `self` points to) must outlive
+them, and must not be used by anyone else meanwhile. All of the cursors share one buffer on the heap, which must be
+freed (once, through any one of them) with `free_tee`.
+
+Example-
+
+Iterable(int) cursors[2];
+tee(parsedit, 2, cursors, int);
+int const sum        = sum_intit(cursors[0]);
+Maybe(int) const max = max_intit(cursors[1]);
+free_tee(cursors[0], int);
+*/
+
+/* The buffer shared by all the cursors over a source */
+typedef struct TeeBuffer TeeBuffer;
+
+/* A cursor over a `TeeBuffer` - `pos` is the number of elements it has yielded */
+typedef struct
+{
+    TeeBuffer* const buf;
+    size_t pos;
+} TeeCursor;
+
+/* Pull up to `cap` elements out of the source iterable at `src` into `out`, returns how many were pulled */
+typedef size_t (*TeeFill)(void* src, void* out, size_t cap);
+
+/* Size hint of the source iterable at `src` */
+typedef SizeHint (*TeeHint)(void* src);
+
+/*
+Make a buffer of elements of `elem_size` bytes pulled out of a source with `fill`, and `ncursors` cursors over it -
+returns the first one, the rest follow it in memory
+
+The `src_size` bytes at `src` (the source iterable) are copied into the buffer, `fill` and `hint` are called with a
+pointer to that copy. If `cache` is set, every element is kept for replays. Exits on OOM
+*/
+TeeCursor* tee_buffer_new(void const* src, size_t src_size, TeeFill fill, TeeHint hint, size_t elem_size,
+                          size_t ncursors, bool cache);
+
+/* Make a new cursor over given buffer, made with `cache` set, starting from the first element of the source */
+TeeCursor* tee_buffer_replay(TeeBuffer* buf);
+
+/* Copy up to `cap` elements, from the cursor on, into `out` - returns how many were copied, 0 once there's none left */
+size_t tee_cursor_read(TeeCursor* cur, void* out, size_t cap);
+
+/* Number of elements left for given cursor - the buffered ones ahead of it, and what the source has left */
+SizeHint tee_cursor_hint(TeeCursor const* cur);
+
+/* Free the buffer, and all of the cursors over it */
+void tee_buffer_free(TeeBuffer* buf);
+
+#define Tee(T) Tee##T
+
+/* A cursor over a `TeeBuffer` of `T`s */
+#define DefineTee(T) typedef TeeCursor Tee(T)
+
+/* Name of the function that splits an `Iterable(T)` into several cursors */
+#define tee_of(T) CONCAT(tee_, T)
+
+/* Name of the function that caches an `Iterable(T)` for replays */
+#define cache_of(T) CONCAT(cache_, T)
+
+/* Name of the function that replays an `Iterable(T)` built by `cache_of(T)` */
+#define cache_replay_of(T) CONCAT(cache_replay_, T)
+
+/* Name of the function that frees the buffer behind the cursors built by `tee_of(T)`, or `cache_of(T)` */
+#define free_tee_of(T) CONCAT(free_tee_, T)
+
+/*
+Split given `it` iterable into `n` independent cursors, each one yielding all of its elements - stored in the array of
+`n` `Iterable(T)`s at `out`
+
+The source is only evaluated once. The cursors must be freed with `free_tee` - whether they've been consumed or not
+*/
+#define tee(it, n, out, T) tee_of(T)(it, n, out)
+
+/*
+Build an `Iterable(T)` that yields the elements of given `it` iterable, and keeps all of them - so they can be yielded
+again by `cache_replay`
+
+The source is only evaluated once. The cache must be freed with `free_tee` (or `free_cache`)
+*/
+#define cache(it, T) cache_of(T)(it)
+
+/* Build an `Iterable(T)` that yields the elements of the cache given `it` iterable (built by `cache`) is over, again */
+#define cache_replay(it, T) cache_replay_of(T)(it)
+
+/* Free the buffer behind given `it` iterable, built by `tee` or `cache`, along with every cursor over it */
+#define free_tee(it, T) free_tee_of(T)(it)
+
+/* Same as `free_tee` */
+#define free_cache(it, T) free_tee_of(T)(it)
+
+/*
+Define the `next`, `next_batch` and `size_hint` functions of `Tee(T)`, implement `Iterator` for it, and define
+`tee_of(T)`, `cache_of(T)`, `cache_replay_of(T)` and `free_tee_of(T)`-
+
+void tee_of(T)(Iterable(T) it, size_t n, Iterable(T)* out);
+Iterable(T) cache_of(T)(Iterable(T) it);
+Iterable(T) cache_replay_of(T)(Iterable(T) it);
+void free_tee_of(T)(Iterable(T) it);
+
+`next` and `next_batch` copy out of the buffer, and only go to the source once the cursor has caught up with the
+fastest one
+
+This should be called in a source file
+*/
+#define define_tee_func(T)                                                                                             \
+    static size_t CONCAT(Tee(T), _fill)(void* src, void* out, size_t cap)                                              \
+    {                                                                                                                  \
+        return iter_next_batch(*(Iterable(T)*)src, out, cap, T);                                                       \
+    }                                                                                                                  \
+    static SizeHint CONCAT(Tee(T), _srchint)(void* src) { return iter_size_hint(*(Iterable(T)*)src, T); }              \
+    static Maybe(T) CONCAT(Tee(T), _nxt)(Tee(T) * self)                                                                \
+    {                                                                                                                  \
+        T x;                                                                                                           \
+        if (tee_cursor_read(self, &x, 1) == 0) {                                                                       \
+            return Nothing(T);                                                                                         \
+        }                                                                                                              \
+        return Just(x, T);                                                                                             \
+    }                                                                                                                  \
+    static size_t CONCAT(Tee(T), _batch)(Tee(T) * self, T * out, size_t cap)                                           \
+    {                                                                                                                  \
+        return tee_cursor_read(self, out, cap);                                                                        \
+    }                                                                                                                  \
+    static SizeHint CONCAT(Tee(T), _hint)(Tee(T) * self) { return tee_cursor_hint(self); }                             \
+    impl_next_batch(Tee(T)*, T, CONCAT(Tee(T), _batch))                                                                \
+    impl_size_hint(Tee(T)*, CONCAT(Tee(T), _hint))                                                                     \
+    impl_default_next_into(Tee(T)*, T, CONCAT(Tee(T), _nxt))                                                           \
+    impl_iterator_with(Tee(T)*, T, CONCAT(prep_, Tee(T)), CONCAT(Tee(T), _nxt),                                        \
+                       iter_slot(next_batch, CONCAT(Tee(T), _batch)), iter_slot(size_hint, CONCAT(Tee(T), _hint)),     \
+                       iter_default_into(CONCAT(Tee(T), _nxt)))                                                        \
+    void tee_of(T)(Iterable(T) it, size_t n, Iterable(T) * out)                                                        \
+    {                                                                                                                  \
+        Tee(T)* const cursors = tee_buffer_new(&it, sizeof(it), CONCAT(Tee(T), _fill), CONCAT(Tee(T), _srchint),       \
+                                               sizeof(T), n, false);                                                   \
+        for (size_t i = 0; i < n; i++) {                                                                               \
+            out[i] = CONCAT(prep_, Tee(T))(cursors + i);                                                               \
+        }                                                                                                              \
+    }                                                                                                                  \
+    Iterable(T) cache_of(T)(Iterable(T) it)                                                                            \
+    {                                                                                                                  \
+        return CONCAT(prep_, Tee(T))(tee_buffer_new(&it, sizeof(it), CONCAT(Tee(T), _fill), CONCAT(Tee(T), _srchint),  \
+                                                    sizeof(T), 1, true));                                              \
+    }                                                                                                                  \
+    Iterable(T) cache_replay_of(T)(Iterable(T) it)                                                                     \
+    {                                                                                                                  \
+        Tee(T)* const self = it.self;                                                                                  \
+        return CONCAT(prep_, Tee(T))(tee_buffer_replay(self->buf));                                                    \
+    }                                                                                                                  \
+    void free_tee_of(T)(Iterable(T) it)                                                                                \
+    {                                                                                                                  \
+        Tee(T)* const self = it.self;                                                                                  \
+        tee_buffer_free(self->buf);                                                                                    \
+    }
+
+#endif /* !IT_TEE_H */
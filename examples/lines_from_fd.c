@@ -0,0 +1,58 @@
+#define _POSIX_C_SOURCE 200809L /* For `pipe` */
+
+#include "examples.h"
+#include "fd_iterable.h"
+#include "func_iter.h"
+#include "iterutils/iterable_utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Create a pipe, write `content` into it and close its write end - returns the read end, exits on failure */
+static int pipe_with(char const* content)
+{
+    int fds[2];
+    if (pipe(fds) == -1) {
+        perror("pipe in pipe_with");
+        exit(1);
+    }
+    /* Small enough to fit in the pipe's buffer, so this doesn't block */
+    size_t const len = strlen(content);
+    if (write(fds[1], content, len) != (ssize_t)len) {
+        perror("write in pipe_with");
+        exit(1);
+    }
+    close(fds[1]);
+    return fds[0];
+}
+
+void test_fd_lines(void)
+{
+    /* Tiny buffers - so lines span refills, and the long line doesn't fit in a buffer at all */
+    int const fd     = pipe_with("short\na line longer than the buffer\n\nlast");
+    FdBuffer linebuf = new_fdbuffer(fd, 8);
+
+    Iterable(StrView) linesit = fd_lines_into_iter(&linebuf);
+    foreach (StrView, line, linesit) {
+        printf("%.*s|", (int)line.len, line.ptr);
+    }
+    printf(" - %zu bytes in %zu reads\n", linebuf.bytes_read, linebuf.syscalls);
+
+    free_fdbuffer(&linebuf);
+    close(fd);
+
+    /* Records of 4 chars through buffers of 6, the trailing partial record is skipped */
+    int const fd1   = pipe_with("id01id02id03id0");
+    FdBuffer recbuf = new_fdbuffer(fd1, 6);
+
+    Iterable(StrView) recordsit = fd_records_into_iter(&recbuf, 4);
+    foreach (StrView, record, recordsit) {
+        printf("%.*s ", (int)record.len, record.ptr);
+    }
+    puts("");
+
+    free_fdbuffer(&recbuf);
+    close(fd1);
+}
@@ -0,0 +1,82 @@
+#define _POSIX_C_SOURCE 200809L /* For `mkstemp` */
+
+#include "examples.h"
+#include "func_iter.h"
+#include "iterutils/iterable_utils.h"
+#include "mmap_iterable.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Write `content` into a new temporary file, whose path is stored in `path` - exits on failure */
+static void write_temp_file(char* path, char const* content)
+{
+    strcpy(path, "/tmp/iterators_XXXXXX");
+    int const fd = mkstemp(path);
+    if (fd == -1) {
+        perror("mkstemp in write_temp_file");
+        exit(1);
+    }
+    size_t const len = strlen(content);
+    if (write(fd, content, len) != (ssize_t)len) {
+        perror("write in write_temp_file");
+        exit(1);
+    }
+    close(fd);
+}
+
+/* Map the file at `path` - exits on failure */
+static MappedFile map_or_exit(char const* path)
+{
+    MappedFile file;
+    if (!map_file(path, &file)) {
+        perror("map_file in test_mmap_file");
+        exit(1);
+    }
+    return file;
+}
+
+static int strview_len(StrView x) { return (int)x.len; }
+
+void test_mmap_file(void)
+{
+    char path[32];
+
+    /* Map a text file, the last line has no '\n' */
+    write_temp_file(path, "alpha\nbeta\ngamma\n\ndelta");
+    MappedFile file = map_or_exit(path);
+
+    /* Print the first 3 lines - the views point straight into the mapping */
+    Iterable(StrView) linesit = lines_into_iter(file.data, file.size);
+    Iterable(StrView) firstit = take_from(linesit, 3, StrView);
+    foreach (StrView, line, firstit) {
+        printf("%.*s ", (int)line.len, line.ptr);
+    }
+    puts("");
+
+    /* Print the length of every line, from a fresh iterable over the same mapping */
+    Iterable(StrView) linesit1 = lines_into_iter(file.data, file.size);
+    Iterable(int) lensit       = map_over(linesit1, strview_len, StrView, int);
+    foreach (int, len, lensit) {
+        printf("%d ", len);
+    }
+    puts("");
+
+    unmap_file(&file);
+    remove(path);
+
+    /* Map a file of 4 char records, the trailing partial record is skipped */
+    write_temp_file(path, "id01id02id03id0");
+    file = map_or_exit(path);
+
+    Iterable(StrView) recordsit = records_into_iter(file.data, file.size, 4);
+    foreach (StrView, record, recordsit) {
+        printf("%.*s ", (int)record.len, record.ptr);
+    }
+    puts("");
+
+    unmap_file(&file);
+    remove(path);
+}
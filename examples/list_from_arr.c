@@ -16,3 +16,19 @@ void test_list_from_arr(void)
     /* Free the list */
     list = free_intlist(list);
 }
+
+void test_pooled_list_from_arr(void)
+{
+    /* Prepare an iterator from an array */
+    int arr[]           = {42, 3, 17, 25};
+    Iterable(int) arrit = arr_into_iter(arr, sizeof(arr) / sizeof(*arr), int);
+
+    /* Use the iterator to build the list of reversed iterator, out of nodes from the pool */
+    IntNodePool pool = {0};
+    IntList list     = pool_revlist_from_intit(&pool, arrit);
+    /* Print the list to verify values */
+    print_intlist(list);
+
+    /* Free the pool, which frees the list along with it */
+    free_intnodepool(&pool);
+}
@@ -47,16 +47,53 @@ IntList free_intlist(IntNode* head)
     return Nil;
 }
 
-/* `next` implementation for `ListIter(ConstIntList)` */
-static Maybe(int) intlistnxt(ListIter(ConstIntList) * self)
+IntList pool_prepend_intnode(IntNodePool* pool, int val, IntList list)
 {
-    IntNode const* node = self->curr;
-    if (node == Nil) {
-        return Nothing(int);
+    IntNode* node = pool->free;
+    if (node != Nil) {
+        pool->free = node->next;
+    } else {
+        if (pool->block == NULL || pool->used == INTNODE_BLOCK_LEN) {
+            IntNodeBlock* const block = malloc(sizeof(*block));
+            if (block == NULL) {
+                fprintf(stderr, "OOM in pool_prepend_intnode");
+                exit(1);
+            }
+            block->prev = pool->block;
+            pool->block = block;
+            pool->used  = 0;
+        }
+        node = &pool->block->nodes[pool->used++];
     }
-    /* Progress the stored list pointer */
-    self->curr = node->next;
-    return Just(node->val, int);
+    node->val  = val;
+    node->next = list;
+    return node;
+}
+
+IntList pool_free_intlist(IntNodePool* pool, IntNode* head)
+{
+    if (head == Nil) {
+        return Nil;
+    }
+    /* Splice the whole list onto the front of the free list */
+    IntNode* tail = head;
+    while (tail->next != Nil) {
+        tail = tail->next;
+    }
+    tail->next = pool->free;
+    pool->free = head;
+    return Nil;
+}
+
+void free_intnodepool(IntNodePool* pool)
+{
+    IntNodeBlock* block = pool->block;
+    while (block != NULL) {
+        IntNodeBlock* const prev = block->prev;
+        free(block);
+        block = prev;
+    }
+    *pool = (IntNodePool){0};
 }
 
 /* Implement `Iterator` for `ListIter(ConstIntList) *`, which in turn is for a singular linked list of ints */
@@ -2,6 +2,7 @@
 #define IT_LIST_ITRBLE_H
 
 #include "func_iter.h"
+#include "iterutils/arena.h"
 
 #include <stdlib.h>
 
@@ -36,6 +37,9 @@ turn it into an `Iterable`
 */
 #define list_into_iter(head, T) prep_listiter_of(T)(&(ListIter(T)){.curr = head})
 
+/* Same as `list_into_iter`, but the `ListIter` is stored in given `IterArena*` - so it can outlive the scope */
+#define arena_list_into_iter(arena, head, T) prep_listiter_of(T)(arena_new(arena, ListIter(T), .curr = head))
+
 /* Define `ListIter` struct for an int list */
 DefineListIterOf(ConstIntList);
 
@@ -46,6 +50,59 @@ void print_intlist(ConstIntList head);
 /* Free the given IntList */
 IntList free_intlist(IntList head);
 
+/* Number of nodes in each block of an `IntNodePool` - 64 KiB worth on 64 bit targets */
+#ifndef INTNODE_BLOCK_LEN
+#define INTNODE_BLOCK_LEN 4096
+#endif
+
+typedef struct int_node_block
+{
+    struct int_node_block* prev;
+    IntNode nodes[INTNODE_BLOCK_LEN];
+} IntNodeBlock;
+
+/*
+A pool to allocate `IntNode`s from - an empty pool is `{0}`
+
+Nodes are carved out of large blocks one after the other, so a list built from the pool is laid out (mostly)
+contiguously, and building it doesn't go through `malloc` for every node. Nodes of lists released back to the pool are
+reused before any new ones are carved out. Destroying the pool releases every list built from it at once, in O(blocks)
+*/
+typedef struct
+{
+    IntNodeBlock* block;
+    size_t used;
+    IntNode* free;
+} IntNodePool;
+
+/* Create and prepend an IntNode, allocated from given pool, to given IntList and return the new list */
+IntList pool_prepend_intnode(IntNodePool* pool, int val, IntList list);
+/* Release the given IntList, allocated from given pool, back to the pool for reuse */
+IntList pool_free_intlist(IntNodePool* pool, IntList head);
+/* Free the given pool, along with every list allocated from it */
+void free_intnodepool(IntNodePool* pool);
+
+/*
+`next` implementation for `ListIter(ConstIntList)`
+
+Defined here, rather than in the source file, so that `foreach_static` can call it directly
+*/
+static inline Maybe(int) intlistnxt(ListIter(ConstIntList) * self)
+{
+    IntNode const* node = self->curr;
+    if (node == Nil) {
+        return Nothing(int);
+    }
+    /* Progress the stored list pointer */
+    self->curr = node->next;
+    return Just(node->val, int);
+}
+
+// clang-format off
+/* Define the statically dispatched `next` function, `static_next(ListIter(ConstIntList))` */
+impl_static_next(ListIter(ConstIntList), int, intlistnxt)
+// clang-format on
+
 /* Convert a pointer to an `ListIter(ConstIntList)` to an `Iterable(int)` */
 Iterable(int) prep_listiter_of(ConstIntList)(ListIter(ConstIntList) * x);
 
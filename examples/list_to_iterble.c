@@ -15,6 +15,16 @@ IntList revlist_from_intit(Iterable(int) it)
     return list;
 }
 
+IntList pool_revlist_from_intit(IntNodePool* pool, Iterable(int) it)
+{
+    IntList list = Nil;
+    /* Same as `revlist_from_intit`, but the nodes come from the pool */
+    foreach (int, val, it) {
+        list = pool_prepend_intnode(pool, val, list);
+    }
+    return list;
+}
+
 void test_list(void)
 {
     /* Build an int list */
@@ -8,5 +8,23 @@ int main(void)
     test_list_from_arr();
     test_fibonacci();
     test_mapping();
+    test_pipeline();
+    test_arena();
+    test_par_sum();
+    test_chunklist();
+    test_pooled_list_from_arr();
+    test_reduce();
+    test_mmap_file();
+    test_fd_lines();
+    test_readahead();
+    test_par_map();
+    test_range();
+    test_filter();
+    test_tee();
+    test_instrument();
+    test_skip();
+    test_collect();
+    test_merge();
+    test_group();
     return 0;
 }
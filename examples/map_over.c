@@ -2,25 +2,8 @@
 #include "func_iter.h"
 #include "iterutils/iterable_utils.h"
 
-#define VALSTR_SIZE 100 /* An assumption for the size to allocate valstr to (see inttostr) */
-
 static int incr(int x) { return x + 1; }
 
-/* Convert an integer into a string, returned pointer must be freed */
-static string inttostr(int x)
-{
-    /*
-    This is just for demonstration purposes, never assume the size of the buffer
-    where the result of sprintf will be stored - calculate it first by doing a
-    dry snprintf run
-    */
-    char* const xstr = malloc(VALSTR_SIZE * sizeof(*xstr));
-    snprintf(xstr, VALSTR_SIZE, "%d", x);
-
-    /* Return the string representation */
-    return xstr;
-}
-
 void test_mapping(void)
 {
     int arr[] = {1, 2, 3};
@@ -38,13 +21,17 @@ void test_mapping(void)
     /* Make another iterable from the same array */
     Iterable(int) arrit1 = arr_into_iter(arr, sizeof(arr) / sizeof(*arr), int);
 
-    /* Map the inttostr function over the iterable */
-    Iterable(string) mappedit1 = map_over(arrit1, inttostr, int, string);
+    /*
+    Map the arena_fmt_int function over the iterable - each string is allocated from the arena, rather than `malloc`ed,
+    and is yielded as a view into it
+    */
+    IterArena arena             = new_arena(256);
+    Iterable(StrView) mappedit1 = map_into_arena(arrit1, arena_fmt_int, &arena, int);
     /* Print the iterable */
-    foreach (string, x, mappedit1) {
-        printf("%s ", x);
-        /* x is returned from `inttostr` - it needs to be freed */
-        free(x);
+    foreach (StrView, x, mappedit1) {
+        printf("%.*s ", (int)x.len, x.ptr);
     }
     puts("");
-}
\ No newline at end of file
+    /* None of the strings need to be freed on their own - freeing the arena releases all of them */
+    free_arena(&arena);
+}
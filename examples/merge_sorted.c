@@ -0,0 +1,50 @@
+#include "array_iterable.h"
+#include "examples.h"
+#include "func_iter.h"
+#include "iterutils/iterable_utils.h"
+#include "mmap_iterable.h"
+
+#include <stdio.h>
+#include <string.h>
+
+void test_merge(void)
+{
+    /* Per-shard results, each one sorted */
+    int const shard1[] = {1, 4, 7, 10};
+    int const shard2[] = {2, 4, 8};
+    int const shard3[] = {3, 4, 9, 11, 12};
+
+    /* Every element of every shard, in order - ties are yielded in the order of the shards */
+    Iterable(int) shards[] = {arr_into_iter(shard1, sizeof(shard1) / sizeof(*shard1), int),
+                              arr_into_iter(shard2, sizeof(shard2) / sizeof(*shard2), int),
+                              arr_into_iter(shard3, sizeof(shard3) / sizeof(*shard3), int)};
+    Iterable(int) mergeit  = merge_sorted(shards, 3, cmp_int, int);
+    foreach (int, x, mergeit) {
+        printf("%d ", x);
+    }
+    puts("");
+    free_merge(mergeit, int);
+
+    /* Each distinct element once - over new iterables, the ones above have been consumed by the merge */
+    Iterable(int) again[]    = {arr_into_iter(shard1, sizeof(shard1) / sizeof(*shard1), int),
+                                arr_into_iter(shard2, sizeof(shard2) / sizeof(*shard2), int),
+                                arr_into_iter(shard3, sizeof(shard3) / sizeof(*shard3), int)};
+    Iterable(int) distinctit = merge_sorted_dedup(again, 3, cmp_int, int);
+    foreach (int, x, distinctit) {
+        printf("%d ", x);
+    }
+    puts("");
+    free_merge(distinctit, int);
+
+    /* Sorted lines of text merge the same way, compared lexicographically */
+    char const fruits[]        = "apple\ncherry\nplum\n";
+    char const more_fruits[]   = "banana\ncherry\nfig\n";
+    Iterable(StrView) lines[]  = {lines_into_iter(fruits, strlen(fruits)),
+                                  lines_into_iter(more_fruits, strlen(more_fruits))};
+    Iterable(StrView) fruitsit = merge_sorted_dedup(lines, 2, cmp_strview, StrView);
+    foreach (StrView, line, fruitsit) {
+        printf("%.*s ", (int)line.len, line.ptr);
+    }
+    puts("");
+    free_merge(fruitsit, StrView);
+}
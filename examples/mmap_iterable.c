@@ -0,0 +1,118 @@
+#define _DEFAULT_SOURCE /* For `madvise` (and its `MADV_HUGEPAGE` hint) on glibc */
+
+#include "mmap_iterable.h"
+
+#include "func_iter.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+bool map_file(char const* path, MappedFile* out)
+{
+    int const fd = open(path, O_RDONLY);
+    if (fd == -1) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+        int const err = errno;
+        close(fd);
+        errno = err;
+        return false;
+    }
+    size_t const size = (size_t)st.st_size;
+    if (size == 0) {
+        /* Can't map 0 bytes - and there's nothing to map anyway */
+        close(fd);
+        *out = (MappedFile){.data = "", .size = 0};
+        return true;
+    }
+    void* const mem = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    int const err   = errno;
+    /* The mapping keeps its own reference to the file */
+    close(fd);
+    if (mem == MAP_FAILED) {
+        errno = err;
+        return false;
+    }
+    /* Only hints, the mapping works the same if the kernel ignores (or rejects) them */
+    madvise(mem, size, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+    madvise(mem, size, MADV_HUGEPAGE);
+#endif
+    *out = (MappedFile){.data = mem, .size = size};
+    return true;
+}
+
+void unmap_file(MappedFile* file)
+{
+    if (file->size != 0) {
+        munmap((void*)file->data, file->size);
+    }
+    *file = (MappedFile){0};
+}
+
+/* `size_hint` implementation for `LineIter` - every line but the last takes at least one char, its `'\n'` */
+static SizeHint lineiterhint(LineIter* self)
+{
+    size_t const left = (size_t)(self->end - self->curr);
+    return (SizeHint){.lower = left == 0 ? 0 : 1, .upper = Just(left, size_t)};
+}
+
+/*
+`split` implementation for `LineIter` - split at the first line break past the middle of the remaining chars
+
+Can't split if there's no line break there, i.e the back half would be empty
+*/
+static LineIter* lineitersplit(LineIter* self, Allocator alloc)
+{
+    char const* const mid = self->curr + (self->end - self->curr) / 2;
+    char const* const nl  = memchr(mid, '\n', (size_t)(self->end - mid));
+    if (nl == NULL || nl + 1 == self->end) {
+        return NULL;
+    }
+    LineIter* const front = alloc_new(alloc, LineIter, .curr = self->curr, .end = nl + 1);
+    self->curr            = nl + 1;
+    return front;
+}
+
+/* `size_hint` implementation for `RecordIter` - the records are all of the same width */
+static SizeHint recorditerhint(RecordIter* self)
+{
+    return size_hint_exact((size_t)(self->end - self->curr) / self->width);
+}
+
+/* `split` implementation for `RecordIter` - split at the middle record */
+static RecordIter* recorditersplit(RecordIter* self, Allocator alloc)
+{
+    size_t const left = (size_t)(self->end - self->curr) / self->width;
+    if (left < 2) {
+        return NULL;
+    }
+    char const* const mid   = self->curr + left / 2 * self->width;
+    RecordIter* const front = alloc_new(alloc, RecordIter, .curr = self->curr, .end = mid, .width = self->width);
+    self->curr              = mid;
+    return front;
+}
+
+// clang-format off
+impl_size_hint(LineIter*, lineiterhint)
+impl_split(LineIter*, lineitersplit)
+impl_default_next_batch(LineIter*, StrView, lineiternxt)
+impl_default_next_into(LineIter*, StrView, lineiternxt)
+
+/* Implement `Iterator` for `LineIter*` */
+impl_iterator_with(LineIter*, StrView, prep_lineiter_itr, lineiternxt, iter_default_batch(lineiternxt),
+    iter_default_into(lineiternxt), iter_slot(size_hint, lineiterhint), iter_slot(split, lineitersplit))
+
+impl_size_hint(RecordIter*, recorditerhint)
+impl_split(RecordIter*, recorditersplit)
+impl_default_next_batch(RecordIter*, StrView, recorditernxt)
+impl_default_next_into(RecordIter*, StrView, recorditernxt)
+
+/* Implement `Iterator` for `RecordIter*` */
+impl_iterator_with(RecordIter*, StrView, prep_recorditer_itr, recorditernxt, iter_default_batch(recorditernxt),
+    iter_default_into(recorditernxt), iter_slot(size_hint, recorditerhint), iter_slot(split, recorditersplit))
@@ -0,0 +1,120 @@
+#ifndef IT_MMAP_ITRBLE_H
+#define IT_MMAP_ITRBLE_H
+
+#include "func_iter.h"
+#include "iterutils/arena.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+/* A whole file, mapped read only into memory */
+typedef struct
+{
+    char const* data;
+    size_t size;
+} MappedFile;
+
+/*
+Map the whole file at `path` into memory, read only, and store the mapping in `out`
+
+The kernel is told the mapping will be read sequentially (so it reads ahead aggressively), and - where supported - that
+it may back the mapping with huge pages. Both are only hints
+
+Returns `false`, with `errno` set, if the file could not be opened or mapped. An empty file is mapped to an empty,
+non `NULL`, `data`
+*/
+bool map_file(char const* path, MappedFile* out);
+
+/* Unmap given file, the views handed out by iterables over it are invalid from then on */
+void unmap_file(MappedFile* file);
+
+/*
+Iterator over the lines in the chars from `curr` up to `end`
+
+Each line is yielded as a `StrView` into the chars - without its `'\n'` (a `'\r'` before it is kept). The last line
+does not need to end with a `'\n'`
+*/
+typedef struct
+{
+    char const* curr;
+    char const* end;
+} LineIter;
+
+/*
+Iterator over the records of `width` chars in the chars from `curr` up to `end`
+
+`end - curr` is a multiple of `width`, each record is yielded as a `StrView` into the chars
+*/
+typedef struct
+{
+    char const* curr;
+    char const* end;
+    size_t const width;
+} RecordIter;
+
+/*
+Build an `Iterable(StrView)` of the lines in the `size` chars starting at `data` (e.g a `MappedFile`)
+
+No chars are copied, the views point into `data` - which must outlive the iterable. `data` is evaluated twice
+*/
+#define lines_into_iter(data, size) prep_lineiter_itr(&(LineIter){.curr = (data), .end = (data) + (size)})
+
+/* Same as `lines_into_iter`, but the `LineIter` is stored in given `IterArena*` - so it can outlive the scope */
+#define arena_lines_into_iter(arena, data, size)                                                                       \
+    prep_lineiter_itr(arena_new(arena, LineIter, .curr = (data), .end = (data) + (size)))
+
+/*
+Build an `Iterable(StrView)` of the records of `recsize` chars in the `size` chars starting at `data`
+
+A partial record at the end is not yielded. `recsize` must not be 0. `data` and `recsize` are evaluated twice
+*/
+#define records_into_iter(data, size, recsize)                                                                         \
+    prep_recorditer_itr(                                                                                               \
+        &(RecordIter){.curr = (data), .end = (data) + (size) / (recsize) * (recsize), .width = (recsize)})
+
+/* Same as `records_into_iter`, but the `RecordIter` is stored in given `IterArena*` */
+#define arena_records_into_iter(arena, data, size, recsize)                                                            \
+    prep_recorditer_itr(arena_new(arena, RecordIter, .curr = (data), .end = (data) + (size) / (recsize) * (recsize),  \
+                                  .width = (recsize)))
+
+/*
+`next` implementation for `LineIter`
+
+Defined here, rather than in the source file, so that `foreach_static` can call it directly
+*/
+static inline Maybe(StrView) lineiternxt(LineIter* self)
+{
+    char const* const start = self->curr;
+    if (start == self->end) {
+        return Nothing(StrView);
+    }
+    char const* const nl   = memchr(start, '\n', (size_t)(self->end - start));
+    char const* const stop = nl == NULL ? self->end : nl;
+    self->curr             = nl == NULL ? self->end : nl + 1;
+    return Just(((StrView){.ptr = start, .len = (size_t)(stop - start)}), StrView);
+}
+
+/* `next` implementation for `RecordIter` */
+static inline Maybe(StrView) recorditernxt(RecordIter* self)
+{
+    char const* const start = self->curr;
+    if (start == self->end) {
+        return Nothing(StrView);
+    }
+    self->curr += self->width;
+    return Just(((StrView){.ptr = start, .len = self->width}), StrView);
+}
+
+// clang-format off
+/* Define the statically dispatched `next` functions, `static_next(LineIter)` and `static_next(RecordIter)` */
+impl_static_next(LineIter, StrView, lineiternxt)
+impl_static_next(RecordIter, StrView, recorditernxt)
+// clang-format on
+
+/* Convert a pointer to a `LineIter` to an `Iterable(StrView)` */
+Iterable(StrView) prep_lineiter_itr(LineIter* x);
+/* Convert a pointer to a `RecordIter` to an `Iterable(StrView)` */
+Iterable(StrView) prep_recorditer_itr(RecordIter* x);
+
+#endif /* !IT_MMAP_ITRBLE_H */
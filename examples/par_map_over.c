@@ -0,0 +1,69 @@
+#include "examples.h"
+#include "fibonacci_iterable.h"
+#include "func_iter.h"
+#include "iterutils/iterable_utils.h"
+#include "range_iterable.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define PAR_MAP_LEN     50000
+#define PAR_MAP_THREADS 4
+
+#define VALSTR_SIZE 16 /* Enough for any int, sign and null terminator included */
+
+/* Number of steps the Collatz sequence starting at `x` takes to reach 1 - something that takes a while to compute */
+static int collatz_steps(int x)
+{
+    int steps = 0;
+    for (long long n = x + 1; n != 1; steps++) {
+        n = n % 2 == 0 ? n / 2 : 3 * n + 1;
+    }
+    return steps;
+}
+
+/* Convert an integer into a string, returned pointer must be freed */
+static string inttostr(int x)
+{
+    char* const xstr = malloc(VALSTR_SIZE * sizeof(*xstr));
+    snprintf(xstr, VALSTR_SIZE, "%d", x);
+    return xstr;
+}
+
+static uint32_t last_digit(uint32_t x) { return x % 10; }
+
+void test_par_map(void)
+{
+    /* The mapped elements come out in order - so even a non commutative fold matches the sequential one */
+    Iterable(int) seqit = map_over(range_into_iter(0, PAR_MAP_LEN, 1, int), collatz_steps, int, int);
+    Iterable(int) parit = par_map_over(range_into_iter(0, PAR_MAP_LEN, 1, int), collatz_steps, int, int,
+                                       PAR_MAP_THREADS);
+    unsigned seqhash = 0;
+    foreach (int, x, seqit) {
+        seqhash = seqhash * 31 + (unsigned)x;
+    }
+    unsigned parhash = 0;
+    foreach (int, x, parit) {
+        parhash = parhash * 31 + (unsigned)x;
+    }
+    printf("%u == %u\n", seqhash, parhash);
+    free_par_map(parit, int, int);
+
+    /* Strings are built on the workers, and freed here */
+    Iterable(string) strit = par_map_over(range_into_iter(1, 6, 1, int), inttostr, int, string, PAR_MAP_THREADS);
+    foreach (string, s, strit) {
+        printf("%s ", s);
+        free(s);
+    }
+    puts("");
+    free_par_map(strit, int, string);
+
+    /* The fibonacci sequence is infinite - only a few chunks of it are ever pulled ahead */
+    Iterable(uint32_t) fibit   = par_map_over(get_fibitr(), last_digit, uint32_t, uint32_t, PAR_MAP_THREADS);
+    Iterable(uint32_t) firstit = take_from(fibit, 10, uint32_t);
+    foreach (uint32_t, x, firstit) {
+        printf("%u ", x);
+    }
+    puts("");
+    free_par_map(fibit, uint32_t, uint32_t);
+}
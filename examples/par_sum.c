@@ -0,0 +1,45 @@
+#include "array_iterable.h"
+#include "examples.h"
+#include "func_iter.h"
+#include "iterutils/iterable_utils.h"
+#include "range_iterable.h"
+
+#include <stdio.h>
+
+#define PAR_SUM_LEN     100000
+#define PAR_SUM_THREADS 4
+
+static int last_digit(int x) { return x % 10; }
+
+void test_par_sum(void)
+{
+    static int arr[PAR_SUM_LEN];
+    for (size_t i = 0; i < PAR_SUM_LEN; i++) {
+        arr[i] = (int)(i % 100);
+    }
+
+    /* Arrays are split by halving the index range */
+    Iterable(int) seqarrit = arr_into_iter(arr, PAR_SUM_LEN, int);
+    Iterable(int) pararrit = arr_into_iter(arr, PAR_SUM_LEN, int);
+    printf("%d == %d\n", sum_intit(seqarrit), par_sum_intit(pararrit, PAR_SUM_THREADS));
+
+    /* Ranges are split by computing the value at the halfway point */
+    Iterable(int) seqrangeit = range_into_iter(0, PAR_SUM_LEN, 7, int);
+    Iterable(int) parrangeit = range_into_iter(0, PAR_SUM_LEN, 7, int);
+    printf("%d == %d\n", sum_intit(seqrangeit), par_sum_intit(parrangeit, PAR_SUM_THREADS));
+
+    /* Maps are split by splitting the iterable they're mapping over */
+    Iterable(int) seqmapit = map_over(range_into_iter(0, PAR_SUM_LEN, 1, int), last_digit, int, int);
+    Iterable(int) parmapit = map_over(range_into_iter(0, PAR_SUM_LEN, 1, int), last_digit, int, int);
+    printf("%d == %d\n", sum_intit(seqmapit), par_sum_intit(parmapit, PAR_SUM_THREADS));
+
+    /* Lists can't be split, they're summed sequentially */
+    IntList list = Nil;
+    for (int i = 1; i <= 5; i++) {
+        list = prepend_intnode(i, list);
+    }
+    Iterable(int) seqlistit = list_into_iter(list, ConstIntList);
+    Iterable(int) parlistit = list_into_iter(list, ConstIntList);
+    printf("%d == %d\n", sum_intit(seqlistit), par_sum_intit(parlistit, PAR_SUM_THREADS));
+    free_intlist(list);
+}
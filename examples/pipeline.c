@@ -0,0 +1,28 @@
+#include "array_iterable.h"
+#include "examples.h"
+#include "func_iter.h"
+#include "iterutils/iterable_utils.h"
+
+static bool is_odd(int x) { return x % 2 != 0; }
+
+static int square(int x) { return x * x; }
+
+// clang-format off
+/* Take the first 8 elements, drop the even ones and square the rest - all in one `next` function */
+DefinePipeline(OddSquares, int, int, pipe_take(8, int), pipe_filter(is_odd, int), pipe_map(square, int, int))
+// clang-format on
+
+void test_pipeline(void)
+{
+    int arr[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    /* Turn the array into an Iterable */
+    Iterable(int) arrit = arr_into_iter(arr, sizeof(arr) / sizeof(*arr), int);
+
+    /* Run the pipeline over the iterable */
+    Iterable(int) oddsqrs = pipeline_from(arrit, OddSquares);
+    /* Print the iterable */
+    foreach (int, x, oddsqrs) {
+        printf("%d ", x);
+    }
+    puts("");
+}
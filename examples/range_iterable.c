@@ -0,0 +1,85 @@
+#include "range_iterable.h"
+
+#include "func_iter.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/*
+Define the length function and the optional typeclass functions of `Range(T)`, then implement `Iterator` for it -
+`next_f` being its `next` implementation
+
+All the arithmetic is done on `uintmax_t` - where it wraps around instead of overflowing - and only converted back to
+`T` once the result is known to be in the range
+*/
+#define define_range_func(T, next_f)                                                                                   \
+    size_t range_len_of(T)(T from, T to, T by)                                                                         \
+    {                                                                                                                  \
+        if (by > (T)0) {                                                                                               \
+            return from < to ? (size_t)(((uintmax_t)to - (uintmax_t)from - 1) / (uintmax_t)by + 1) : 0;                \
+        }                                                                                                              \
+        if (by == 0) {                                                                                                 \
+            return 0;                                                                                                  \
+        }                                                                                                              \
+        uintmax_t const mag = (uintmax_t)0 - (uintmax_t)by;                                                            \
+        return from > to ? (size_t)(((uintmax_t)from - (uintmax_t)to - 1) / mag + 1) : 0;                              \
+    }                                                                                                                  \
+    /* The value `n` steps after `curr` - `n` must be less than the remaining length */                                \
+    static T CONCAT(Range(T), _nth)(Range(T) const* self, size_t n)                                                    \
+    {                                                                                                                  \
+        return (T)((uintmax_t)self->curr + (uintmax_t)n * (uintmax_t)self->step);                                      \
+    }                                                                                                                  \
+    static size_t CONCAT(Range(T), _batch)(Range(T) * self, T * out, size_t cap)                                       \
+    {                                                                                                                  \
+        size_t const n = cap < self->len ? cap : self->len;                                                            \
+        for (size_t i = 0; i < n; i++) {                                                                               \
+            out[i] = CONCAT(Range(T), _nth)(self, i);                                                                  \
+        }                                                                                                              \
+        self->curr = self->len > n ? CONCAT(Range(T), _nth)(self, n) : self->curr;                                     \
+        self->len -= n;                                                                                                \
+        return n;                                                                                                      \
+    }                                                                                                                  \
+    /* Hand out (up to `max` of) the remaining values as they are - the range already is a progression */              \
+    static bool CONCAT(Range(T), _prog)(Range(T) * self, size_t max, Progression(T) * out)                             \
+    {                                                                                                                  \
+        size_t const n = max < self->len ? max : self->len;                                                            \
+        *out           = (Progression(T)){.first = self->curr, .step = self->step, .len = n};                          \
+        self->curr     = self->len > n ? CONCAT(Range(T), _nth)(self, n) : self->curr;                                 \
+        self->len -= n;                                                                                                \
+        return true;                                                                                                   \
+    }                                                                                                                  \
+    /* Skip values by stepping `curr` straight to the first one left */                                                \
+    static size_t CONCAT(Range(T), _advance)(Range(T) * self, size_t n)                                                \
+    {                                                                                                                  \
+        size_t const skip = n < self->len ? n : self->len;                                                             \
+        self->curr        = self->len > skip ? CONCAT(Range(T), _nth)(self, skip) : self->curr;                        \
+        self->len -= skip;                                                                                             \
+        return skip;                                                                                                   \
+    }                                                                                                                  \
+    static SizeHint CONCAT(Range(T), _hint)(Range(T) * self) { return size_hint_exact(self->len); }                    \
+    static Range(T) * CONCAT(Range(T), _split)(Range(T) * self, Allocator alloc)                                       \
+    {                                                                                                                  \
+        if (self->len < 2) {                                                                                           \
+            return NULL;                                                                                               \
+        }                                                                                                              \
+        size_t const half     = self->len / 2;                                                                         \
+        Range(T)* const front = alloc_new(alloc, Range(T), .curr = self->curr, .step = self->step, .len = half);       \
+        self->curr            = CONCAT(Range(T), _nth)(self, half);                                                    \
+        self->len -= half;                                                                                             \
+        return front;                                                                                                  \
+    }                                                                                                                  \
+    impl_next_batch(Range(T)*, T, CONCAT(Range(T), _batch))                                                            \
+    impl_as_progression(Range(T)*, T, CONCAT(Range(T), _prog))                                                         \
+    impl_size_hint(Range(T)*, CONCAT(Range(T), _hint))                                                                 \
+    impl_advance_by(Range(T)*, CONCAT(Range(T), _advance))                                                             \
+    impl_split(Range(T)*, CONCAT(Range(T), _split))                                                                    \
+    impl_iterator_with(Range(T)*, T, prep_range_of(T), next_f, iter_slot(next_batch, CONCAT(Range(T), _batch)),        \
+                       iter_slot(as_progression, CONCAT(Range(T), _prog)),                                             \
+                       iter_slot(size_hint, CONCAT(Range(T), _hint)),                                                  \
+                       iter_slot(advance_by, CONCAT(Range(T), _advance)), iter_slot(split, CONCAT(Range(T), _split)))
+
+// clang-format off
+/* Implement `Iterator` for Range(int)* */
+define_range_func(int, intrangenxt)
+/* Implement `Iterator` for Range(uint32_t)* */
+define_range_func(uint32_t, u32rangenxt)
@@ -0,0 +1,97 @@
+#ifndef IT_RANGE_ITRBLE_H
+#define IT_RANGE_ITRBLE_H
+
+#include "func_iter.h"
+#include "iterutils/arena.h"
+
+#include <stdlib.h>
+
+#define Range(T) T##Range
+
+/*
+A range of `len` values starting at `curr`, `step` apart
+
+The remaining length is tracked instead of the end value, so the range never steps past the last value it yields -
+which could overflow `T`
+*/
+#define DefineRangeOf(T)                                                                                               \
+    typedef struct                                                                                                     \
+    {                                                                                                                  \
+        T curr;                                                                                                        \
+        T const step;                                                                                                  \
+        size_t len;                                                                                                    \
+    } Range(T)
+
+/* Macro to consistently name the range -> iterable functions based on element type */
+#define prep_range_of(T) prep_##T##range_itr
+
+/* Macro to consistently name the functions computing the length of a range based on element type */
+#define range_len_of(T) T##_range_len
+
+/*
+Build an `Iterable` of the values of type `T` from `from` (inclusive) up to `to` (exclusive), `by` apart
+
+`by` may be negative (for signed `T`), to count down from `from` to `to`, but must not be 0. `from` is evaluated twice
+
+The values are computed, never stored - the iterable reports its exact length as its size hint, and hands itself out
+as a `Progression(T)` (see `iter_as_progression`), so `take_from` slices it in O(1) and the sinks sum and count it in
+closed form
+*/
+#define range_into_iter(from, to, by, T)                                                                               \
+    prep_range_of(T)(&(Range(T)){.curr = from, .step = by, .len = range_len_of(T)(from, to, by)})
+
+/* Same as `range_into_iter`, but the `Range` is stored in given `IterArena*` - so the iterable can outlive the scope */
+#define arena_range_into_iter(arena, from, to, by, T)                                                                  \
+    prep_range_of(T)(arena_new(arena, Range(T), .curr = from, .step = by, .len = range_len_of(T)(from, to, by)))
+
+/* Define `Range` struct for int ranges */
+DefineRangeOf(int);
+/* Define `Range` struct for uint32_t ranges */
+DefineRangeOf(uint32_t);
+
+/*
+`next` implementation for `Range(int)`
+
+Defined here, rather than in the source file, so that `foreach_static` can call it directly
+*/
+static inline Maybe(int) intrangenxt(Range(int) * self)
+{
+    if (self->len == 0) {
+        return Nothing(int);
+    }
+    int const x = self->curr;
+    if (--self->len != 0) {
+        self->curr += self->step;
+    }
+    return Just(x, int);
+}
+
+/* `next` implementation for `Range(uint32_t)` */
+static inline Maybe(uint32_t) u32rangenxt(Range(uint32_t) * self)
+{
+    if (self->len == 0) {
+        return Nothing(uint32_t);
+    }
+    uint32_t const x = self->curr;
+    if (--self->len != 0) {
+        self->curr += self->step;
+    }
+    return Just(x, uint32_t);
+}
+
+// clang-format off
+/* Define the statically dispatched `next` functions, `static_next(Range(int))` and `static_next(Range(uint32_t))` */
+impl_static_next(Range(int), int, intrangenxt)
+impl_static_next(Range(uint32_t), uint32_t, u32rangenxt)
+// clang-format on
+
+/* Number of values in the int range from `from` (inclusive) up to `to` (exclusive), `by` apart */
+size_t range_len_of(int)(int from, int to, int by);
+/* Number of values in the uint32_t range from `from` (inclusive) up to `to` (exclusive), `by` apart */
+size_t range_len_of(uint32_t)(uint32_t from, uint32_t to, uint32_t by);
+/* Convert a pointer to a `Range(int)` to an `Iterable(int)` */
+Iterable(int) prep_range_of(int)(Range(int) * x);
+/* Convert a pointer to a `Range(uint32_t)` to an `Iterable(uint32_t)` */
+Iterable(uint32_t) prep_range_of(uint32_t)(Range(uint32_t) * x);
+
+#endif /* !IT_RANGE_ITRBLE_H */
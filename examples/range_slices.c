@@ -0,0 +1,32 @@
+#include "examples.h"
+#include "func_iter.h"
+#include "iterutils/iterable_utils.h"
+#include "range_iterable.h"
+
+#include <stdio.h>
+
+void test_range(void)
+{
+    /* The sink sums the range in closed form, the loop steps through every value */
+    Iterable(int) sumit = range_into_iter(0, 10000, 3, int);
+    Range(int) loopr    = {.curr = 0, .step = 3, .len = range_len_of(int)(0, 10000, 3)};
+    int loopsum         = 0;
+    foreach_static(Range(int), int, x, &loopr) {
+        loopsum += x;
+    }
+    printf("%d == %d\n", sum_intit(sumit), loopsum);
+
+    /* Taking from a range slices it - the slice knows its length, and is still summed and counted in closed form */
+    Iterable(int) sliceit = take_from(range_into_iter(100, 0, -7, int), 5, int);
+    size_t const slicelen = iter_size_hint(sliceit, int).lower;
+    Iterable(int) countit = take_from(range_into_iter(100, 0, -7, int), 5, int);
+    size_t const below    = count_if_intit(countit, CMP_LT, 90);
+    printf("%zu elements, sum %d, %zu below 90\n", slicelen, sum_intit(sliceit), below);
+
+    /* Unsigned ranges only count up - right up to the top of the type, without wrapping around */
+    Iterable(uint32_t) u32it = range_into_iter(4294967280u, 4294967295u, 4, uint32_t);
+    foreach (uint32_t, x, u32it) {
+        printf("%u ", x);
+    }
+    puts("");
+}
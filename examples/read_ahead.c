@@ -0,0 +1,45 @@
+#include "examples.h"
+#include "func_iter.h"
+#include "iterutils/iterable_utils.h"
+#include "range_iterable.h"
+
+#include <stdio.h>
+
+#define READAHEAD_LEN 100000
+
+/* Number of steps the Collatz sequence starting at `x` takes to reach 1 - something that takes a while to compute */
+static int collatz_steps(int x)
+{
+    int steps = 0;
+    for (long long n = x + 1; n != 1; steps++) {
+        n = n % 2 == 0 ? n / 2 : 3 * n + 1;
+    }
+    return steps;
+}
+
+void test_readahead(void)
+{
+    /* The map runs on the producer thread, while the sum runs on this one */
+    Iterable(int) seqit   = map_over(range_into_iter(0, READAHEAD_LEN, 1, int), collatz_steps, int, int);
+    Iterable(int) srcit   = map_over(range_into_iter(0, READAHEAD_LEN, 1, int), collatz_steps, int, int);
+    Iterable(int) aheadit = readahead(srcit, 1024, int);
+    printf("%d == %d\n", sum_intit(seqit), sum_intit(aheadit));
+    free_readahead(aheadit, int);
+
+    /* A ring smaller than a batch - the producer keeps wrapping around, and waiting on the consumer */
+    Iterable(int) smallit = readahead(range_into_iter(0, 10, 1, int), 4, int);
+    foreach (int, x, smallit) {
+        printf("%d ", x);
+    }
+    puts("");
+    free_readahead(smallit, int);
+
+    /* Stop early - freeing the adapter stops the producer, which may be waiting on a full ring */
+    Iterable(int) stopit  = readahead(range_into_iter(0, READAHEAD_LEN, 1, int), 16, int);
+    Iterable(int) firstit = take_from(stopit, 5, int);
+    foreach (int, x, firstit) {
+        printf("%d ", x);
+    }
+    puts("");
+    free_readahead(stopit, int);
+}
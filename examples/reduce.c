@@ -0,0 +1,30 @@
+#include "array_iterable.h"
+#include "examples.h"
+#include "func_iter.h"
+#include "iterutils/iterable_utils.h"
+#include "list_iterable.h"
+
+#include <stdio.h>
+
+void test_reduce(void)
+{
+    int arr[]        = {5, -3, 9, 0, 7, 2};
+    size_t const len = sizeof(arr) / sizeof(*arr);
+
+    /* Array backed iterables hand their whole span to the vectorized kernels */
+    int const sum        = sum_intit(arr_into_iter(arr, len, int));
+    Maybe(int) const min = min_intit(arr_into_iter(arr, len, int));
+    Maybe(int) const max = max_intit(arr_into_iter(arr, len, int));
+    size_t const above   = count_if_intit(arr_into_iter(arr, len, int), CMP_GT, 4);
+    printf("sum %d, min %d, max %d, %zu above 4\n", sum, from_just(min, int), from_just(max, int), above);
+
+    /* Lists are staged into a buffer first - here, the list is paired with an array in a dot product */
+    IntList list = revlist_from_intit(arr_into_iter(arr, len, int));
+    int rev[sizeof(arr) / sizeof(*arr)];
+    for (size_t i = 0; i < len; i++) {
+        rev[i] = arr[len - 1 - i];
+    }
+    Iterable(int) listit = list_into_iter(list, ConstIntList);
+    printf("dot %d\n", dot_intit(listit, arr_into_iter(rev, len, int)));
+    list = free_intlist(list);
+}
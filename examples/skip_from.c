@@ -0,0 +1,45 @@
+#include "array_iterable.h"
+#include "examples.h"
+#include "fibonacci_iterable.h"
+#include "func_iter.h"
+#include "iterutils/iterable_utils.h"
+#include "range_iterable.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+
+/* Number of times `costly_double` has been called */
+static int ncalls = 0;
+
+/* Double a number - standing in for something expensive to compute, like parsing */
+static int costly_double(int x)
+{
+    ncalls++;
+    return 2 * x;
+}
+
+static bool is_odd(int x) { return x % 2 != 0; }
+
+void test_skip(void)
+{
+    /* The second page of 4 elements - the array iterator skips the first page by moving its index */
+    int const arr[]    = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    Iterable(int) page = take_from(skip_from(arr_into_iter(arr, sizeof(arr) / sizeof(*arr), int), 4, int), 4, int);
+    foreach (int, x, page) {
+        printf("%d ", x);
+    }
+    puts("");
+
+    /* The fibonacci sequence jumps a billion elements ahead in a few dozen steps, wrapping around like `next` does */
+    Iterable(uint32_t) fibit = take_from(skip_from(get_fibitr(), 1000000000, uint32_t), 3, uint32_t);
+    foreach (uint32_t, x, fibit) {
+        printf("%" PRIu32 " ", x);
+    }
+    puts("");
+
+    /* A map skips its function along with the elements, a filter has to look at every element it skips */
+    Iterable(int) mapit  = skip_from(map_over(range_into_iter(0, 100, 1, int), costly_double, int, int), 95, int);
+    Iterable(int) oddsit = skip_from(filter_over(range_into_iter(0, 100, 1, int), is_odd, int), 45, int);
+    int const mapsum     = sum_intit(mapit);
+    printf("%d, %d calls - %d\n", mapsum, ncalls, sum_intit(oddsit));
+}
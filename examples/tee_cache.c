@@ -0,0 +1,46 @@
+#include "examples.h"
+#include "func_iter.h"
+#include "iterutils/iterable_utils.h"
+#include "range_iterable.h"
+
+#include <stdio.h>
+
+/* Number of times `costly_square` has been called */
+static int ncalls = 0;
+
+/* Square a number - standing in for something expensive to compute, like parsing */
+static int costly_square(int x)
+{
+    ncalls++;
+    return x * x;
+}
+
+void test_tee(void)
+{
+    /* Both cursors yield every square, but each square is only computed once */
+    Iterable(int) cursors[2];
+    tee(map_over(range_into_iter(1, 11, 1, int), costly_square, int, int), 2, cursors, int);
+    foreach (int, x, cursors[0]) {
+        printf("%d ", x);
+    }
+    printf("- sum %d, %d calls\n", sum_intit(cursors[1]), ncalls);
+    free_tee(cursors[0], int);
+
+    /* Cursors one element apart, in lockstep - an element is dropped as soon as the one behind has yielded it */
+    Iterable(int) pair[2];
+    tee(map_over(range_into_iter(1, 8, 1, int), costly_square, int, int), 2, pair, int);
+    (void)pair[1].tc->next(pair[1].self);
+    foreach (int, x, pair[1]) {
+        printf("%d ", x - from_just(pair[0].tc->next(pair[0].self), int));
+    }
+    puts("");
+    free_tee(pair[0], int);
+
+    /* A cache can be replayed once it's been consumed - the source isn't evaluated again */
+    ncalls               = 0;
+    Iterable(int) it     = cache(map_over(range_into_iter(1, 6, 1, int), costly_square, int, int), int);
+    int const sum        = sum_intit(it);
+    Maybe(int) const max = max_intit(cache_replay(it, int));
+    printf("sum %d, max %d, %d calls\n", sum, from_just(max, int), ncalls);
+    free_cache(it, int);
+}
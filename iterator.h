@@ -9,9 +9,113 @@
 #include "maybe.h"
 #include "typeclass.h"
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
 #define CONCAT_(A, B) A##B
 #define CONCAT(A, B)  CONCAT_(A, B)
 
+/**
+ * @def ITER_BATCH_SIZE
+ * @brief Number of elements consumers (and adapters that need a staging buffer) pull per `next_batch` call.
+ */
+#ifndef ITER_BATCH_SIZE
+#define ITER_BATCH_SIZE 256
+#endif
+
+/* `Maybe(size_t)` is used for the upper bound of a #SizeHint */
+DefineMaybe(size_t)
+
+/**
+ * @def ITER_INSTRUMENT
+ * @brief Define this (e.g `-DITER_INSTRUMENT`) to record every `next` call made through an #Iterable(T)'s typeclass.
+ *
+ * The `next` function #impl_iterator_with(IterType, ElmntType, Name, next_f, ...) puts into the typeclass then times
+ * each call, and records it in the #IterStats labelled after `IterType` - through #iter_stats_register(label),
+ * #iter_stats_enter() and #iter_stats_leave(stats, frame, elements), which the program must link a definition of
+ * (`examples/iterutils/instrument.c` has one). Needs a GCC compatible compiler.
+ *
+ * When it isn't defined, the typeclass calls the `next` implementation directly - nothing is recorded, and none of
+ * these functions (nor #IterStats and #IterStatsFrame) are declared.
+ */
+#ifdef ITER_INSTRUMENT
+/**
+ * @struct IterStats
+ * @brief Statistics recorded for a stage of an iterator chain - defined in `examples/iterutils/instrument.h`.
+ */
+typedef struct IterStats IterStats;
+
+/**
+ * @struct IterStatsFrame
+ * @brief A call being timed - when it started, and the time spent in instrumented calls nested in the call it's
+ * nested in, so far.
+ */
+typedef struct
+{
+    uint64_t start;
+    uint64_t outer;
+} IterStatsFrame;
+
+/**
+ * @brief The #IterStats labelled `label`, registered on first use. Returns the same statistics for the same label.
+ */
+IterStats* iter_stats_register(char const* label);
+
+/**
+ * @brief Start timing a call.
+ */
+IterStatsFrame iter_stats_enter(void);
+
+/**
+ * @brief Record the call started by `frame` in `stats` - which yielded `elements` elements (`0` being a `Nothing`).
+ */
+void iter_stats_leave(IterStats* stats, IterStatsFrame frame, size_t elements);
+
+#define iter_call_next_(IterType, ElmntType, next_f)                                                                   \
+    static IterStats* stats_ = NULL;                                                                                   \
+    IterStats* stats         = __atomic_load_n(&stats_, __ATOMIC_ACQUIRE);                                             \
+    if (stats == NULL) {                                                                                               \
+        stats = iter_stats_register(#IterType);                                                                        \
+        __atomic_store_n(&stats_, stats, __ATOMIC_RELEASE);                                                            \
+    }                                                                                                                  \
+    IterStatsFrame const frame = iter_stats_enter();                                                                   \
+    Maybe(ElmntType) const res = (next_f)(self);                                                                       \
+    iter_stats_leave(stats, frame, is_just_of(res, ElmntType));                                                        \
+    return res
+#else
+#define iter_call_next_(IterType, ElmntType, next_f) return (next_f)(self)
+#endif
+
+/**
+ * @struct SizeHint
+ * @brief Bounds on the number of elements left in an iterable, as reported by its `size_hint` function.
+ *
+ * An iterable that knows exactly how many elements it has left reports the same value in `lower` and `upper`.
+ * An infinite iterable reports `SIZE_MAX` as `lower` and `Nothing` as `upper`.
+ */
+typedef struct
+{
+    size_t lower;        /**< Minimum number of elements left. */
+    Maybe(size_t) upper; /**< Maximum number of elements left, `Nothing` if unbounded (or unknown). */
+} SizeHint;
+
+/**
+ * @def size_hint_exact(n)
+ * @brief #SizeHint for an iterable with exactly `n` elements left.
+ */
+#define size_hint_exact(n) ((SizeHint){.lower = (n), .upper = Just((n), size_t)})
+/**
+ * @def size_hint_unknown()
+ * @brief #SizeHint for an iterable that knows nothing about how many elements it has left.
+ */
+#define size_hint_unknown() ((SizeHint){.lower = 0, .upper = Nothing(size_t)})
+/**
+ * @def size_hint_infinite()
+ * @brief #SizeHint for an iterable that never ends.
+ */
+#define size_hint_infinite() ((SizeHint){.lower = SIZE_MAX, .upper = Nothing(size_t)})
+
 /**
  * @def Iterator(T)
  * @brief Convenience macro to get the type of the Iterator (typeclass) with given element type.
@@ -30,6 +134,63 @@
  */
 #define Iterator(T) T##Iterator
 
+/**
+ * @brief The `Alloc` typeclass - the ability to hand out memory.
+ *
+ * `split` implementations use an #Allocator to store the state of the iterable they split off.
+ */
+typedef typeclass(void* (*const alloc)(void* self, size_t size)) Alloc;
+/**
+ * @brief The typeclass instance of `Alloc`.
+ */
+typedef typeclass_instance(Alloc) Allocator;
+
+/**
+ * @def impl_alloc(T, Name, alloc_f)
+ * @brief Define a function to turn given `T` into an #Allocator.
+ *
+ * @param T The semantic type (C type) this impl is for, must be a pointer type.
+ * @param Name Name to define the function as.
+ * @param alloc_f Function that serves as the `alloc` implementation for `T`. This function must have the signature
+ * of `void* (*)(T self, size_t size)` and return memory suitably aligned for any type. It must not return `NULL`.
+ *
+ * @note This should not be delimited by a semicolon.
+ */
+#define impl_alloc(T, Name, alloc_f)                                                                                   \
+    static inline void* CONCAT(alloc_f, __)(void* self, size_t size)                                                   \
+    {                                                                                                                  \
+        void* (*const alloc_)(T self, size_t size) = (alloc_f);                                                        \
+        (void)alloc_;                                                                                                  \
+        return (alloc_f)(self, size);                                                                                  \
+    }                                                                                                                  \
+    Allocator Name(T x)                                                                                                \
+    {                                                                                                                  \
+        static Alloc const tc = {.alloc = (CONCAT(alloc_f, __))};                                                      \
+        return (Allocator){.tc = &tc, .self = x};                                                                      \
+    }
+
+/**
+ * @def Span(T)
+ * @brief Convenience macro to get the type of a contiguous, read only, run of elements of given type.
+ *
+ * This is what the `as_span` function of the `Iterator` typeclass hands out. It is defined by #DefineIteratorOf(T).
+ *
+ * @param T The type of the elements. Must be the same type name passed to #DefineIteratorOf(T).
+ */
+#define Span(T) T##Span
+
+/**
+ * @def Progression(T)
+ * @brief Convenience macro to get the type of an arithmetic progression of elements of given type - `len` values
+ * starting at `first`, `step` apart.
+ *
+ * This is what the `as_progression` function of the `Iterator` typeclass hands out. It is defined by
+ * #DefineIteratorOf(T). Only meaningful for arithmetic types.
+ *
+ * @param T The type of the elements. Must be the same type name passed to #DefineIteratorOf(T).
+ */
+#define Progression(T) T##Progression
+
 /**
  * @def Iterable(T)
  * @brief Convenience macro to get the type of the Iterable (typeclass instance) with given element type.
@@ -51,6 +212,37 @@
  * @def DefineIteratorOf(T)
  * @brief Define an Iterator typeclass and its Iterable instance for given element type.
  *
+ * The typeclass has the following functions-
+ * - `next` - Yield the next element wrapped in a `Just`, or `Nothing` once the iteration has ended.
+ * - `next_into` (optional) - Write the next element into `out` and return `true`, or return `false` (leaving `out`
+ *   untouched) once the iteration has ended. Same as `next`, but the element doesn't have to be wrapped in a #Maybe(T)
+ *   and returned by value - which matters when `T` is large. Can be `NULL`, use #iter_next_into(it, out, T) instead
+ *   of calling it directly.
+ * - `next_batch` (optional) - Write up to `cap` elements into `out` and return how many were written. `0` is only
+ *   returned once the iteration has ended (or if `cap` is `0`). Can be `NULL`, use #iter_next_batch(it, out, cap, T)
+ *   instead of calling it directly.
+ * - `size_hint` (optional) - Report the bounds on the number of elements left as a #SizeHint. Can be `NULL`, use
+ *   #iter_size_hint(it, T) instead of calling it directly.
+ * - `as_span` (optional) - If the remaining elements are stored contiguously, consume up to `max` of them and hand
+ *   them out as a #Span(T) through `out`, returning `true`. Otherwise return `false` without consuming anything. Can
+ *   be `NULL`, use #iter_as_span(it, max, out, T) instead of calling it directly.
+ * - `as_progression` (optional) - If the remaining elements are an arithmetic progression, consume up to `max` of them
+ *   and hand them out as a #Progression(T) through `out`, returning `true`. Otherwise return `false` without
+ *   consuming anything. Can be `NULL`, use #iter_as_progression(it, max, out, T) instead of calling it directly.
+ * - `advance_by` (optional) - Skip up to `n` elements without yielding them, and return how many were skipped - less
+ *   than `n` only once the iteration has ended. Can be `NULL`, use #iter_advance_by(it, n, T) instead of calling it
+ *   directly.
+ * - `split` (optional) - Split the remaining elements in two. The front half is moved into a new iterator of the
+ *   same type, whose state is allocated from `alloc` and returned. The iterator itself keeps the back half. Returns
+ *   `NULL`, leaving the iterator untouched, if it can't be split (e.g there's less than 2 elements left). Can be
+ *   `NULL`, use #iter_split(it, alloc, out, T) instead of calling it directly.
+ *
+ * Also defines the #Span(T) and #Progression(T) structs, and the `static inline` functions, `T##_iter_next_into`,
+ * `T##_iter_next_batch`, `T##_iter_size_hint`, `T##_iter_as_span`, `T##_iter_as_progression`, `T##_iter_advance_by`
+ * and `T##_iter_split`, which are what #iter_next_into(it, out, T), #iter_next_batch(it, out, cap, T),
+ * #iter_size_hint(it, T), #iter_as_span(it, max, out, T), #iter_as_progression(it, max, out, T),
+ * #iter_advance_by(it, n, T) and #iter_split(it, alloc, out, T) call.
+ *
  * # Example
  *
  * @code
@@ -63,8 +255,252 @@
  * @note A #Maybe(T) for the given `T` **must** also exist.
  */
 #define DefineIteratorOf(T)                                                                                            \
-    typedef typeclass(Maybe(T) (*const next)(void* self)) Iterator(T);                                                 \
-    typedef typeclass_instance(Iterator(T)) Iterable(T)
+    typedef struct                                                                                                     \
+    {                                                                                                                  \
+        T const* ptr;                                                                                                  \
+        size_t len;                                                                                                    \
+    } Span(T);                                                                                                         \
+    typedef struct                                                                                                     \
+    {                                                                                                                  \
+        T first;                                                                                                       \
+        T step;                                                                                                        \
+        size_t len;                                                                                                    \
+    } Progression(T);                                                                                                  \
+    typedef typeclass(Maybe(T) (*const next)(void* self);                                                              \
+                      bool (*const next_into)(void* self, T* out);                                                     \
+                      size_t (*const next_batch)(void* self, T* out, size_t cap);                                      \
+                      SizeHint (*const size_hint)(void* self);                                                         \
+                      bool (*const as_span)(void* self, size_t max, Span(T)* out);                                     \
+                      bool (*const as_progression)(void* self, size_t max, Progression(T)* out);                       \
+                      size_t (*const advance_by)(void* self, size_t n);                                                \
+                      void* (*const split)(void* self, Allocator alloc)) Iterator(T);                                  \
+    typedef typeclass_instance(Iterator(T)) Iterable(T);                                                               \
+    static inline bool T##_iter_split(Iterable(T) it, Allocator alloc, Iterable(T) * out)                              \
+    {                                                                                                                  \
+        void* const front = it.tc->split == NULL ? NULL : it.tc->split(it.self, alloc);                                \
+        if (front == NULL) {                                                                                           \
+            return false;                                                                                              \
+        }                                                                                                              \
+        *out = (Iterable(T)){.self = front, .tc = it.tc};                                                              \
+        return true;                                                                                                   \
+    }                                                                                                                  \
+    static inline bool T##_iter_as_span(Iterable(T) it, size_t max, Span(T)* out)                                      \
+    {                                                                                                                  \
+        return it.tc->as_span != NULL && it.tc->as_span(it.self, max, out);                                            \
+    }                                                                                                                  \
+    static inline bool T##_iter_as_progression(Iterable(T) it, size_t max, Progression(T)* out)                        \
+    {                                                                                                                  \
+        return it.tc->as_progression != NULL && it.tc->as_progression(it.self, max, out);                              \
+    }                                                                                                                  \
+    static inline size_t T##_iter_advance_by(Iterable(T) it, size_t n)                                                 \
+    {                                                                                                                  \
+        if (it.tc->advance_by != NULL) {                                                                               \
+            return it.tc->advance_by(it.self, n);                                                                      \
+        }                                                                                                              \
+        size_t i = 0;                                                                                                  \
+        for (; i < n; i++) {                                                                                           \
+            Maybe(T) const res = it.tc->next(it.self);                                                                 \
+            if (is_nothing_of(res, T)) {                                                                               \
+                break;                                                                                                 \
+            }                                                                                                          \
+        }                                                                                                              \
+        return i;                                                                                                      \
+    }                                                                                                                  \
+    static inline SizeHint T##_iter_size_hint(Iterable(T) it)                                                          \
+    {                                                                                                                  \
+        return it.tc->size_hint != NULL ? it.tc->size_hint(it.self) : size_hint_unknown();                             \
+    }                                                                                                                  \
+    static inline bool T##_iter_next_into(Iterable(T) it, T* out)                                                      \
+    {                                                                                                                  \
+        if (it.tc->next_into != NULL) {                                                                                \
+            return it.tc->next_into(it.self, out);                                                                     \
+        }                                                                                                              \
+        Maybe(T) const res = it.tc->next(it.self);                                                                     \
+        if (is_nothing_of(res, T)) {                                                                                   \
+            return false;                                                                                              \
+        }                                                                                                              \
+        *out = from_just_(res);                                                                                        \
+        return true;                                                                                                   \
+    }                                                                                                                  \
+    static inline size_t T##_iter_next_batch(Iterable(T) it, T* out, size_t cap)                                       \
+    {                                                                                                                  \
+        if (it.tc->next_batch != NULL) {                                                                               \
+            return it.tc->next_batch(it.self, out, cap);                                                               \
+        }                                                                                                              \
+        size_t n = 0;                                                                                                  \
+        for (; n < cap; n++) {                                                                                         \
+            Maybe(T) const res = it.tc->next(it.self);                                                                 \
+            if (is_nothing_of(res, T)) {                                                                               \
+                break;                                                                                                 \
+            }                                                                                                          \
+            out[n] = from_just_(res);                                                                                  \
+        }                                                                                                              \
+        return n;                                                                                                      \
+    }                                                                                                                  \
+    /* Re-declared so the macro invocation can be delimited by a semicolon */                                          \
+    static inline size_t T##_iter_next_batch(Iterable(T) it, T* out, size_t cap)
+
+/**
+ * @def iter_next_into(it, out, T)
+ * @brief Pull the next element out of an #Iterable(T) into `out`.
+ *
+ * Uses the `next_into` implementation of the iterable if it has one, falls back to unwrapping the result of `next`
+ * otherwise.
+ *
+ * # Example
+ *
+ * @code
+ * Big x;
+ * while (iter_next_into(it, &x, Big)) {
+ *     ...
+ * }
+ * @endcode
+ *
+ * @param it The #Iterable(T) to consume from.
+ * @param out Pointer to the `T` to store the element in. Only written to if there was an element left.
+ * @param T The type of value the `Iterable` yields. Must be alphanumeric.
+ *
+ * @return `true` if an element was written to `out`, `false` if the iterable has been fully consumed.
+ */
+#define iter_next_into(it, out, T) T##_iter_next_into(it, out)
+
+/**
+ * @def iter_next_batch(it, out, cap, T)
+ * @brief Pull up to `cap` elements out of an #Iterable(T) into `out`.
+ *
+ * Uses the `next_batch` implementation of the iterable if it has one, falls back to calling `next` repeatedly
+ * otherwise.
+ *
+ * @param it The #Iterable(T) to consume from.
+ * @param out Pointer to a buffer of at least `cap` elements of type `T`.
+ * @param cap Maximum number of elements to write into `out`.
+ * @param T The type of value the `Iterable` yields. Must be alphanumeric.
+ *
+ * @return Number of elements written to `out`. `0` means the iterable has been fully consumed (unless `cap` was `0`).
+ * A short count does **not** imply the end of the iteration.
+ */
+#define iter_next_batch(it, out, cap, T) T##_iter_next_batch(it, out, cap)
+
+/**
+ * @def iter_size_hint(it, T)
+ * @brief Get the bounds on the number of elements left in an #Iterable(T).
+ *
+ * Consumers that materialize an iterable can use this to allocate once, up front.
+ *
+ * @param it The #Iterable(T) to query. It is not consumed.
+ * @param T The type of value the `Iterable` yields. Must be alphanumeric.
+ *
+ * @return The #SizeHint reported by the iterable, or #size_hint_unknown() if it doesn't implement `size_hint`.
+ */
+#define iter_size_hint(it, T) T##_iter_size_hint(it)
+
+/**
+ * @def iter_as_span(it, max, out, T)
+ * @brief Try to consume up to `max` elements out of an #Iterable(T) in one step, as a contiguous #Span(T).
+ *
+ * Generic algorithms can use this to run a tight loop (that the compiler is free to vectorize) over the span, and
+ * fall back to `next` (or #iter_next_batch(it, out, cap, T)) when it fails.
+ *
+ * # Example
+ *
+ * @code
+ * Span(int) span;
+ * if (iter_as_span(it, SIZE_MAX, &span, int)) {
+ *     for (size_t i = 0; i < span.len; i++) {
+ *         sum += span.ptr[i];
+ *     }
+ * }
+ * @endcode
+ *
+ * @param it The #Iterable(T) to consume from.
+ * @param max Maximum number of elements to consume. Pass `SIZE_MAX` to consume everything that's left.
+ * @param out Pointer to the #Span(T) to store the consumed elements in. Only written to on success.
+ * @param T The type of value the `Iterable` yields. Must be alphanumeric.
+ *
+ * @return `true` if the elements were consumed into `out`, `false` if the iterable isn't backed by contiguous
+ * storage - in which case nothing is consumed.
+ *
+ * @note The span points into the storage backing the iterable, it is only valid as long as that storage is.
+ */
+#define iter_as_span(it, max, out, T) T##_iter_as_span(it, max, out)
+
+/**
+ * @def iter_as_progression(it, max, out, T)
+ * @brief Try to consume up to `max` elements out of an #Iterable(T) in one step, as an arithmetic #Progression(T).
+ *
+ * Generic algorithms can use this to compute their result in closed form (e.g the sum of a progression is
+ * `len * first + step * len * (len - 1) / 2`) - without the elements ever being materialized - and fall back to `next`
+ * (or #iter_next_batch(it, out, cap, T)) when it fails.
+ *
+ * # Example
+ *
+ * @code
+ * Progression(int) prog;
+ * if (iter_as_progression(it, SIZE_MAX, &prog, int) && prog.len != 0) {
+ *     last = prog.first + (int)(prog.len - 1) * prog.step;
+ * }
+ * @endcode
+ *
+ * @param it The #Iterable(T) to consume from.
+ * @param max Maximum number of elements to consume. Pass `SIZE_MAX` to consume everything that's left.
+ * @param out Pointer to the #Progression(T) to store the consumed elements in. Only written to on success.
+ * @param T The type of value the `Iterable` yields. Must be alphanumeric.
+ *
+ * @return `true` if the elements were consumed into `out`, `false` if the iterable isn't an arithmetic progression -
+ * in which case nothing is consumed.
+ */
+#define iter_as_progression(it, max, out, T) T##_iter_as_progression(it, max, out)
+
+/**
+ * @def iter_advance_by(it, n, T)
+ * @brief Skip up to `n` elements of an #Iterable(T), without yielding them.
+ *
+ * Uses the `advance_by` implementation of the iterable if it has one - which can skip in O(1) (e.g an array just
+ * moves its index), or in O(log n) (e.g the fibonacci sequence jumps ahead by matrix doubling). Falls back to calling
+ * `next` `n` times otherwise.
+ *
+ * # Example
+ *
+ * @code
+ * if (iter_advance_by(it, page * page_size, int) == page * page_size) {
+ *     // `it` is at the first element of the page
+ * }
+ * @endcode
+ *
+ * @param it The #Iterable(T) to skip the elements of.
+ * @param n Number of elements to skip.
+ * @param T The type of value the `Iterable` yields. Must be alphanumeric.
+ *
+ * @return The number of elements skipped - less than `n` only if the iterable ran out of elements.
+ */
+#define iter_advance_by(it, n, T) T##_iter_advance_by(it, n)
+
+/**
+ * @def iter_split(it, alloc, out, T)
+ * @brief Try to split the remaining elements of an #Iterable(T) in two, so they can be consumed independently.
+ *
+ * On success, the front half of the remaining elements is moved into `out` - whose state lives in memory handed out
+ * by `alloc` - and `it` is left with the back half. Consuming `out` and then `it` yields the same elements, in the
+ * same order, as consuming `it` would have.
+ *
+ * # Example
+ *
+ * @code
+ * Iterable(int) front;
+ * if (iter_split(it, alloc, &front, int)) {
+ *     // `front` and `it` can now be consumed independently, e.g on different threads
+ * }
+ * @endcode
+ *
+ * @param it The #Iterable(T) to split.
+ * @param alloc The #Allocator to store the state of the front half in.
+ * @param out Pointer to the #Iterable(T) to store the front half in. Only written to on success.
+ * @param T The type of value the `Iterable` yields. Must be alphanumeric.
+ *
+ * @return `true` if the iterable was split, `false` if it doesn't support splitting or has less than 2 elements
+ * left - in which case `it` is left untouched.
+ */
+#define iter_split(it, alloc, out, T) T##_iter_split(it, alloc, out)
 
 /**
  * @def impl_iterator(IterType, ElmntType, Name, next_f)
@@ -72,6 +508,12 @@
  *
  * Implement the Iterator typeclass for a type. Essentially defining a wrapper function that returns the Iterable.
  *
+ * The `next_batch` function of the typeclass is filled with a default that calls `next_f` in a loop. Since `next_f` is
+ * called directly, rather than through the typeclass, it can be inlined into that loop. Use
+ * #impl_iterator_with(IterType, ElmntType, Name, next_f, ...) to provide a dedicated `next_batch` instead. Likewise,
+ * `next_into` is filled with a default that unwraps the result of `next_f` - see
+ * #impl_iterator_into(IterType, ElmntType, Name, into_f) to implement an iterator in terms of `next_into` instead.
+ *
  * The defined function takes in a value of `IterType` and wraps it in an `Iterable` - which can be passed around to
  * generic functions working on an iterable.
  *
@@ -121,16 +563,362 @@
  * @note This should not be delimited by a semicolon.
  */
 #define impl_iterator(IterType, ElmntType, Name, next_f)                                                               \
+    impl_default_next_batch(IterType, ElmntType, next_f)                                                               \
+    impl_default_next_into(IterType, ElmntType, next_f)                                                                \
+    impl_iterator_with(IterType, ElmntType, Name, next_f, iter_default_batch(next_f), iter_default_into(next_f))
+
+/**
+ * @def impl_iterator_into(IterType, ElmntType, Name, into_f)
+ * @brief Same as #impl_iterator(IterType, ElmntType, Name, next_f), but the iterator is implemented in terms of
+ * `next_into` - writing each element through a pointer rather than returning it wrapped in a #Maybe(T).
+ *
+ * This suits large element types, which would otherwise be copied into a #Maybe(T) returned through memory. The
+ * `next` function of the typeclass is generated from `into_f`, as a `static inline` function named
+ * `CONCAT(into_f, _next)` - which can be passed anywhere a `next_f` is expected. The `next_batch` function is filled
+ * with a default that calls `into_f` in a loop, writing straight into the output buffer.
+ *
+ * # Example
+ *
+ * @code
+ * static bool bigarrinto(BigArr* self, Big* out)
+ * {
+ *     if (self->i == self->size) {
+ *         return false;
+ *     }
+ *     *out = self->arr[self->i++];
+ *     return true;
+ * }
+ *
+ * impl_iterator_into(BigArr*, Big, prep_bigarr_itr, bigarrinto)
+ * @endcode
+ *
+ * @param IterType The semantic type (C type) this impl is for, must be a pointer type.
+ * @param ElmntType The type of value the `Iterator` instance will yield.
+ * @param Name Name to define the function as.
+ * @param into_f Function that serves as the `next_into` implementation for `IterType`. This function must have the
+ * signature of `bool (*)(IterType self, ElmntType* out)` - returning `false`, without writing to `out`, once the
+ * iteration has ended.
+ *
+ * @note A #Maybe(T) for the given `ElmntType` **must** exist.
+ * @note This should not be delimited by a semicolon.
+ */
+#define impl_iterator_into(IterType, ElmntType, Name, into_f)                                                          \
+    static inline Maybe(ElmntType) CONCAT(into_f, _next)(IterType self)                                                \
+    {                                                                                                                  \
+        ElmntType x;                                                                                                   \
+        return (into_f)(self, &x) ? Just(x, ElmntType) : Nothing(ElmntType);                                           \
+    }                                                                                                                  \
+    static inline size_t CONCAT(into_f, _batch__)(void* self, ElmntType* out, size_t cap)                              \
+    {                                                                                                                  \
+        IterType const x = self;                                                                                       \
+        size_t n         = 0;                                                                                          \
+        while (n < cap && (into_f)(x, out + n)) {                                                                      \
+            n++;                                                                                                       \
+        }                                                                                                              \
+        return n;                                                                                                      \
+    }                                                                                                                  \
+    impl_next_into(IterType, ElmntType, into_f)                                                                        \
+    impl_iterator_with(IterType, ElmntType, Name, CONCAT(into_f, _next), iter_slot(next_into, into_f),                 \
+                       .next_batch = CONCAT(into_f, _batch__))
+
+/**
+ * @def impl_default_next_batch(IterType, ElmntType, next_f)
+ * @brief Define the default `next_batch` implementation for `IterType`, which calls `next_f` in a loop.
+ *
+ * This is what #impl_iterator(IterType, ElmntType, Name, next_f) uses. Pass #iter_default_batch(next_f) to
+ * #impl_iterator_with(IterType, ElmntType, Name, next_f, ...) to use it there.
+ *
+ * @param IterType The semantic type (C type) this impl is for, must be a pointer type.
+ * @param ElmntType The type of value the `Iterator` instance will yield.
+ * @param next_f The `next` implementation for `IterType`.
+ *
+ * @note This should not be delimited by a semicolon.
+ */
+#define impl_default_next_batch(IterType, ElmntType, next_f)                                                           \
+    static inline size_t CONCAT(next_f, _batch__)(void* self, ElmntType* out, size_t cap)                              \
+    {                                                                                                                  \
+        IterType const x = self;                                                                                       \
+        size_t n         = 0;                                                                                          \
+        for (; n < cap; n++) {                                                                                         \
+            Maybe(ElmntType) const res = (next_f)(x);                                                                  \
+            if (is_nothing_of(res, ElmntType)) {                                                                       \
+                break;                                                                                                 \
+            }                                                                                                          \
+            out[n] = from_just_(res);                                                                                  \
+        }                                                                                                              \
+        return n;                                                                                                      \
+    }
+
+/**
+ * @def iter_default_batch(next_f)
+ * @brief Designated initializer for the `next_batch` defined by #impl_default_next_batch(IterType, ElmntType, next_f).
+ */
+#define iter_default_batch(next_f) .next_batch = CONCAT(next_f, _batch__)
+
+/**
+ * @def impl_default_next_into(IterType, ElmntType, next_f)
+ * @brief Define the default `next_into` implementation for `IterType`, which unwraps the result of `next_f`.
+ *
+ * This is what #impl_iterator(IterType, ElmntType, Name, next_f) uses. Pass #iter_default_into(next_f) to
+ * #impl_iterator_with(IterType, ElmntType, Name, next_f, ...) to use it there.
+ *
+ * @param IterType The semantic type (C type) this impl is for, must be a pointer type.
+ * @param ElmntType The type of value the `Iterator` instance will yield.
+ * @param next_f The `next` implementation for `IterType`.
+ *
+ * @note This should not be delimited by a semicolon.
+ */
+#define impl_default_next_into(IterType, ElmntType, next_f)                                                            \
+    static inline bool CONCAT(next_f, _into__)(void* self, ElmntType* out)                                             \
+    {                                                                                                                  \
+        Maybe(ElmntType) const res = (next_f)((IterType)self);                                                         \
+        if (is_nothing_of(res, ElmntType)) {                                                                           \
+            return false;                                                                                              \
+        }                                                                                                              \
+        *out = from_just_(res);                                                                                        \
+        return true;                                                                                                   \
+    }
+
+/**
+ * @def iter_default_into(next_f)
+ * @brief Designated initializer for the `next_into` defined by #impl_default_next_into(IterType, ElmntType, next_f).
+ */
+#define iter_default_into(next_f) .next_into = CONCAT(next_f, _into__)
+
+/**
+ * @def impl_next_into(IterType, ElmntType, into_f)
+ * @brief Type check a `next_into` implementation for `IterType` and wrap it so it can be put into the typeclass.
+ *
+ * @param IterType The semantic type (C type) this impl is for, must be a pointer type.
+ * @param ElmntType The type of value the `Iterator` instance will yield.
+ * @param into_f Function that serves as the `next_into` implementation for `IterType`. This function must have
+ * the signature of `bool (*)(IterType self, ElmntType* out)`.
+ *
+ * @note This should not be delimited by a semicolon.
+ */
+#define impl_next_into(IterType, ElmntType, into_f)                                                                    \
+    static inline bool CONCAT(into_f, __)(void* self, ElmntType* out)                                                  \
+    {                                                                                                                  \
+        bool (*const into_)(IterType self, ElmntType * out) = (into_f);                                                \
+        (void)into_;                                                                                                   \
+        return (into_f)(self, out);                                                                                    \
+    }
+
+/**
+ * @def impl_next_batch(IterType, ElmntType, batch_f)
+ * @brief Type check a `next_batch` implementation for `IterType` and wrap it so it can be put into the typeclass.
+ *
+ * The wrapper can then be passed to #impl_iterator_with(IterType, ElmntType, Name, next_f, ...) using
+ * #iter_slot(slot, f).
+ *
+ * # Example
+ *
+ * @code
+ * static size_t intarrbatch(ArrIter(int) * self, int* out, size_t cap)
+ * {
+ *     ...
+ * }
+ *
+ * impl_next_batch(ArrIter(int)*, int, intarrbatch)
+ * impl_iterator_with(ArrIter(int)*, int, prep_arriter_of(int), intarrnxt, iter_slot(next_batch, intarrbatch))
+ * @endcode
+ *
+ * @param IterType The semantic type (C type) this impl is for, must be a pointer type.
+ * @param ElmntType The type of value the `Iterator` instance will yield.
+ * @param batch_f Function that serves as the `next_batch` implementation for `IterType`. This function must have
+ * the signature of `size_t (*)(IterType self, ElmntType* out, size_t cap)`.
+ *
+ * @note This should not be delimited by a semicolon.
+ */
+#define impl_next_batch(IterType, ElmntType, batch_f)                                                                  \
+    static inline size_t CONCAT(batch_f, __)(void* self, ElmntType* out, size_t cap)                                   \
+    {                                                                                                                  \
+        size_t (*const batch_)(IterType self, ElmntType * out, size_t cap) = (batch_f);                                \
+        (void)batch_;                                                                                                  \
+        return (batch_f)(self, out, cap);                                                                              \
+    }
+
+/**
+ * @def iter_slot(slot, f)
+ * @brief Designated initializer for an optional typeclass function, to be passed to
+ * #impl_iterator_with(IterType, ElmntType, Name, next_f, ...).
+ *
+ * @param slot Name of the typeclass function (e.g `next_batch`).
+ * @param f The implementation previously wrapped with the corresponding `impl_` macro (e.g
+ * #impl_next_batch(IterType, ElmntType, batch_f)).
+ */
+#define iter_slot(slot, f) .slot = CONCAT(f, __)
+
+/**
+ * @def impl_size_hint(IterType, hint_f)
+ * @brief Type check a `size_hint` implementation for `IterType` and wrap it so it can be put into the typeclass.
+ *
+ * # Example
+ *
+ * @code
+ * static SizeHint intarrhint(ArrIter(int) * self) { return size_hint_exact(self->size - self->i); }
+ *
+ * impl_size_hint(ArrIter(int)*, intarrhint)
+ * impl_iterator_with(ArrIter(int)*, int, prep_arriter_of(int), intarrnxt, iter_slot(size_hint, intarrhint))
+ * @endcode
+ *
+ * @param IterType The semantic type (C type) this impl is for, must be a pointer type.
+ * @param hint_f Function that serves as the `size_hint` implementation for `IterType`. This function must have
+ * the signature of `SizeHint (*)(IterType self)`.
+ *
+ * @note This should not be delimited by a semicolon.
+ */
+#define impl_size_hint(IterType, hint_f)                                                                               \
+    static inline SizeHint CONCAT(hint_f, __)(void* self)                                                              \
+    {                                                                                                                  \
+        SizeHint (*const hint_)(IterType self) = (hint_f);                                                             \
+        (void)hint_;                                                                                                   \
+        return (hint_f)(self);                                                                                         \
+    }
+
+/**
+ * @def impl_as_span(IterType, ElmntType, span_f)
+ * @brief Type check an `as_span` implementation for `IterType` and wrap it so it can be put into the typeclass.
+ *
+ * @param IterType The semantic type (C type) this impl is for, must be a pointer type.
+ * @param ElmntType The type of value the `Iterator` instance will yield.
+ * @param span_f Function that serves as the `as_span` implementation for `IterType`. This function must have
+ * the signature of `bool (*)(IterType self, size_t max, Span(ElmntType)* out)`.
+ *
+ * @note This should not be delimited by a semicolon.
+ */
+#define impl_as_span(IterType, ElmntType, span_f)                                                                      \
+    static inline bool CONCAT(span_f, __)(void* self, size_t max, Span(ElmntType) * out)                               \
+    {                                                                                                                  \
+        bool (*const span_)(IterType self, size_t max, Span(ElmntType) * out) = (span_f);                              \
+        (void)span_;                                                                                                   \
+        return (span_f)(self, max, out);                                                                               \
+    }
+
+/**
+ * @def impl_as_progression(IterType, ElmntType, prog_f)
+ * @brief Type check an `as_progression` implementation for `IterType` and wrap it so it can be put into the
+ * typeclass.
+ *
+ * @param IterType The semantic type (C type) this impl is for, must be a pointer type.
+ * @param ElmntType The type of value the `Iterator` instance will yield.
+ * @param prog_f Function that serves as the `as_progression` implementation for `IterType`. This function must have
+ * the signature of `bool (*)(IterType self, size_t max, Progression(ElmntType)* out)`.
+ *
+ * @note This should not be delimited by a semicolon.
+ */
+#define impl_as_progression(IterType, ElmntType, prog_f)                                                               \
+    static inline bool CONCAT(prog_f, __)(void* self, size_t max, Progression(ElmntType) * out)                        \
+    {                                                                                                                  \
+        bool (*const prog_)(IterType self, size_t max, Progression(ElmntType) * out) = (prog_f);                       \
+        (void)prog_;                                                                                                   \
+        return (prog_f)(self, max, out);                                                                               \
+    }
+
+/**
+ * @def impl_advance_by(IterType, advance_f)
+ * @brief Type check an `advance_by` implementation for `IterType` and wrap it so it can be put into the typeclass.
+ *
+ * @param IterType The semantic type (C type) this impl is for, must be a pointer type.
+ * @param advance_f Function that serves as the `advance_by` implementation for `IterType`. This function must have
+ * the signature of `size_t (*)(IterType self, size_t n)`.
+ *
+ * @note This should not be delimited by a semicolon.
+ */
+#define impl_advance_by(IterType, advance_f)                                                                           \
+    static inline size_t CONCAT(advance_f, __)(void* self, size_t n)                                                   \
+    {                                                                                                                  \
+        size_t (*const advance_)(IterType self, size_t n) = (advance_f);                                               \
+        (void)advance_;                                                                                                \
+        return (advance_f)(self, n);                                                                                   \
+    }
+
+/**
+ * @def impl_split(IterType, split_f)
+ * @brief Type check a `split` implementation for `IterType` and wrap it so it can be put into the typeclass.
+ *
+ * @param IterType The semantic type (C type) this impl is for, must be a pointer type.
+ * @param split_f Function that serves as the `split` implementation for `IterType`. This function must have
+ * the signature of `IterType (*)(IterType self, Allocator alloc)`.
+ *
+ * @note This should not be delimited by a semicolon.
+ */
+#define impl_split(IterType, split_f)                                                                                  \
+    static inline void* CONCAT(split_f, __)(void* self, Allocator alloc)                                               \
+    {                                                                                                                  \
+        IterType (*const split_)(IterType self, Allocator alloc) = (split_f);                                          \
+        (void)split_;                                                                                                  \
+        return (split_f)(self, alloc);                                                                                 \
+    }
+
+/**
+ * @def impl_iterator_with(IterType, ElmntType, Name, next_f, ...)
+ * @brief Same as #impl_iterator(IterType, ElmntType, Name, next_f), but also fills in the given optional typeclass
+ * functions.
+ *
+ * Optional typeclass functions that aren't given are left as `NULL`.
+ *
+ * @param IterType The semantic type (C type) this impl is for, must be a pointer type.
+ * @param ElmntType The type of value the `Iterator` instance will yield.
+ * @param Name Name to define the function as.
+ * @param next_f Function pointer that serves as the `next` implementation for `IterType`.
+ * @param ... Comma separated list of #iter_slot(slot, f) (or #iter_default_batch(next_f), #iter_default_into(next_f))
+ * values.
+ *
+ * @note This should not be delimited by a semicolon.
+ */
+#define impl_iterator_with(IterType, ElmntType, Name, next_f, ...)                                                     \
     static inline Maybe(ElmntType) CONCAT(next_f, __)(void* self)                                                      \
     {                                                                                                                  \
         Maybe(ElmntType) (*const next_)(IterType self) = (next_f);                                                     \
         (void)next_;                                                                                                   \
-        return (next_f)(self);                                                                                         \
+        iter_call_next_(IterType, ElmntType, next_f);                                                                  \
     }                                                                                                                  \
     Iterable(ElmntType) Name(IterType x)                                                                               \
     {                                                                                                                  \
-        static Iterator(ElmntType) const tc = {.next = (CONCAT(next_f, __))};                                          \
+        static Iterator(ElmntType) const tc = {.next = (CONCAT(next_f, __)), __VA_ARGS__};                             \
         return (Iterable(ElmntType)){.tc = &tc, .self = x};                                                            \
     }
 
+/**
+ * @def static_next(IterName)
+ * @brief Name of the statically dispatched, typed, `next` function of given iterator struct.
+ *
+ * Calling this directly (rather than through the `tc` of an #Iterable(T)) lets the compiler inline the `next`
+ * implementation into the calling loop.
+ *
+ * @param IterName The alphanumeric name of the struct (i.e without the `*`) `Iterator` is implemented for.
+ */
+#define static_next(IterName) CONCAT(IterName, _nxt)
+
+/**
+ * @def impl_static_next(IterName, ElmntType, next_f)
+ * @brief Define #static_next(IterName) as a `static inline` function calling `next_f`.
+ *
+ * Unlike #impl_iterator(IterType, ElmntType, Name, next_f), which is usually called in a source file, this needs to
+ * be called in the header exposing `IterName` - right after the (`static inline`) definition of `next_f` - so the
+ * typed `next` is visible to every translation unit.
+ *
+ * # Example
+ *
+ * @code
+ * static inline Maybe(int) intarrnxt(ArrIter(int) * self)
+ * {
+ *     ...
+ * }
+ *
+ * // Defines `static inline Maybe(int) intArrIter_nxt(ArrIter(int)* self)`
+ * impl_static_next(ArrIter(int), int, intarrnxt)
+ * @endcode
+ *
+ * @param IterName The alphanumeric name of the struct `Iterator` is implemented for. The `IterType` passed to
+ * #impl_iterator(IterType, ElmntType, Name, next_f) is a pointer to this.
+ * @param ElmntType The type of value the `Iterator` instance will yield.
+ * @param next_f The `next` implementation for `IterName*`.
+ *
+ * @note This should not be delimited by a semicolon.
+ */
+#define impl_static_next(IterName, ElmntType, next_f)                                                                  \
+    static inline Maybe(ElmntType) static_next(IterName)(IterName * self) { return (next_f)(self); }
+
 #endif /* !IT_ITERATOR_H */
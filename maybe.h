@@ -61,9 +61,50 @@ typedef enum
         /* Don't access this member manually */                                                                        \
         T val;                                                                                                         \
     } Maybe(T);                                                                                                        \
+    static inline Maybe(T) T##_just(T x) { return (Maybe(T)){.tag = MaybeTag_Just, .val = x}; }                        \
+    static inline Maybe(T) T##_nothing(void) { return (Maybe(T)){0}; }                                                 \
+    static inline int T##_is_just(Maybe(T) maybex) { return maybex.tag == MaybeTag_Just; }                             \
+    DefineMaybeFromJust(T)
+
+/**
+ * @def DefineMaybeNiche(T, sentinel)
+ * @brief Define a Maybe<T> type that stores `Nothing` as a reserved value of `T`, rather than in a separate tag.
+ *
+ * The resulting #Maybe(T) is exactly as big as `T` - a `Maybe(string)` (`string` being a `char*`) fits in one
+ * register, and is returned in one, where the tagged version takes two. This is meant for pointers (with `NULL` as the
+ * sentinel) and other types with a value that can never be a `Just` (e.g `-1` for a file descriptor).
+ *
+ * # Example
+ *
+ * @code
+ * typedef char* string;
+ * DefineMaybeNiche(string, NULL) // Defines a Maybe(string), where `NULL` means `Nothing`
+ * @endcode
+ *
+ * @param T The type of value this `Maybe` will hold. Must be alphanumeric, and comparable with `!=`.
+ * @param sentinel The value of `T` that represents `Nothing`.
+ *
+ * @note `Just(sentinel, T)` is indistinguishable from `Nothing(T)` - the sentinel can't be wrapped.
+ * @note The untyped #is_just(x) and #is_nothing(x) don't work on a niche #Maybe(T) (it has no tag). Use
+ * #is_just_of(x, T) and #is_nothing_of(x, T) instead. #from_just_(x) works on both.
+ * @note This should not be delimited by a semicolon.
+ */
+#define DefineMaybeNiche(T, sentinel)                                                                                  \
+    typedef struct                                                                                                     \
+    {                                                                                                                  \
+        /* Don't access this member manually */                                                                        \
+        T val;                                                                                                         \
+    } Maybe(T);                                                                                                        \
+    static inline Maybe(T) T##_just(T x) { return (Maybe(T)){.val = x}; }                                              \
+    static inline Maybe(T) T##_nothing(void) { return (Maybe(T)){.val = (sentinel)}; }                                 \
+    static inline int T##_is_just(Maybe(T) maybex) { return maybex.val != (sentinel); }                                \
+    DefineMaybeFromJust(T)
+
+/* Define `T##_from_just`, on top of `T##_is_just` */
+#define DefineMaybeFromJust(T)                                                                                         \
     static inline T T##_from_just(Maybe(T) maybex)                                                                     \
     {                                                                                                                  \
-        if (is_just(maybex)) {                                                                                         \
+        if (T##_is_just(maybex)) {                                                                                     \
             return maybex.val;                                                                                         \
         } else {                                                                                                       \
             fputs("Attempted to extract Just value from Nothing", stderr);                                             \
@@ -87,8 +128,9 @@ typedef enum
  *
  * @note If `T` is a pointer, it needs to be typedef-ed into a type that does not contain the `*`. Only alphanumerics.
  * @note The value is simply assigned to the #Maybe(T) struct. No implicit copying is done.
+ * @note This is a call to the `static inline` `T##_just` defined along with the #Maybe(T), not a constant expression.
  */
-#define Just(v, T) ((Maybe(T)){.tag = MaybeTag_Just, .val = (v)})
+#define Just(v, T) T##_just(v)
 
 /**
  * @def Nothing(T)
@@ -105,7 +147,7 @@ typedef enum
  *
  * @note If `T` is a pointer, it needs to be typedef-ed into a type that does not contain the `*`. Only alphanumerics.
  */
-#define Nothing(T) ((Maybe(T)){0})
+#define Nothing(T) T##_nothing()
 
 /**
  * @def is_nothing(x)
@@ -122,6 +164,25 @@ typedef enum
  */
 #define is_just(x) ((x).tag == MaybeTag_Just)
 
+/**
+ * @def is_nothing_of(x, T)
+ * @brief Check if the given #Maybe(T) is `Nothing`. Unlike #is_nothing(x), this also works on a niche #Maybe(T).
+ *
+ * Generic code that knows `T` should prefer this, so it works with #DefineMaybeNiche(T, sentinel) types too.
+ *
+ * @param x The #Maybe(T) struct to check against.
+ * @param T The type of value the `Maybe` will hold. Must be alphanumeric.
+ */
+#define is_nothing_of(x, T) (!T##_is_just(x))
+/**
+ * @def is_just_of(x, T)
+ * @brief Check if the given #Maybe(T) is a `Just`. Unlike #is_just(x), this also works on a niche #Maybe(T).
+ *
+ * @param x The #Maybe(T) struct to check against.
+ * @param T The type of value the `Maybe` will hold. Must be alphanumeric.
+ */
+#define is_just_of(x, T) T##_is_just(x)
+
 /**
  * @def from_just(x, T)
  * @brief Extract the `Just` value from given #Maybe(T).
@@ -132,7 +193,7 @@ typedef enum
  * @return `Just` value of type corresponding to the given #Maybe(T) if it's not `Nothing`.
  *
  * @note If `T` is a pointer, it needs to be typedef-ed into a type that does not contain the `*`. Only alphanumerics.
- * @note Aborts the program if given #Maybe(T) struct was tagged with `Nothing`.
+ * @note Aborts the program if given #Maybe(T) struct is `Nothing`.
  */
 #define from_just(x, T) T##_from_just(x)
 